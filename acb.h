@@ -585,6 +585,11 @@ void acb_addmul(acb_t z, const acb_t x, const acb_t y, long prec);
 
 void acb_submul(acb_t z, const acb_t x, const acb_t y, long prec);
 
+void acb_dot_simple(acb_t res, const acb_t initial, int subtract,
+    acb_srcptr x, long xstep, acb_srcptr y, long ystep, long len, long prec);
+void acb_dot(acb_t res, const acb_t initial, int subtract,
+    acb_srcptr x, long xstep, acb_srcptr y, long ystep, long len, long prec);
+
 ACB_INLINE void
 acb_addmul_ui(acb_t z, const acb_t x, ulong y, long prec)
 {
@@ -764,10 +769,13 @@ void acb_rising_ui_get_mag(mag_t bound, const acb_t s, ulong n);
 void acb_gamma(acb_t y, const acb_t x, long prec);
 void acb_rgamma(acb_t y, const acb_t x, long prec);
 void acb_lgamma(acb_t y, const acb_t x, long prec);
+void _acb_vec_gamma(acb_ptr res, acb_srcptr x, long len, long prec);
+void _acb_vec_lgamma(acb_ptr res, acb_srcptr x, long len, long prec);
 void acb_log_sin_pi(acb_t res, const acb_t z, long prec);
 void acb_digamma(acb_t y, const acb_t x, long prec);
 void acb_zeta(acb_t z, const acb_t s, long prec);
 void acb_hurwitz_zeta(acb_t z, const acb_t s, const acb_t a, long prec);
+void acb_zeta_grid(acb_ptr res, const acb_t s, const arb_t h, long num, long prec);
 void acb_polygamma(acb_t res, const acb_t s, const acb_t z, long prec);
 
 void acb_log_barnes_g(acb_t res, const acb_t z, long prec);
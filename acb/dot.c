@@ -0,0 +1,112 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb.h"
+
+void
+acb_dot_simple(acb_t res, const acb_t initial, int subtract,
+    acb_srcptr x, long xstep, acb_srcptr y, long ystep, long len, long prec)
+{
+    acb_t t;
+    long i;
+
+    acb_init(t);
+
+    if (initial == NULL)
+        acb_zero(t);
+    else if (subtract)
+        acb_neg(t, initial);
+    else
+        acb_set(t, initial);
+
+    for (i = 0; i < len; i++)
+        acb_addmul(t, x + i * xstep, y + i * ystep, prec);
+
+    if (subtract)
+        acb_neg(t, t);
+
+    if (len == 0)
+        acb_set_round(res, t, prec);
+    else
+        acb_swap(res, t);
+
+    acb_clear(t);
+}
+
+/*
+    The real and imaginary parts are computed as real dot products of
+    length 2 len, using shallow copies of the entries:
+
+        re = sum (re x) (re y) + (im x) (-im y)
+        im = sum (re x) (im y) + (im x) (re y)
+
+    The negated copies only flip the sign bit of the copied midpoint,
+    so nothing needs to be cleared.
+*/
+void
+acb_dot(acb_t res, const acb_t initial, int subtract,
+    acb_srcptr x, long xstep, acb_srcptr y, long ystep, long len, long prec)
+{
+    arb_ptr a, b, c;
+    acb_t t;
+    long i;
+    TMP_INIT;
+
+    if (len <= 0)
+    {
+        acb_dot_simple(res, initial, subtract, x, xstep, y, ystep, len, prec);
+        return;
+    }
+
+    TMP_START;
+    a = TMP_ALLOC(sizeof(arb_struct) * 6 * len);
+    b = a + 2 * len;
+    c = b + 2 * len;
+
+    for (i = 0; i < len; i++)
+    {
+        a[i] = *acb_realref(x + i * xstep);
+        a[len + i] = *acb_imagref(x + i * xstep);
+
+        b[i] = *acb_realref(y + i * ystep);
+        b[len + i] = *acb_imagref(y + i * ystep);
+        arf_neg(arb_midref(b + len + i), arb_midref(b + len + i));
+
+        c[i] = *acb_imagref(y + i * ystep);
+        c[len + i] = *acb_realref(y + i * ystep);
+    }
+
+    acb_init(t);
+
+    arb_dot(acb_realref(t), (initial == NULL) ? NULL : acb_realref(initial),
+        subtract, a, 1, b, 1, 2 * len, prec);
+    arb_dot(acb_imagref(t), (initial == NULL) ? NULL : acb_imagref(initial),
+        subtract, a, 1, c, 1, 2 * len, prec);
+
+    acb_swap(res, t);
+    acb_clear(t);
+
+    TMP_END;
+}
@@ -34,14 +34,19 @@ void acb_gamma_stirling_bound(mag_ptr err, const acb_t z, long k0, long knum, lo
 
 void arb_gamma_stirling_coeff(arb_t b, ulong k, int digamma, long prec);
 
+arb_srcptr _arb_gamma_stirling_coeffs(long nterms, int digamma, long prec);
+
+/* see arb_gamma_stirling_eval */
 void
 acb_gamma_stirling_eval(acb_t s, const acb_t z, long nterms, int digamma, long prec)
 {
     acb_t t, logz, zinv, zinv2;
     arb_t b;
+    acb_ptr zpow;
+    arb_srcptr c;
     mag_t err;
 
-    long k, term_prec;
+    long k, j, m, N, len, term_prec;
     double z_mag, term_mag;
 
     acb_init(t);
@@ -58,31 +63,48 @@ acb_gamma_stirling_eval(acb_t s, const acb_t z, long nterms, int digamma, long p
     acb_zero(s);
     if (nterms > 1)
     {
+        N = nterms - 1;
+        c = _arb_gamma_stirling_coeffs(nterms, digamma, prec);
+
         acb_mul(zinv2, zinv, zinv, prec);
 
         z_mag = arf_get_d(arb_midref(acb_realref(logz)), ARF_RND_UP) * 1.44269504088896;
 
-        for (k = nterms - 1; k >= 1; k--)
+        m = n_sqrt(N);
+        zpow = _acb_vec_init(m + 1);
+        _acb_vec_set_powers(zpow, zinv2, m + 1, prec);
+
+        for (j = (N - 1) / m; j >= 0; j--)
         {
+            k = j * m + 1;
+            len = FLINT_MIN(m, N - j * m);
+
             term_mag = bernoulli_bound_2exp_si(2 * k);
             term_mag -= (2 * k - 1) * z_mag;
             term_prec = prec + term_mag;
             term_prec = FLINT_MIN(term_prec, prec);
             term_prec = FLINT_MAX(term_prec, 10);
 
-            arb_gamma_stirling_coeff(b, k, digamma, term_prec);
-
-            if (prec > 2000)
+            if (j != (N - 1) / m)
             {
-                acb_set_round(t, zinv2, term_prec);
-                acb_mul(s, s, t, term_prec);
+                if (prec > 2000)
+                {
+                    acb_set_round(t, zpow + m, term_prec);
+                    acb_mul(s, s, t, term_prec);
+                }
+                else
+                    acb_mul(s, s, zpow + m, term_prec);
             }
-            else
-                acb_mul(s, s, zinv2, term_prec);
 
-            arb_add(acb_realref(s), acb_realref(s), b, term_prec);
+            /* the coefficients are real */
+            arb_dot(acb_realref(s), acb_realref(s), 0, c + k, 1,
+                acb_realref(zpow), 2, len, term_prec);
+            arb_dot(acb_imagref(s), acb_imagref(s), 0, c + k, 1,
+                acb_imagref(zpow), 2, len, term_prec);
         }
 
+        _acb_vec_clear(zpow, m + 1);
+
         if (digamma)
             acb_mul(s, s, zinv2, prec);
         else
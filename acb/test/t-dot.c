@@ -0,0 +1,162 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("dot....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100000; iter++)
+    {
+        acb_ptr x, y;
+        acb_t s, res;
+        fmpq * xa, * xb, * ya, * yb;
+        fmpq_t sa, sb, ta, tb, u;
+        long i, j, k, len, prec, xstep, ystep, mag_bits;
+        int initial, subtract, alias;
+
+        len = n_randint(state, 20);
+        prec = 2 + n_randint(state, 300);
+        mag_bits = 1 + n_randint(state, 20);
+        initial = n_randint(state, 2);
+        subtract = n_randint(state, 2);
+        alias = initial && n_randint(state, 2);
+
+        x = _acb_vec_init(len);
+        y = _acb_vec_init(len);
+        xa = _fmpq_vec_init(len);
+        xb = _fmpq_vec_init(len);
+        ya = _fmpq_vec_init(len);
+        yb = _fmpq_vec_init(len);
+        acb_init(s);
+        acb_init(res);
+        fmpq_init(sa);
+        fmpq_init(sb);
+        fmpq_init(ta);
+        fmpq_init(tb);
+        fmpq_init(u);
+
+        for (i = 0; i < len; i++)
+        {
+            acb_randtest(x + i, state, 1 + n_randint(state, 400), mag_bits);
+            acb_randtest(y + i, state, 1 + n_randint(state, 400), mag_bits);
+
+            arb_get_rand_fmpq(xa + i, state, acb_realref(x + i), 1 + n_randint(state, 200));
+            arb_get_rand_fmpq(xb + i, state, acb_imagref(x + i), 1 + n_randint(state, 200));
+            arb_get_rand_fmpq(ya + i, state, acb_realref(y + i), 1 + n_randint(state, 200));
+            arb_get_rand_fmpq(yb + i, state, acb_imagref(y + i), 1 + n_randint(state, 200));
+        }
+
+        acb_randtest(s, state, 1 + n_randint(state, 400), mag_bits);
+        arb_get_rand_fmpq(sa, state, acb_realref(s), 1 + n_randint(state, 200));
+        arb_get_rand_fmpq(sb, state, acb_imagref(s), 1 + n_randint(state, 200));
+
+        xstep = n_randint(state, 2) ? 1 : -1;
+        ystep = n_randint(state, 2) ? 1 : -1;
+
+        fmpq_zero(ta);
+        fmpq_zero(tb);
+        for (i = 0; i < len; i++)
+        {
+            j = (xstep == 1) ? i : len - 1 - i;
+            k = (ystep == 1) ? i : len - 1 - i;
+
+            fmpq_addmul(ta, xa + j, ya + k);
+            fmpq_mul(u, xb + j, yb + k);
+            fmpq_sub(ta, ta, u);
+            fmpq_addmul(tb, xa + j, yb + k);
+            fmpq_addmul(tb, xb + j, ya + k);
+        }
+
+        if (subtract)
+        {
+            fmpq_neg(ta, ta);
+            fmpq_neg(tb, tb);
+        }
+
+        if (initial)
+        {
+            fmpq_add(ta, ta, sa);
+            fmpq_add(tb, tb, sb);
+        }
+
+        if (alias)
+        {
+            acb_dot(s, s, subtract,
+                (xstep == 1) ? x : x + len - 1, xstep,
+                (ystep == 1) ? y : y + len - 1, ystep, len, prec);
+            acb_swap(res, s);
+        }
+        else
+        {
+            acb_dot(res, initial ? s : NULL, subtract,
+                (xstep == 1) ? x : x + len - 1, xstep,
+                (ystep == 1) ? y : y + len - 1, ystep, len, prec);
+        }
+
+        if (!arb_contains_fmpq(acb_realref(res), ta) ||
+            !arb_contains_fmpq(acb_imagref(res), tb))
+        {
+            printf("FAIL: containment\n\n");
+            printf("len = %ld, prec = %ld, initial = %d, subtract = %d\n\n",
+                len, prec, initial, subtract);
+            for (i = 0; i < len; i++)
+            {
+                printf("x[%ld] = ", i); acb_printd(x + i, 30); printf("\n");
+                printf("y[%ld] = ", i); acb_printd(y + i, 30); printf("\n");
+            }
+            printf("\nres = "); acb_printd(res, 30); printf("\n\n");
+            printf("ta = "); fmpq_print(ta); printf("\n\n");
+            printf("tb = "); fmpq_print(tb); printf("\n\n");
+            abort();
+        }
+
+        _acb_vec_clear(x, len);
+        _acb_vec_clear(y, len);
+        _fmpq_vec_clear(xa, len);
+        _fmpq_vec_clear(xb, len);
+        _fmpq_vec_clear(ya, len);
+        _fmpq_vec_clear(yb, len);
+        acb_clear(s);
+        acb_clear(res);
+        fmpq_clear(sa);
+        fmpq_clear(sb);
+        fmpq_clear(ta);
+        fmpq_clear(tb);
+        fmpq_clear(u);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -81,6 +81,55 @@ int main()
         acb_clear(c);
     }
 
+    /* cached coefficients computed inside an arena scope must
+       survive the scope */
+    for (iter = 0; iter < 300; iter++)
+    {
+        acb_t a, b, c, d;
+        long prec;
+
+        prec = 64 + n_randint(state, 1000);
+
+        acb_init(a);
+        acb_init(b);
+        acb_init(c);
+
+        acb_randtest(a, state, 1 + n_randint(state, 1000), 3);
+
+        flint_cleanup();
+        acb_gamma(b, a, prec);
+        flint_cleanup();
+
+        arf_arena_push();
+        acb_init(d);
+        acb_gamma(d, a, prec);
+        acb_clear(d);
+        arf_arena_pop();
+
+        /* overwrite the memory that was used by the scope */
+        arf_arena_push();
+        acb_init(d);
+        acb_randtest(d, state, 4 * prec, 10);
+        acb_mul(d, d, d, 4 * prec);
+        acb_clear(d);
+        arf_arena_pop();
+
+        acb_gamma(c, a, prec);
+
+        if (!acb_equal(b, c))
+        {
+            printf("FAIL: arena\n\n");
+            printf("a = "); acb_print(a); printf("\n\n");
+            printf("b = "); acb_print(b); printf("\n\n");
+            printf("c = "); acb_print(c); printf("\n\n");
+            abort();
+        }
+
+        acb_clear(a);
+        acb_clear(b);
+        acb_clear(c);
+    }
+
     flint_randclear(state);
     flint_cleanup();
     printf("PASS\n");
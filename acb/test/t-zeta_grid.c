@@ -0,0 +1,93 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("zeta_grid....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 500; iter++)
+    {
+        acb_ptr r;
+        acb_t s, t, u;
+        arb_t h;
+        long j, num, prec1, prec2;
+
+        prec1 = 2 + n_randint(state, 300);
+        prec2 = prec1 + 30;
+        num = n_randint(state, 20);
+
+        r = _acb_vec_init(num);
+        acb_init(s);
+        acb_init(t);
+        acb_init(u);
+        arb_init(h);
+
+        arb_randtest_precise(acb_realref(s), state, 1 + n_randint(state, 300), 4);
+        arb_randtest_precise(acb_imagref(s), state, 1 + n_randint(state, 300), 3);
+        arb_randtest_precise(h, state, 1 + n_randint(state, 300), 2);
+
+        if (n_randint(state, 4) == 0)
+            arb_zero(acb_imagref(s));
+
+        acb_zeta_grid(r, s, h, num, prec1);
+
+        for (j = 0; j < num; j++)
+        {
+            acb_set(t, s);
+            arb_addmul_si(acb_imagref(t), h, j, prec2 + 10);
+            acb_zeta(u, t, prec2);
+
+            if (!acb_overlaps(r + j, u))
+            {
+                printf("FAIL: overlap\n\n");
+                printf("j = %ld\n\n", j);
+                printf("s = "); acb_printd(s, 30); printf("\n\n");
+                printf("h = "); arb_printd(h, 30); printf("\n\n");
+                printf("r = "); acb_printd(r + j, 30); printf("\n\n");
+                printf("u = "); acb_printd(u, 30); printf("\n\n");
+                abort();
+            }
+        }
+
+        _acb_vec_clear(r, num);
+        acb_clear(s);
+        acb_clear(t);
+        acb_clear(u);
+        arb_clear(h);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
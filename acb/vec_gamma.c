@@ -0,0 +1,75 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb.h"
+#include "arb_thread_pool.h"
+
+typedef void (*_acb_vec_gamma_func_t)(acb_t, const acb_t, long);
+
+typedef struct
+{
+    _acb_vec_gamma_func_t func;
+    acb_ptr res;
+    acb_srcptr x;
+    long prec;
+}
+_acb_vec_gamma_arg_t;
+
+static void
+_acb_vec_gamma_worker(void * arg_ptr, long a, long b)
+{
+    _acb_vec_gamma_arg_t * arg = arg_ptr;
+    long i;
+
+    for (i = a; i < b; i++)
+        arg->func(arg->res + i, arg->x + i, arg->prec);
+}
+
+static void
+_acb_vec_gamma_generic(_acb_vec_gamma_func_t func,
+    acb_ptr res, acb_srcptr x, long len, long prec)
+{
+    _acb_vec_gamma_arg_t arg;
+
+    arg.func = func;
+    arg.res = res;
+    arg.x = x;
+    arg.prec = prec;
+
+    arb_thread_pool_parallel_chunks(_acb_vec_gamma_worker, &arg, len,
+        _arb_vec_gamma_num_threads(len, prec, 1));
+}
+
+void
+_acb_vec_gamma(acb_ptr res, acb_srcptr x, long len, long prec)
+{
+    _acb_vec_gamma_generic(acb_gamma, res, x, len, prec);
+}
+
+void
+_acb_vec_lgamma(acb_ptr res, acb_srcptr x, long len, long prec)
+{
+    _acb_vec_gamma_generic(acb_lgamma, res, x, len, prec);
+}
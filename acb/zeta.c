@@ -36,6 +36,40 @@ void
 acb_zeta(acb_t z, const acb_t s, long prec)
 {
     acb_t a;
+    long K;
+
+    /* Riemann-Siegel formula on the critical line */
+    if (arf_cmp_2exp_si(arb_midref(acb_realref(s)), -1) == 0
+        && mag_is_zero(arb_radref(acb_realref(s)))
+        && (K = _arb_poly_riemann_siegel_rs_terms(acb_imagref(s), prec)) >= 0)
+    {
+        arb_t Z, theta;
+        long wp;
+
+        arb_init(Z);
+        arb_init(theta);
+
+        wp = prec + 10 + FLINT_MAX(0,
+            arf_abs_bound_lt_2exp_si(arb_midref(acb_imagref(s))));
+
+        if (_arb_poly_riemann_siegel_z_rs(Z, acb_imagref(s), K, prec + 10))
+        {
+            /* zeta(1/2+it) = exp(-i theta(t)) Z(t) */
+            _arb_poly_riemann_siegel_theta_series(theta,
+                acb_imagref(s), 1, 1, wp);
+            arb_neg(theta, theta);
+            arb_sin_cos(acb_imagref(z), acb_realref(z), theta, wp);
+            acb_mul_arb(z, z, Z, prec);
+
+            arb_clear(Z);
+            arb_clear(theta);
+            return;
+        }
+
+        arb_clear(Z);
+        arb_clear(theta);
+    }
+
     acb_init(a);
     acb_one(a);
 
@@ -0,0 +1,122 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb.h"
+#include "acb_poly.h"
+
+static void
+acb_zeta_grid_naive(acb_ptr res, const acb_t s, const arb_t h,
+    long num, long prec)
+{
+    acb_t t;
+    long j;
+
+    acb_init(t);
+
+    for (j = 0; j < num; j++)
+    {
+        acb_set(t, s);
+        arb_addmul_si(acb_imagref(t), h, j, prec + 10);
+        acb_zeta(res + j, t, prec);
+    }
+
+    acb_clear(t);
+}
+
+void
+acb_zeta_grid(acb_ptr res, const acb_t s, const arb_t h, long num, long prec)
+{
+    ulong N, M, N2, M2;
+    long j, wp;
+    acb_t one, sj;
+    acb_ptr u;
+    arb_ptr vb;
+    mag_t bound;
+
+    if (num <= 0)
+        return;
+
+    if (!acb_is_finite(s) || !arb_is_finite(h))
+    {
+        _acb_vec_indeterminate(res, num);
+        return;
+    }
+
+    /* the reflection formula is not amortized; the Euler-Maclaurin
+       sum is only shared when there are enough points */
+    if (num < 4 || arf_sgn(arb_midref(acb_realref(s))) < 0)
+    {
+        acb_zeta_grid_naive(res, s, h, num, prec);
+        return;
+    }
+
+    acb_init(one);
+    acb_init(sj);
+    u = _acb_vec_init(1);
+    vb = _arb_vec_init(1);
+    mag_init(bound);
+
+    acb_one(one);
+
+    /* the parameters needed for the points at either end of the grid;
+       the error bound is computed separately for every point below,
+       so these only affect the efficiency */
+    _acb_poly_zeta_em_choose_param(bound, &N, &M, s, one, 1, prec, MAG_BITS);
+    acb_set(sj, s);
+    arb_addmul_si(acb_imagref(sj), h, num - 1, prec + 10);
+    _acb_poly_zeta_em_choose_param(bound, &N2, &M2, sj, one, 1, prec, MAG_BITS);
+    N = FLINT_MAX(N, N2);
+    M = FLINT_MAX(M, M2);
+
+    wp = prec + 2 * (FLINT_BIT_COUNT(N) + 1) + FLINT_BIT_COUNT(num);
+
+    _acb_poly_powsum_one_grid(res, s, h, num, N, wp);
+
+    for (j = 0; j < num; j++)
+    {
+        acb_set(sj, s);
+        arb_addmul_si(acb_imagref(sj), h, j, wp);
+
+        _acb_poly_zeta_em_correction(u, sj, one, 0, N, M, 1, wp);
+        acb_add(res + j, res + j, u, wp);
+
+        _acb_poly_zeta_em_bound(vb, sj, one, N, M, 1, MAG_BITS);
+        arb_get_mag(bound, vb);
+        arb_add_error_mag(acb_realref(res + j), bound);
+
+        if (acb_is_real(sj))
+            arb_zero(acb_imagref(res + j));
+        else
+            arb_add_error_mag(acb_imagref(res + j), bound);
+
+        acb_set_round(res + j, res + j, prec);
+    }
+
+    acb_clear(one);
+    acb_clear(sj);
+    _acb_vec_clear(u, 1);
+    _arb_vec_clear(vb, 1);
+    mag_clear(bound);
+}
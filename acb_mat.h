@@ -141,6 +141,16 @@ void acb_mat_sub(acb_mat_t res, const acb_mat_t mat1, const acb_mat_t mat2, long
 
 void acb_mat_mul(acb_mat_t res, const acb_mat_t mat1, const acb_mat_t mat2, long prec);
 
+void acb_mat_mul_classical(acb_mat_t C, const acb_mat_t A, const acb_mat_t B, long prec);
+
+void acb_mat_mul_threaded(acb_mat_t C, const acb_mat_t A, const acb_mat_t B, long prec);
+
+void acb_mat_mul_block(acb_mat_t C, const acb_mat_t A, const acb_mat_t B, long prec);
+
+void _acb_mat_mul_threaded(acb_mat_t C, const acb_mat_t A, const acb_mat_t B, long prec, long num_threads);
+
+void _acb_mat_mul_block(acb_mat_t C, const acb_mat_t A, const acb_mat_t B, long prec, long num_threads);
+
 void acb_mat_pow_ui(acb_mat_t B, const acb_mat_t A, ulong exp, long prec);
 
 /* Scalar arithmetic */
@@ -28,49 +28,21 @@
 void
 acb_mat_mul(acb_mat_t C, const acb_mat_t A, const acb_mat_t B, long prec)
 {
-    long ar, ac, br, bc, i, j, k;
+    long ar, br, bc, num_threads;
 
     ar = acb_mat_nrows(A);
-    ac = acb_mat_ncols(A);
     br = acb_mat_nrows(B);
     bc = acb_mat_ncols(B);
 
-    if (ac != br || ar != acb_mat_nrows(C) || bc != acb_mat_ncols(C))
-    {
-        printf("acb_mat_mul: incompatible dimensions\n");
-        abort();
-    }
+    /* the work is that of a real product of an ar x 2br matrix
+       and a 2br x 2bc matrix */
+    num_threads = _arb_mat_mul_num_threads(ar, 2 * br, 2 * bc, prec);
 
-    if (br == 0)
-    {
-        acb_mat_zero(C);
-        return;
-    }
-
-    if (A == C || B == C)
-    {
-        acb_mat_t T;
-        acb_mat_init(T, ar, bc);
-        acb_mat_mul(T, A, B, prec);
-        acb_mat_swap(T, C);
-        acb_mat_clear(T);
-        return;
-    }
-
-    for (i = 0; i < ar; i++)
-    {
-        for (j = 0; j < bc; j++)
-        {
-            acb_mul(acb_mat_entry(C, i, j),
-                      acb_mat_entry(A, i, 0),
-                      acb_mat_entry(B, 0, j), prec);
-
-            for (k = 1; k < br; k++)
-            {
-                acb_addmul(acb_mat_entry(C, i, j),
-                             acb_mat_entry(A, i, k),
-                             acb_mat_entry(B, k, j), prec);
-            }
-        }
-    }
+    if (FLINT_MIN(FLINT_MIN(ar, br), bc) >= ARB_MAT_MUL_BLOCK_CUTOFF(prec))
+        _acb_mat_mul_block(C, A, B, prec, num_threads);
+    else if (num_threads > 1)
+        _acb_mat_mul_threaded(C, A, B, prec, num_threads);
+    else
+        acb_mat_mul_classical(C, A, B, prec);
 }
+
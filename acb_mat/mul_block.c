@@ -0,0 +1,135 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb_mat.h"
+
+/*
+    The product is computed as the real product
+
+        [re(A) im(A)] [ re(B) im(B) ]  =  [re(C) im(C)]
+                      [-im(B) re(B) ]
+
+    using shallow copies of the entries (the negated copies only
+    flip the sign bit of the copied midpoint). Doing a single real
+    multiplication lets arb_mat_mul_block use one large integer
+    matrix multiplication per block.
+*/
+
+static void
+_arb_mat_init_shallow(arb_mat_t A, long r, long c)
+{
+    long i;
+
+    A->entries = flint_malloc(sizeof(arb_struct) * r * c);
+    A->rows = flint_malloc(sizeof(arb_ptr) * r);
+    A->r = r;
+    A->c = c;
+
+    for (i = 0; i < r; i++)
+        A->rows[i] = A->entries + i * c;
+}
+
+static void
+_arb_mat_clear_shallow(arb_mat_t A)
+{
+    flint_free(A->entries);
+    flint_free(A->rows);
+}
+
+void
+_acb_mat_mul_block(acb_mat_t C, const acb_mat_t A, const acb_mat_t B,
+    long prec, long num_threads)
+{
+    long ar, ac, br, bc, i, j;
+    arb_mat_t RA, RB, RC;
+
+    ar = acb_mat_nrows(A);
+    ac = acb_mat_ncols(A);
+    br = acb_mat_nrows(B);
+    bc = acb_mat_ncols(B);
+
+    if (ac != br || ar != acb_mat_nrows(C) || bc != acb_mat_ncols(C))
+    {
+        printf("acb_mat_mul_block: incompatible dimensions\n");
+        abort();
+    }
+
+    if (br == 0)
+    {
+        acb_mat_zero(C);
+        return;
+    }
+
+    if (ar == 0 || bc == 0)
+        return;
+
+    _arb_mat_init_shallow(RA, ar, 2 * br);
+    _arb_mat_init_shallow(RB, 2 * br, 2 * bc);
+
+    for (i = 0; i < ar; i++)
+    {
+        for (j = 0; j < br; j++)
+        {
+            *arb_mat_entry(RA, i, j) = *acb_realref(acb_mat_entry(A, i, j));
+            *arb_mat_entry(RA, i, br + j) = *acb_imagref(acb_mat_entry(A, i, j));
+        }
+    }
+
+    for (i = 0; i < br; i++)
+    {
+        for (j = 0; j < bc; j++)
+        {
+            *arb_mat_entry(RB, i, j) = *acb_realref(acb_mat_entry(B, i, j));
+            *arb_mat_entry(RB, i, bc + j) = *acb_imagref(acb_mat_entry(B, i, j));
+            *arb_mat_entry(RB, br + i, j) = *acb_imagref(acb_mat_entry(B, i, j));
+            *arb_mat_entry(RB, br + i, bc + j) = *acb_realref(acb_mat_entry(B, i, j));
+            arf_neg(arb_midref(arb_mat_entry(RB, br + i, j)),
+                arb_midref(arb_mat_entry(RB, br + i, j)));
+        }
+    }
+
+    /* C is only written after the product, so aliasing is fine */
+    arb_mat_init(RC, ar, 2 * bc);
+    _arb_mat_mul_block(RC, RA, RB, prec, num_threads);
+
+    for (i = 0; i < ar; i++)
+    {
+        for (j = 0; j < bc; j++)
+        {
+            arb_swap(acb_realref(acb_mat_entry(C, i, j)), arb_mat_entry(RC, i, j));
+            arb_swap(acb_imagref(acb_mat_entry(C, i, j)), arb_mat_entry(RC, i, bc + j));
+        }
+    }
+
+    arb_mat_clear(RC);
+    _arb_mat_clear_shallow(RA);
+    _arb_mat_clear_shallow(RB);
+}
+
+void
+acb_mat_mul_block(acb_mat_t C, const acb_mat_t A, const acb_mat_t B, long prec)
+{
+    _acb_mat_mul_block(C, A, B, prec, 1);
+}
@@ -0,0 +1,159 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb_mat.h"
+#include "arb_thread_pool.h"
+
+/*
+    This follows arb_mat_mul_threaded: C is divided into tiles, and
+    within a tile the inner dimension is traversed in blocks chosen so
+    that the data used by a full tile fits in about
+    ARB_MAT_MUL_TILE_BYTES. The block length only depends on the inner
+    dimension and the precision, so the result does not depend on the
+    number of threads; when the inner dimension fits in one block, it
+    is the same as with acb_mat_mul_classical.
+*/
+
+typedef struct
+{
+    acb_ptr * C;
+    const acb_ptr * A;
+    acb_srcptr BT;
+    long ar;
+    long br;
+    long bc;
+    long tr;
+    long tc;
+    long kb;
+    long prec;
+}
+acb_mat_mul_arg_t;
+
+static void
+_acb_mat_mul_tile(void * arg_ptr, long t)
+{
+    acb_mat_mul_arg_t * arg = arg_ptr;
+    long i, j, k, i0, i1, j0, j1, len, ntc;
+
+    ntc = (arg->bc + arg->tc - 1) / arg->tc;
+
+    i0 = (t / ntc) * arg->tr;
+    j0 = (t % ntc) * arg->tc;
+    i1 = FLINT_MIN(i0 + arg->tr, arg->ar);
+    j1 = FLINT_MIN(j0 + arg->tc, arg->bc);
+
+    for (k = 0; k < arg->br; k += arg->kb)
+    {
+        len = FLINT_MIN(arg->kb, arg->br - k);
+
+        for (i = i0; i < i1; i++)
+            for (j = j0; j < j1; j++)
+                acb_dot(arg->C[i] + j, (k == 0) ? NULL : arg->C[i] + j, 0,
+                    arg->A[i] + k, 1, arg->BT + j * arg->br + k, 1,
+                    len, arg->prec);
+    }
+}
+
+void
+_acb_mat_mul_threaded(acb_mat_t C, const acb_mat_t A, const acb_mat_t B,
+    long prec, long num_threads)
+{
+    long ar, ac, br, bc, i, j, t, entry, ntiles;
+    acb_ptr tmp;
+    acb_mat_mul_arg_t arg;
+
+    ar = acb_mat_nrows(A);
+    ac = acb_mat_ncols(A);
+    br = acb_mat_nrows(B);
+    bc = acb_mat_ncols(B);
+
+    if (ac != br || ar != acb_mat_nrows(C) || bc != acb_mat_ncols(C))
+    {
+        printf("acb_mat_mul: incompatible dimensions\n");
+        abort();
+    }
+
+    if (br == 0)
+    {
+        acb_mat_zero(C);
+        return;
+    }
+
+    if (ar == 0 || bc == 0)
+        return;
+
+    if (A == C || B == C)
+    {
+        acb_mat_t T;
+        acb_mat_init(T, ar, bc);
+        _acb_mat_mul_threaded(T, A, B, prec, num_threads);
+        acb_mat_swap(T, C);
+        acb_mat_clear(T);
+        return;
+    }
+
+    /* approximate size of an entry, including limbs stored on the heap */
+    entry = sizeof(acb_struct);
+    if (prec > ARF_NOPTR_LIMBS * FLINT_BITS)
+        entry += 2 * ((prec + FLINT_BITS - 1) / FLINT_BITS) *
+            sizeof(mp_limb_t);
+
+    arg.kb = ARB_MAT_MUL_TILE_BYTES / (2 * ARB_MAT_MUL_TILE_SIDE * entry);
+    arg.kb = FLINT_MAX(arg.kb, 64);
+
+    t = ARB_MAT_MUL_TILE_SIDE;
+    while (t > 1 && ((ar + t - 1) / t) * ((bc + t - 1) / t) < 4 * num_threads)
+        t = (t + 1) / 2;
+
+    arg.tr = FLINT_MIN(t, ar);
+    arg.tc = FLINT_MIN(t, bc);
+    ntiles = ((ar + arg.tr - 1) / arg.tr) * ((bc + arg.tc - 1) / arg.tc);
+
+    /* shallow transpose of B, shared by all threads */
+    tmp = flint_malloc(sizeof(acb_struct) * br * bc);
+
+    for (i = 0; i < br; i++)
+        for (j = 0; j < bc; j++)
+            tmp[j * br + i] = *acb_mat_entry(B, i, j);
+
+    arg.C = C->rows;
+    arg.A = A->rows;
+    arg.BT = tmp;
+    arg.ar = ar;
+    arg.br = br;
+    arg.bc = bc;
+    arg.prec = prec;
+
+    arb_thread_pool_parallel_do(_acb_mat_mul_tile, &arg, ntiles, num_threads);
+
+    flint_free(tmp);
+}
+
+void
+acb_mat_mul_threaded(acb_mat_t C, const acb_mat_t A, const acb_mat_t B, long prec)
+{
+    _acb_mat_mul_threaded(C, A, B, prec, flint_get_num_threads());
+}
+
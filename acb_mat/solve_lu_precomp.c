@@ -29,14 +29,15 @@ void
 acb_mat_solve_lu_precomp(acb_mat_t X, const long * perm,
     const acb_mat_t A, const acb_mat_t B, long prec)
 {
-    long i, j, c, n, m;
+    long i, c, n, m;
+    acb_ptr tmp;
 
     n = acb_mat_nrows(X);
     m = acb_mat_ncols(X);
 
     if (X == B)
     {
-        acb_ptr tmp = flint_malloc(sizeof(acb_struct) * n);
+        tmp = flint_malloc(sizeof(acb_struct) * n);
 
         for (c = 0; c < m; c++)
         {
@@ -60,29 +61,29 @@ acb_mat_solve_lu_precomp(acb_mat_t X, const long * perm,
         }
     }
 
+    /* each column is solved in a contiguous vector */
+    tmp = _acb_vec_init(n);
+
     for (c = 0; c < m; c++)
     {
+        for (i = 0; i < n; i++)
+            acb_swap(tmp + i, acb_mat_entry(X, i, c));
+
         /* solve Ly = b */
         for (i = 1; i < n; i++)
-        {
-            for (j = 0; j < i; j++)
-            {
-                acb_submul(acb_mat_entry(X, i, c),
-                    acb_mat_entry(A, i, j), acb_mat_entry(X, j, c), prec);
-            }
-        }
+            acb_dot(tmp + i, tmp + i, 1, A->rows[i], 1, tmp, 1, i, prec);
 
         /* solve Ux = y */
         for (i = n - 1; i >= 0; i--)
         {
-            for (j = i + 1; j < n; j++)
-            {
-                acb_submul(acb_mat_entry(X, i, c),
-                    acb_mat_entry(A, i, j), acb_mat_entry(X, j, c), prec);
-            }
-
-            acb_div(acb_mat_entry(X, i, c), acb_mat_entry(X, i, c),
-                acb_mat_entry(A, i, i), prec);
+            acb_dot(tmp + i, tmp + i, 1, A->rows[i] + i + 1, 1,
+                tmp + i + 1, 1, n - i - 1, prec);
+            acb_div(tmp + i, tmp + i, acb_mat_entry(A, i, i), prec);
         }
+
+        for (i = 0; i < n; i++)
+            acb_swap(tmp + i, acb_mat_entry(X, i, c));
     }
+
+    _acb_vec_clear(tmp, n);
 }
@@ -260,6 +260,14 @@ void acb_poly_mullow_transpose_gauss(acb_poly_t res, const acb_poly_t poly1,
                                             const acb_poly_t poly2,
                                                 long n, long prec);
 
+void _acb_poly_mullow_block(acb_ptr res,
+    acb_srcptr poly1, long len1,
+    acb_srcptr poly2, long len2, long n, long prec);
+
+void acb_poly_mullow_block(acb_poly_t res, const acb_poly_t poly1,
+                                            const acb_poly_t poly2,
+                                                long n, long prec);
+
 void _acb_poly_mullow(acb_ptr res,
     acb_srcptr poly1, long len1,
     acb_srcptr poly2, long len2, long n, long prec);
@@ -268,6 +276,32 @@ void acb_poly_mullow(acb_poly_t res, const acb_poly_t poly1,
                                             const acb_poly_t poly2,
                                                 long n, long prec);
 
+void _acb_poly_mulmid_classical(acb_ptr res,
+    acb_srcptr poly1, long len1,
+    acb_srcptr poly2, long len2, long lo, long hi, long prec);
+
+void _acb_poly_mulmid_transpose(acb_ptr res,
+    acb_srcptr poly1, long len1,
+    acb_srcptr poly2, long len2, long lo, long hi, long prec);
+
+void _acb_poly_mulmid_block(acb_ptr res,
+    acb_srcptr poly1, long len1,
+    acb_srcptr poly2, long len2, long lo, long hi, long prec);
+
+void _acb_poly_mulmid(acb_ptr res,
+    acb_srcptr poly1, long len1,
+    acb_srcptr poly2, long len2, long lo, long hi, long prec);
+
+void acb_poly_mulmid(acb_poly_t res, const acb_poly_t poly1,
+    const acb_poly_t poly2, long lo, long hi, long prec);
+
+void _acb_poly_mulhigh(acb_ptr res,
+    acb_srcptr poly1, long len1,
+    acb_srcptr poly2, long len2, long lo, long prec);
+
+void acb_poly_mulhigh(acb_poly_t res, const acb_poly_t poly1,
+    const acb_poly_t poly2, long lo, long prec);
+
 void _acb_poly_mul(acb_ptr C,
     acb_srcptr A, long lenA,
     acb_srcptr B, long lenB, long prec);
@@ -626,7 +660,14 @@ void _acb_poly_mullow_cpx(acb_ptr res, acb_srcptr src, long len, const acb_t c,
 void _acb_poly_powsum_series_naive(acb_ptr z, const acb_t s, const acb_t a, const acb_t q, long n, long len, long prec);
 void _acb_poly_powsum_series_naive_threaded(acb_ptr z, const acb_t s, const acb_t a, const acb_t q, long n, long len, long prec);
 void _acb_poly_powsum_one_series_sieved(acb_ptr z, const acb_t s, long n, long len, long prec);
+void _acb_poly_powsum_ui_series_sieved(acb_ptr z, const acb_t s, ulong a, long n, long len, long prec);
+
+#define ACB_POLY_POWSUM_SIEVED_MAX_LEN 3
+
+void _acb_poly_powsum_series(acb_ptr z, const acb_t s, const acb_t a, const acb_t q, long n, long len, long prec);
+void _acb_poly_powsum_one_grid(acb_ptr res, const acb_t s, const arb_t h, long num, long n, long prec);
 
+void _acb_poly_zeta_em_correction(acb_ptr z, const acb_t s, const acb_t a, int deflate, ulong N, ulong M, long d, long prec);
 void _acb_poly_zeta_em_sum(acb_ptr z, const acb_t s, const acb_t a, int deflate, ulong N, ulong M, long d, long prec);
 void _acb_poly_zeta_em_choose_param(mag_t bound, ulong * N, ulong * M, const acb_t s, const acb_t a, long d, long target, long prec);
 void _acb_poly_zeta_em_bound1(mag_t bound, const acb_t s, const acb_t a, long N, long M, long d, long wp);
@@ -46,16 +46,14 @@ _acb_poly_evaluate2_horner(acb_t y, acb_t z, acb_srcptr poly,
     }
     else if (len == 2)
     {
-        acb_mul(y, x, poly + 1, prec);
-        acb_add(y, y, poly + 0, prec);
+        acb_dot(y, poly + 0, 0, x, 1, poly + 1, 1, 1, prec);
         acb_set_round(z, poly + 1, prec);
     }
     else
     {
-        acb_t t, u, v;
+        acb_t u, v;
         long i;
 
-        acb_init(t);
         acb_init(u);
         acb_init(v);
 
@@ -64,16 +62,13 @@ _acb_poly_evaluate2_horner(acb_t y, acb_t z, acb_srcptr poly,
 
         for (i = len - 2; i >= 0; i--)
         {
-            acb_mul(t, v, x, prec);
-            acb_add(v, u, t, prec);
-            acb_mul(t, u, x, prec);
-            acb_add(u, t, poly + i, prec);
+            acb_dot(v, u, 0, v, 1, x, 1, 1, prec);
+            acb_dot(u, poly + i, 0, u, 1, x, 1, 1, prec);
         }
 
         acb_swap(y, u);
         acb_swap(z, v);
 
-        acb_clear(t);
         acb_clear(u);
         acb_clear(v);
     }
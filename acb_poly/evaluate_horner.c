@@ -40,27 +40,22 @@ _acb_poly_evaluate_horner(acb_t y, acb_srcptr f, long len,
     }
     else if (len == 2)
     {
-        acb_mul(y, x, f + 1, prec);
-        acb_add(y, y, f + 0, prec);
+        acb_dot(y, f + 0, 0, x, 1, f + 1, 1, 1, prec);
     }
     else
     {
         long i = len - 1;
-        acb_t t, u;
+        acb_t u;
 
-        acb_init(t);
         acb_init(u);
         acb_set(u, f + i);
 
+        /* u = f[i] + u x, rounded once */
         for (i = len - 2; i >= 0; i--)
-        {
-            acb_mul(t, u, x, prec);
-            acb_add(u, f + i, t, prec);
-        }
+            acb_dot(u, f + i, 0, u, 1, x, 1, 1, prec);
 
         acb_swap(y, u);
 
-        acb_clear(t);
         acb_clear(u);
     }
 }
@@ -0,0 +1,44 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb_poly.h"
+
+void
+_acb_poly_mulhigh(acb_ptr res,
+    acb_srcptr poly1, long len1,
+    acb_srcptr poly2, long len2, long lo, long prec)
+{
+    _acb_poly_mulmid(res, poly1, len1, poly2, len2, lo,
+        len1 + len2 - 1, prec);
+}
+
+void
+acb_poly_mulhigh(acb_poly_t res, const acb_poly_t poly1,
+    const acb_poly_t poly2, long lo, long prec)
+{
+    acb_poly_mulmid(res, poly1, poly2, lo,
+        poly1->length + poly2->length - 1, prec);
+}
+
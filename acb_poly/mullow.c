@@ -19,13 +19,14 @@
 =============================================================================*/
 /******************************************************************************
 
-    Copyright (C) 2012 Fredrik Johansson
+    Copyright (C) 2012, 2015 Fredrik Johansson
 
 ******************************************************************************/
 
 #include "acb_poly.h"
 
 #define CUTOFF 4
+#define BLOCK_CUTOFF 16
 
 void
 _acb_poly_mullow(acb_ptr res,
@@ -34,8 +35,10 @@ _acb_poly_mullow(acb_ptr res,
 {
     if (n < CUTOFF || len1 < CUTOFF || len2 < CUTOFF)
         _acb_poly_mullow_classical(res, poly1, len1, poly2, len2, n, prec);
-    else
+    else if (n < BLOCK_CUTOFF || len1 < BLOCK_CUTOFF || len2 < BLOCK_CUTOFF)
         _acb_poly_mullow_transpose(res, poly1, len1, poly2, len2, n, prec);
+    else
+        _acb_poly_mullow_block(res, poly1, len1, poly2, len2, n, prec);
 }
 
 void
@@ -0,0 +1,696 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb_poly.h"
+
+/* Break vector into same-exponent blocks where the largest block
+   has a height of at most ALPHA*prec + BETA bits, as in
+   _arb_poly_mullow_block. These are just tuning parameters. */
+#define ALPHA 3.0
+#define BETA 512
+
+/* Sets e to the larger of the exponents of the real and imaginary
+   midpoints of x; returns 0 if both are zero (or special). */
+static int
+_acb_get_mid_top_exp(fmpz_t e, const acb_t x)
+{
+    arf_srcptr a = arb_midref(acb_realref(x));
+    arf_srcptr b = arb_midref(acb_imagref(x));
+
+    if (arf_is_special(a))
+    {
+        if (arf_is_special(b))
+            return 0;
+
+        fmpz_set(e, ARF_EXPREF(b));
+    }
+    else if (arf_is_special(b) || fmpz_cmp(ARF_EXPREF(a), ARF_EXPREF(b)) >= 0)
+    {
+        fmpz_set(e, ARF_EXPREF(a));
+    }
+    else
+    {
+        fmpz_set(e, ARF_EXPREF(b));
+    }
+
+    return 1;
+}
+
+/* The same heuristic as _arb_poly_get_scale, using the larger of
+   the real and imaginary parts of each coefficient. */
+static void
+_acb_poly_get_scale(fmpz_t scale, acb_srcptr x, long xlen,
+                                  acb_srcptr y, long ylen)
+{
+    fmpz_t xae, xbe, yae, ybe;
+    long xa, xb, ya, yb, den;
+
+    fmpz_init(xae);
+    fmpz_init(xbe);
+    fmpz_init(yae);
+    fmpz_init(ybe);
+
+    fmpz_zero(scale);
+
+    xa = 0;
+    while (xa < xlen && !_acb_get_mid_top_exp(xae, x + xa)) xa++;
+    xb = xlen - 1;
+    while (xb > xa && !_acb_get_mid_top_exp(xbe, x + xb)) xb--;
+    if (xb == xa) fmpz_set(xbe, xae);
+
+    ya = 0;
+    while (ya < ylen && !_acb_get_mid_top_exp(yae, y + ya)) ya++;
+    yb = ylen - 1;
+    while (yb > ya && !_acb_get_mid_top_exp(ybe, y + yb)) yb--;
+    if (yb == ya) fmpz_set(ybe, yae);
+
+    if (xa < xlen && ya < ylen && (xa < xb || ya < yb))
+    {
+        fmpz_add(scale, scale, xbe);
+        fmpz_sub(scale, scale, xae);
+        fmpz_add(scale, scale, ybe);
+        fmpz_sub(scale, scale, yae);
+
+        den = (xb - xa) + (yb - ya);
+
+        /* scale = floor(scale / den + 1/2) = floor((2 scale + den) / (2 den)) */
+        fmpz_mul_2exp(scale, scale, 1);
+        fmpz_add_ui(scale, scale, den);
+        fmpz_fdiv_q_ui(scale, scale, 2 * den);
+    }
+
+    fmpz_clear(xae);
+    fmpz_clear(xbe);
+    fmpz_clear(yae);
+    fmpz_clear(ybe);
+}
+
+/*
+    Blocks are chosen as for real vectors, but using the union of the
+    bit ranges of the real and imaginary midpoints of each coefficient,
+    so that both parts share the same exponents. Returns 0 (without
+    writing the block data) if some coefficient has real and imaginary
+    parts of so different magnitude that combining them would produce
+    an excessively tall block.
+*/
+static int
+_acb_vec_get_fmpz_2exp_blocks(fmpz * re, fmpz * im, fmpz * exps,
+    long * blocks, const fmpz_t scale, acb_srcptr x, long len, long prec)
+{
+    fmpz_t top, bot, t, b, v, block_top, block_bot;
+    long i, j, k, s, block, bits, height, maxheight;
+    int in_zero, have, ok;
+    arf_srcptr m;
+
+    fmpz_init(top);
+    fmpz_init(bot);
+    fmpz_init(t);
+    fmpz_init(b);
+    fmpz_init(v);
+    fmpz_init(block_top);
+    fmpz_init(block_bot);
+
+    blocks[0] = 0;
+    block = 0;
+    in_zero = 1;
+    ok = 1;
+
+    if (prec == ARF_PREC_EXACT)
+        maxheight = ARF_PREC_EXACT;
+    else
+        maxheight = ALPHA * prec + BETA;
+
+    for (i = 0; i < len && ok; i++)
+    {
+        /* Bottom and top exponent of current number */
+        have = 0;
+        height = 0;
+
+        for (k = 0; k < 2; k++)
+        {
+            m = arb_midref((k == 0) ? acb_realref(x + i) : acb_imagref(x + i));
+            bits = arf_bits(m);
+
+            /* Skip (must be zero, since we assume there are no Infs/NaNs). */
+            if (bits == 0)
+                continue;
+
+            height = FLINT_MAX(height, bits);
+
+            fmpz_set(t, ARF_EXPREF(m));
+            fmpz_submul_ui(t, scale, i);
+            fmpz_sub_ui(b, t, bits);
+
+            if (!have)
+            {
+                fmpz_swap(top, t);
+                fmpz_swap(bot, b);
+                have = 1;
+            }
+            else
+            {
+                fmpz_max(top, top, t);
+                fmpz_min(bot, bot, b);
+            }
+        }
+
+        if (!have)
+            continue;
+
+        fmpz_sub(v, top, bot);
+        if (fmpz_cmp_ui(v, FLINT_MAX(height, maxheight)) > 0)
+            ok = 0;
+
+        /* Extend current block. */
+        if (in_zero)
+        {
+            fmpz_swap(block_top, top);
+            fmpz_swap(block_bot, bot);
+        }
+        else
+        {
+            fmpz_max(t, top, block_top);
+            fmpz_min(b, bot, block_bot);
+            fmpz_sub(v, t, b);
+
+            /* extend current block */
+            if (fmpz_cmp_ui(v, maxheight) < 0)
+            {
+                fmpz_swap(block_top, t);
+                fmpz_swap(block_bot, b);
+            }
+            else  /* start new block */
+            {
+                /* write exponent for previous block */
+                fmpz_set(exps + block, block_bot);
+
+                block++;
+                blocks[block] = i;
+
+                fmpz_swap(block_top, top);
+                fmpz_swap(block_bot, bot);
+            }
+        }
+
+        in_zero = 0;
+    }
+
+    if (ok)
+    {
+        /* write exponent for last block */
+        fmpz_set(exps + block, block_bot);
+
+        /* end marker */
+        blocks[block + 1] = len;
+
+        /* write the block data */
+        for (i = 0; blocks[i] != len; i++)
+        {
+            for (j = blocks[i]; j < blocks[i + 1]; j++)
+            {
+                for (k = 0; k < 2; k++)
+                {
+                    fmpz * c = (k == 0) ? (re + j) : (im + j);
+                    m = arb_midref((k == 0) ? acb_realref(x + j) : acb_imagref(x + j));
+
+                    if (arf_is_special(m))
+                    {
+                        fmpz_zero(c);
+                    }
+                    else
+                    {
+                        arf_get_fmpz_2exp(c, bot, m);
+
+                        fmpz_mul_ui(t, scale, j);
+                        fmpz_sub(t, bot, t);
+                        s = _fmpz_sub_small(t, exps + i);
+                        if (s < 0) abort(); /* Bug catcher */
+                        fmpz_mul_2exp(c, c, s);
+                    }
+                }
+            }
+        }
+    }
+
+    fmpz_clear(top);
+    fmpz_clear(bot);
+    fmpz_clear(t);
+    fmpz_clear(b);
+    fmpz_clear(v);
+    fmpz_clear(block_top);
+    fmpz_clear(block_bot);
+
+    return ok;
+}
+
+/*
+    Given c = a + 2^B u + 2^(2B) d where |a|, |u| < 2^(B-1), sets
+    re = a - d and im = u. Here p = 2^B. The value of c is destroyed.
+*/
+static void
+_fmpz_get_complex_kronecker(fmpz_t re, fmpz_t im, fmpz_t c,
+    const fmpz_t p, ulong B)
+{
+    fmpz_fdiv_r_2exp(re, c, B);
+    if (fmpz_tstbit(re, B - 1))
+        fmpz_sub(re, re, p);
+    fmpz_sub(c, c, re);
+    fmpz_fdiv_q_2exp(c, c, B);
+
+    fmpz_fdiv_r_2exp(im, c, B);
+    if (fmpz_tstbit(im, B - 1))
+        fmpz_sub(im, im, p);
+    fmpz_sub(c, c, im);
+    fmpz_fdiv_q_2exp(c, c, B);
+
+    fmpz_sub(re, re, c);
+}
+
+/*
+    Adds the products of all pairs of blocks to z. The coefficients
+    of x and y are packed as re + 2^B im, so that each pair of blocks
+    requires a single integer polynomial multiplication.
+*/
+/* Sets {res + k0, n - k0} to the coefficients k0 <= k < n of x * y,
+   skipping the leading terms of x and y that do not contribute to them.
+   The entries of res below k0 are undefined (but may be computed:
+   this is a truncated product of the trimmed operands, not a true
+   middle product, and it only gets shorter when k0 exceeds the
+   length of one of the operands). */
+static void
+_fmpz_poly_mullow_trim(fmpz * res, const fmpz * x, long xlen,
+    const fmpz * y, long ylen, long k0, long n, int squaring)
+{
+    long xs, ys;
+
+    xs = FLINT_MAX(0, k0 - (ylen - 1));
+    ys = FLINT_MAX(0, k0 - (xlen - 1));
+
+    x += xs;
+    y += ys;
+    res += xs + ys;
+    n -= xs + ys;
+    xlen = FLINT_MIN(xlen - xs, n);
+    ylen = FLINT_MIN(ylen - ys, n);
+
+    if (squaring)
+        _fmpz_poly_sqrlow(res, x, xlen, n);
+    else if (xlen >= ylen)
+        _fmpz_poly_mullow(res, x, xlen, y, ylen, n);
+    else
+        _fmpz_poly_mullow(res, y, ylen, x, xlen, n);
+}
+
+/* Adds the coefficients lo <= k < n of the product to {z, n - lo}. */
+static void
+_acb_poly_addmullow_block(acb_ptr z, fmpz * zz,
+    const fmpz * xz, const fmpz * xexps, const long * xblocks, long xlen,
+    const fmpz * yz, const fmpz * yexps, const long * yblocks, long ylen,
+    long lo, long n, ulong B, long prec, int squaring)
+{
+    long i, j, k, k0, xp, yp, xl, yl, bn;
+    fmpz_t zexp, p, re, im;
+
+    fmpz_init(zexp);
+    fmpz_init(p);
+    fmpz_init(re);
+    fmpz_init(im);
+
+    fmpz_one(p);
+    fmpz_mul_2exp(p, p, B);
+
+    for (i = 0; (xp = xblocks[i]) != xlen; i++)
+    {
+        for (j = squaring ? i : 0; (yp = yblocks[j]) != ylen; j++)
+        {
+            if (xp + yp >= n)
+                continue;
+
+            xl = xblocks[i + 1] - xp;
+            yl = yblocks[j + 1] - yp;
+            bn = FLINT_MIN(xl + yl - 1, n - xp - yp);
+            xl = FLINT_MIN(xl, bn);
+            yl = FLINT_MIN(yl, bn);
+
+            /* entirely below the wanted coefficients */
+            if (xp + yp + bn <= lo)
+                continue;
+
+            k0 = FLINT_MAX(0, lo - xp - yp);
+
+            if (squaring && i == j)
+            {
+                _fmpz_poly_mullow_trim(zz, xz + xp, xl, xz + xp, xl, k0, bn, 1);
+                _fmpz_add2_fast(zexp, xexps + i, xexps + i, 0);
+            }
+            else
+            {
+                _fmpz_poly_mullow_trim(zz, xz + xp, xl, yz + yp, yl, k0, bn, 0);
+                _fmpz_add2_fast(zexp, xexps + i, yexps + j, squaring);
+            }
+
+            for (k = k0; k < bn; k++)
+            {
+                _fmpz_get_complex_kronecker(re, im, zz + k, p, B);
+
+                arb_add_fmpz_2exp(acb_realref(z + xp + yp + k - lo),
+                    acb_realref(z + xp + yp + k - lo), re, zexp, prec);
+                arb_add_fmpz_2exp(acb_imagref(z + xp + yp + k - lo),
+                    acb_imagref(z + xp + yp + k - lo), im, zexp, prec);
+            }
+        }
+    }
+
+    fmpz_clear(zexp);
+    fmpz_clear(p);
+    fmpz_clear(re);
+    fmpz_clear(im);
+}
+
+/* Sets xm[i] to a bound for |re(mid(x[i]))| + |im(mid(x[i]))| and
+   xr[i] to the larger of the radii of the real and imaginary parts. */
+static void
+_acb_vec_get_mag_mid_rad(mag_ptr xm, mag_ptr xr, acb_srcptr x, long len)
+{
+    mag_t t;
+    long i;
+
+    mag_init(t);
+
+    for (i = 0; i < len; i++)
+    {
+        arf_get_mag(xm + i, arb_midref(acb_realref(x + i)));
+        arf_get_mag(t, arb_midref(acb_imagref(x + i)));
+        mag_add(xm + i, xm + i, t);
+
+        mag_max(xr + i, arb_radref(acb_realref(x + i)),
+                        arb_radref(acb_imagref(x + i)));
+    }
+
+    mag_clear(t);
+}
+
+static int
+_acb_vec_is_finite(acb_srcptr x, long len)
+{
+    long i;
+
+    for (i = 0; i < len; i++)
+        if (!acb_is_finite(x + i))
+            return 0;
+
+    return 1;
+}
+
+/* Packs {re, len} + 2^B {im, len} into re. */
+static void
+_fmpz_vec_pack_complex(fmpz * re, const fmpz * im, long len, ulong B)
+{
+    fmpz_t t;
+    long i;
+
+    fmpz_init(t);
+
+    for (i = 0; i < len; i++)
+    {
+        fmpz_mul_2exp(t, im + i, B);
+        fmpz_add(re + i, re + i, t);
+    }
+
+    fmpz_clear(t);
+}
+
+void
+_acb_poly_mulmid_block(acb_ptr z, acb_srcptr x, long xlen,
+    acb_srcptr y, long ylen, long lo, long n, long prec)
+{
+    long xmlen, xrlen, ymlen, yrlen, i;
+    fmpz *xz, *yz, *xi, *yi, *zz, *xe, *ye;
+    long *xblocks, *yblocks;
+    int squaring, ok;
+    fmpz_t scale, t;
+
+    xlen = FLINT_MIN(xlen, n);
+    ylen = FLINT_MIN(ylen, n);
+
+    squaring = (x == y) && (xlen == ylen);
+
+    /* We don't know how to deal with infinities or NaNs */
+    if (!_acb_vec_is_finite(x, xlen) ||
+        (!squaring && !_acb_vec_is_finite(y, ylen)))
+    {
+        _acb_poly_mulmid_classical(z, x, xlen, y, ylen, lo, n, prec);
+        return;
+    }
+
+    /* Strip trailing zeros */
+    xmlen = xrlen = xlen;
+    while (xmlen > 0 && arf_is_zero(arb_midref(acb_realref(x + xmlen - 1)))
+                     && arf_is_zero(arb_midref(acb_imagref(x + xmlen - 1)))) xmlen--;
+    while (xrlen > 0 && mag_is_zero(arb_radref(acb_realref(x + xrlen - 1)))
+                     && mag_is_zero(arb_radref(acb_imagref(x + xrlen - 1)))) xrlen--;
+
+    if (squaring)
+    {
+        ymlen = xmlen;
+        yrlen = xrlen;
+    }
+    else
+    {
+        ymlen = yrlen = ylen;
+        while (ymlen > 0 && arf_is_zero(arb_midref(acb_realref(y + ymlen - 1)))
+                         && arf_is_zero(arb_midref(acb_imagref(y + ymlen - 1)))) ymlen--;
+        while (yrlen > 0 && mag_is_zero(arb_radref(acb_realref(y + yrlen - 1)))
+                         && mag_is_zero(arb_radref(acb_imagref(y + yrlen - 1)))) yrlen--;
+    }
+
+    xlen = FLINT_MAX(xmlen, xrlen);
+    ylen = FLINT_MAX(ymlen, yrlen);
+
+    /* Start with the zero polynomial */
+    _acb_vec_zero(z, n - lo);
+
+    /* Nothing to do */
+    if (xlen == 0 || ylen == 0 || xlen + ylen - 1 <= lo)
+        return;
+
+    n = FLINT_MIN(n, xlen + ylen - 1);
+
+    fmpz_init(scale);
+    fmpz_init(t);
+    xz = _fmpz_vec_init(xlen);
+    yz = _fmpz_vec_init(ylen);
+    xi = _fmpz_vec_init(xlen);
+    yi = _fmpz_vec_init(ylen);
+    xe = _fmpz_vec_init(xlen);
+    ye = _fmpz_vec_init(ylen);
+    xblocks = flint_malloc(sizeof(long) * (xlen + 1));
+    yblocks = flint_malloc(sizeof(long) * (ylen + 1));
+
+    _acb_poly_get_scale(scale, x, xlen, y, ylen);
+
+    /* Check that the midpoints can be split into blocks before
+       doing any other work */
+    ok = 1;
+    if (xmlen != 0 && ymlen != 0)
+    {
+        ok = _acb_vec_get_fmpz_2exp_blocks(xz, xi, xe, xblocks,
+            scale, x, xmlen, prec);
+
+        if (ok && !squaring)
+            ok = _acb_vec_get_fmpz_2exp_blocks(yz, yi, ye, yblocks,
+                scale, y, ymlen, prec);
+    }
+
+    if (!ok)
+    {
+        _acb_poly_mulmid_transpose(z, x, xlen, y, ylen, lo, n, prec);
+    }
+    else
+    {
+        /* multiply midpoints */
+        if (xmlen != 0 && ymlen != 0)
+        {
+            ulong B;
+            long xbits, ybits;
+
+            xbits = FLINT_MAX(FLINT_ABS(_fmpz_vec_max_bits(xz, xmlen)),
+                              FLINT_ABS(_fmpz_vec_max_bits(xi, xmlen)));
+
+            if (squaring)
+                ybits = xbits;
+            else
+                ybits = FLINT_MAX(FLINT_ABS(_fmpz_vec_max_bits(yz, ymlen)),
+                                  FLINT_ABS(_fmpz_vec_max_bits(yi, ymlen)));
+
+            /* |re|, |im| of each output coefficient are less than
+               2 min(xmlen, ymlen) 2^(xbits + ybits) */
+            B = xbits + ybits + FLINT_BIT_COUNT(FLINT_MIN(xmlen, ymlen)) + 2;
+
+            _fmpz_vec_pack_complex(xz, xi, xmlen, B);
+            if (!squaring)
+                _fmpz_vec_pack_complex(yz, yi, ymlen, B);
+
+            zz = _fmpz_vec_init(n);
+
+            if (squaring)
+                _acb_poly_addmullow_block(z, zz, xz, xe, xblocks, xmlen,
+                    xz, xe, xblocks, xmlen, lo, n, B, prec, 1);
+            else
+                _acb_poly_addmullow_block(z, zz, xz, xe, xblocks, xmlen,
+                    yz, ye, yblocks, ymlen, lo, n, B, prec, 0);
+
+            _fmpz_vec_clear(zz, n);
+        }
+
+        /* Error propagation. With M = |re(m)| + |im(m)| and
+           R = max(rad(re), rad(im)), the radius of both the real and the
+           imaginary part of each term of the product is bounded by
+           Mx Ry + Rx (My + 2 Ry) (or 2 Rx (Mx + Rx) when squaring). */
+        if (xrlen != 0 || yrlen != 0)
+        {
+            mag_ptr xm, xr, ym, yr;
+            arb_ptr r;
+
+            xm = _mag_vec_init(xlen);
+            xr = _mag_vec_init(xlen);
+            r = _arb_vec_init(n - lo);
+
+            _acb_vec_get_mag_mid_rad(xm, xr, x, xlen);
+
+            if (squaring)
+            {
+                for (i = 0; i < xlen; i++)
+                {
+                    mag_add(xm + i, xm + i, xr + i);
+                    mag_mul_2exp_si(xm + i, xm + i, 1);
+                }
+
+                _arb_poly_mullow_block_rad(r, xr, xrlen, xm, xlen, lo, n, scale);
+            }
+            else
+            {
+                ym = _mag_vec_init(ylen);
+                yr = _mag_vec_init(ylen);
+
+                _acb_vec_get_mag_mid_rad(ym, yr, y, ylen);
+
+                _arb_poly_mullow_block_rad(r, xm, xmlen, yr, yrlen, lo, n, scale);
+
+                for (i = 0; i < ylen; i++)
+                {
+                    mag_add(ym + i, ym + i, yr + i);
+                    mag_add(ym + i, ym + i, yr + i);
+                }
+
+                _arb_poly_mullow_block_rad(r, xr, xrlen, ym, ylen, lo, n, scale);
+
+                _mag_vec_clear(ym, ylen);
+                _mag_vec_clear(yr, ylen);
+            }
+
+            for (i = 0; i < n - lo; i++)
+            {
+                mag_add(arb_radref(acb_realref(z + i)),
+                    arb_radref(acb_realref(z + i)), arb_radref(r + i));
+                mag_add(arb_radref(acb_imagref(z + i)),
+                    arb_radref(acb_imagref(z + i)), arb_radref(r + i));
+            }
+
+            _mag_vec_clear(xm, xlen);
+            _mag_vec_clear(xr, xlen);
+            _arb_vec_clear(r, n - lo);
+        }
+
+        /* Unscale. */
+        if (!fmpz_is_zero(scale))
+        {
+            fmpz_mul_ui(t, scale, lo);
+            for (i = lo; i < n; i++)
+            {
+                acb_mul_2exp_fmpz(z + i - lo, z + i - lo, t);
+                fmpz_add(t, t, scale);
+            }
+        }
+    }
+
+    _fmpz_vec_clear(xz, xlen);
+    _fmpz_vec_clear(yz, ylen);
+    _fmpz_vec_clear(xi, xlen);
+    _fmpz_vec_clear(yi, ylen);
+    _fmpz_vec_clear(xe, xlen);
+    _fmpz_vec_clear(ye, ylen);
+    flint_free(xblocks);
+    flint_free(yblocks);
+    fmpz_clear(scale);
+    fmpz_clear(t);
+}
+
+void
+_acb_poly_mullow_block(acb_ptr z, acb_srcptr x, long xlen,
+                                acb_srcptr y, long ylen, long n, long prec)
+{
+    _acb_poly_mulmid_block(z, x, xlen, y, ylen, 0, n, prec);
+}
+
+void
+acb_poly_mullow_block(acb_poly_t res, const acb_poly_t poly1,
+              const acb_poly_t poly2, long n, long prec)
+{
+    long xlen, ylen, zlen;
+
+    xlen = poly1->length;
+    ylen = poly2->length;
+
+    if (xlen == 0 || ylen == 0 || n == 0)
+    {
+        acb_poly_zero(res);
+        return;
+    }
+
+    xlen = FLINT_MIN(xlen, n);
+    ylen = FLINT_MIN(ylen, n);
+    zlen = FLINT_MIN(xlen + ylen - 1, n);
+
+    if (res == poly1 || res == poly2)
+    {
+        acb_poly_t tmp;
+        acb_poly_init2(tmp, zlen);
+        _acb_poly_mullow_block(tmp->coeffs, poly1->coeffs, xlen,
+            poly2->coeffs, ylen, zlen, prec);
+        acb_poly_swap(res, tmp);
+        acb_poly_clear(tmp);
+    }
+    else
+    {
+        acb_poly_fit_length(res, zlen);
+        _acb_poly_mullow_block(res->coeffs, poly1->coeffs, xlen,
+            poly2->coeffs, ylen, zlen, prec);
+    }
+
+    _acb_poly_set_length(res, zlen);
+    _acb_poly_normalise(res);
+}
+
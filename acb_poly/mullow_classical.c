@@ -40,35 +40,33 @@ _acb_poly_mullow_classical(acb_ptr res,
     }
     else if (poly1 == poly2 && len1 == len2)
     {
-        long i;
+        long i, start, stop;
 
-        _acb_vec_scalar_mul(res, poly1, FLINT_MIN(len1, n), poly1, prec);
-        _acb_vec_scalar_mul(res + len1, poly1 + 1, n - len1, poly1 + len1 - 1, prec);
+        for (i = 0; i < n; i++)
+        {
+            start = FLINT_MAX(0, i - len1 + 1);
+            stop = FLINT_MIN(len1 - 1, (i + 1) / 2 - 1);
 
-        for (i = 1; i < len1 - 1; i++)
-            _acb_vec_scalar_addmul(res + i + 1, poly1 + 1,
-                FLINT_MIN(i - 1, n - (i + 1)), poly1 + i, prec);
-
-        for (i = 1; i < FLINT_MIN(2 * len1 - 2, n); i++)
+            acb_dot(res + i, NULL, 0, poly1 + start, 1,
+                poly1 + i - start, -1, stop - start + 1, prec);
             acb_mul_2exp_si(res + i, res + i, 1);
 
-        for (i = 1; i < FLINT_MIN(len1 - 1, (n + 1) / 2); i++)
-            acb_addmul(res + 2 * i, poly1 + i, poly1 + i, prec);
+            if (i % 2 == 0 && i / 2 < len1)
+                acb_addmul(res + i, poly1 + i / 2, poly1 + i / 2, prec);
+        }
     }
     else
     {
-        long i;
-
-        _acb_vec_scalar_mul(res, poly1, FLINT_MIN(len1, n), poly2, prec);
+        long i, start, stop;
 
-        if (n > len1)
-            _acb_vec_scalar_mul(res + len1, poly2 + 1, n - len1,
-                                      poly1 + len1 - 1, prec);
+        for (i = 0; i < n; i++)
+        {
+            start = FLINT_MAX(0, i - len2 + 1);
+            stop = FLINT_MIN(len1 - 1, i);
 
-        for (i = 0; i < FLINT_MIN(len1, n) - 1; i++)
-            _acb_vec_scalar_addmul(res + i + 1, poly2 + 1,
-                                         FLINT_MIN(len2, n - i) - 1,
-                                         poly1 + i, prec);
+            acb_dot(res + i, NULL, 0, poly1 + start, 1,
+                poly2 + i - start, -1, stop - start + 1, prec);
+        }
     }
 }
 
@@ -0,0 +1,94 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb_poly.h"
+
+void
+_acb_poly_mulmid_transpose(acb_ptr res,
+    acb_srcptr poly1, long len1,
+    acb_srcptr poly2, long len2, long lo, long hi, long prec)
+{
+    arb_ptr a, b, c, d, e, f, w;
+    arb_ptr t;
+    long i, n;
+
+    len1 = FLINT_MIN(len1, hi);
+    len2 = FLINT_MIN(len2, hi);
+    n = hi - lo;
+
+    w = flint_malloc(sizeof(arb_struct) * (2 * (len1 + len2 + n)));
+    a = w;
+    b = a + len1;
+    c = b + len1;
+    d = c + len2;
+    e = d + len2;
+    f = e + n;
+
+    /* (e+fi) = (a+bi)(c+di) = (ac - bd) + (ad + bc)i */
+    t = _arb_vec_init(n);
+
+    for (i = 0; i < len1; i++)
+    {
+        a[i] = *acb_realref(poly1 + i);
+        b[i] = *acb_imagref(poly1 + i);
+    }
+
+    for (i = 0; i < len2; i++)
+    {
+        c[i] = *acb_realref(poly2 + i);
+        d[i] = *acb_imagref(poly2 + i);
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        e[i] = *acb_realref(res + i);
+        f[i] = *acb_imagref(res + i);
+    }
+
+    _arb_poly_mulmid(e, a, len1, c, len2, lo, hi, prec);
+    _arb_poly_mulmid(t, b, len1, d, len2, lo, hi, prec);
+    _arb_vec_sub(e, e, t, n, prec);
+
+    _arb_poly_mulmid(f, a, len1, d, len2, lo, hi, prec);
+    /* squaring */
+    if (poly1 == poly2 && len1 == len2)
+    {
+        _arb_vec_scalar_mul_2exp_si(f, f, n, 1);
+    }
+    else
+    {
+        _arb_poly_mulmid(t, b, len1, c, len2, lo, hi, prec);
+        _arb_vec_add(f, f, t, n, prec);
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        *acb_realref(res + i) = e[i];
+        *acb_imagref(res + i) = f[i];
+    }
+
+    _arb_vec_clear(t, n);
+    flint_free(w);
+}
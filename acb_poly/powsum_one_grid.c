@@ -0,0 +1,143 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb_poly.h"
+#include "arb_thread_pool.h"
+
+/*
+    For each k, the terms k^(-(s + i j h)) for j = 0, 1, ... form a
+    geometric sequence with ratio k^(-ih) = exp(-ih log(k)). After one
+    exponential and one sine/cosine evaluation per k, each point on the
+    grid therefore only costs a complex multiplication.
+*/
+
+typedef struct
+{
+    acb_ptr z;
+    acb_srcptr s;
+    arb_srcptr h;
+    long num;
+    long n0;
+    long n1;
+    long prec;
+}
+powsum_grid_arg_t;
+
+static void
+_acb_poly_powsum_grid_evaluator(void * args, long i)
+{
+    powsum_grid_arg_t arg = ((powsum_grid_arg_t *) args)[i];
+    acb_t t, r;
+    arb_t logk, x;
+    long j, k, prev;
+
+    acb_init(t);
+    acb_init(r);
+    arb_init(logk);
+    arb_init(x);
+
+    _acb_vec_zero(arg.z, arg.num);
+    prev = 0;
+
+    for (k = arg.n0; k < arg.n1; k++)
+    {
+        if (k == 1)
+        {
+            for (j = 0; j < arg.num; j++)
+                acb_add_ui(arg.z + j, arg.z + j, 1, arg.prec);
+            continue;
+        }
+
+        arb_log_ui_from_prev(logk, k, logk, prev, arg.prec);
+        prev = k;
+
+        /* t = k^(-s) */
+        acb_mul_arb(t, arg.s, logk, arg.prec);
+        acb_neg(t, t);
+        acb_exp(t, t, arg.prec);
+
+        /* r = k^(-ih) */
+        arb_mul(x, arg.h, logk, arg.prec);
+        arb_sin_cos(acb_imagref(r), acb_realref(r), x, arg.prec);
+        arb_neg(acb_imagref(r), acb_imagref(r));
+
+        for (j = 0; j < arg.num; j++)
+        {
+            acb_add(arg.z + j, arg.z + j, t, arg.prec);
+            if (j < arg.num - 1)
+                acb_mul(t, t, r, arg.prec);
+        }
+    }
+
+    acb_clear(t);
+    acb_clear(r);
+    arb_clear(logk);
+    arb_clear(x);
+}
+
+void
+_acb_poly_powsum_one_grid(acb_ptr res, const acb_t s, const arb_t h,
+    long num, long n, long prec)
+{
+    powsum_grid_arg_t * args;
+    long i, num_threads;
+
+    if (num <= 0)
+        return;
+
+    num_threads = flint_get_num_threads();
+
+    if (n <= 50 || num_threads <= 1)
+        num_threads = 1;
+    else
+        num_threads = FLINT_MIN(num_threads, n / 16);
+
+    args = flint_malloc(sizeof(powsum_grid_arg_t) * num_threads);
+
+    for (i = 0; i < num_threads; i++)
+    {
+        args[i].z = (i == 0) ? res : _acb_vec_init(num);
+        args[i].s = s;
+        args[i].h = h;
+        args[i].num = num;
+        args[i].n0 = 1 + (n * i) / num_threads;
+        args[i].n1 = 1 + (n * (i + 1)) / num_threads;
+        args[i].prec = prec;
+    }
+
+    if (num_threads == 1)
+        _acb_poly_powsum_grid_evaluator(args, 0);
+    else
+        arb_thread_pool_parallel_do(_acb_poly_powsum_grid_evaluator, args,
+            num_threads, num_threads);
+
+    for (i = 1; i < num_threads; i++)
+    {
+        _acb_vec_add(res, res, args[i].z, num, prec);
+        _acb_vec_clear(args[i].z, num);
+    }
+
+    flint_free(args);
+}
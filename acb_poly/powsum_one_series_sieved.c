@@ -19,69 +19,190 @@
 =============================================================================*/
 /******************************************************************************
 
-    Copyright (C) 2012-2014 Fredrik Johansson
+    Copyright (C) 2012-2015 Fredrik Johansson
 
 ******************************************************************************/
 
 #include "acb_poly.h"
+#include "arb_thread_pool.h"
+
+/*
+    Only odd k are visited. The sum over a <= k <= n is
+
+        sum_{k odd} k^(-s) (x^c(k) + ... + x^b(k)),   x = 2^(-s),
+
+    where b(k) = floor(log2(n/k)) and c(k) is the smallest c with
+    k 2^c >= a, so the terms with equal (c(k), b(k)) are collected
+    in a bin and the bins are combined by a Horner scheme in x at the end.
+    For a = 1, only c = 0 occurs.
+
+    The power of a composite k is computed as the product of the powers
+    of its smallest prime factor p and of k/p <= k/3, so only powers of k
+    <= n/3 need to be stored. The odd k are processed in stages
+    (n/3, n], (n/9, n/3], ..., starting from the smallest. Within a stage
+    all powers that are needed are already in the table, and the stage is
+    split into chunks of fixed size which can be computed in parallel.
+    The partial sums of the chunks are added in a fixed order, so the
+    result does not depend on the number of threads.
+*/
+
+#define POWSUM_CHUNK 512
 
 #define POWER(_k) (powers + (((_k)-1)/2) * (len))
 #define DIVISOR(_k) (divisors[((_k)-1)/2])
 
-#define COMPUTE_POWER(t, k, kprev) \
-  do { \
-    if (integer) \
-    { \
-        arb_neg(w, acb_realref(s)); \
-        arb_set_ui(v, k); \
-        arb_pow(acb_realref(t), v, w, prec); \
-        arb_zero(acb_imagref(t)); \
-        if (len != 1) \
-        { \
-            arb_log_ui_from_prev(logk, k, logk, kprev, prec); \
-            kprev = k; \
-            arb_neg(logk, logk); \
-        } \
-    } \
-    else \
-    { \
-        arb_log_ui_from_prev(logk, k, logk, kprev, prec); \
-        kprev = k; \
-        arb_neg(logk, logk); \
-        arb_mul(w, logk, acb_imagref(s), prec); \
-        arb_sin_cos(acb_imagref(t), acb_realref(t), w, prec); \
-        if (critical_line) \
-        { \
-            arb_rsqrt_ui(w, k, prec); \
-            acb_mul_arb(t, t, w, prec); \
-        } \
-        else \
-        { \
-            arb_mul(w, acb_realref(s), logk, prec); \
-            arb_exp(w, w, prec); \
-            acb_mul_arb(t, t, w, prec); \
-        } \
-    } \
-    for (i = 1; i < len; i++) \
-    { \
-        acb_mul_arb(t + i, t + i - 1, logk, prec); \
-        acb_div_ui(t + i, t + i, i, prec); \
-    } \
-    arb_neg(logk, logk); \
-  } while (0); \
+typedef struct
+{
+    acb_ptr bins;
+    acb_ptr powers;
+    const long * divisors;
+    acb_srcptr s;
+    long k0;
+    long k1;
+    long a;
+    long n;
+    long nbins;
+    long len;
+    long prec;
+    int integer;
+    int critical_line;
+}
+powsum_chunk_t;
+
+static void
+_acb_poly_powsum_compute_power(acb_ptr t, long k, arb_t logk, long * kprev,
+    const powsum_chunk_t * arg)
+{
+    acb_srcptr s = arg->s;
+    long i, len = arg->len, prec = arg->prec;
+    arb_t v, w;
 
-void
-_acb_poly_powsum_one_series_sieved(acb_ptr z, const acb_t s, long n, long len, long prec)
+    arb_init(v);
+    arb_init(w);
+
+    if (arg->integer)
+    {
+        arb_neg(w, acb_realref(s));
+        arb_set_ui(v, k);
+        arb_pow(acb_realref(t), v, w, prec);
+        arb_zero(acb_imagref(t));
+
+        if (len != 1)
+        {
+            arb_log_ui_from_prev(logk, k, logk, *kprev, prec);
+            *kprev = k;
+        }
+    }
+    else
+    {
+        arb_log_ui_from_prev(logk, k, logk, *kprev, prec);
+        *kprev = k;
+
+        arb_mul(w, logk, acb_imagref(s), prec);
+        arb_neg(w, w);
+        arb_sin_cos(acb_imagref(t), acb_realref(t), w, prec);
+
+        if (arg->critical_line)
+        {
+            arb_rsqrt_ui(w, k, prec);
+            acb_mul_arb(t, t, w, prec);
+        }
+        else
+        {
+            arb_mul(w, acb_realref(s), logk, prec);
+            arb_neg(w, w);
+            arb_exp(w, w, prec);
+            acb_mul_arb(t, t, w, prec);
+        }
+    }
+
+    if (len != 1)
+    {
+        arb_neg(w, logk);
+
+        for (i = 1; i < len; i++)
+        {
+            acb_mul_arb(t + i, t + i - 1, w, prec);
+            acb_div_ui(t + i, t + i, i, prec);
+        }
+    }
+
+    arb_clear(v);
+    arb_clear(w);
+}
+
+static void
+_acb_poly_powsum_sieved_worker(void * args, long j)
+{
+    const powsum_chunk_t * arg = ((const powsum_chunk_t *) args) + j;
+    acb_ptr t, powers = arg->powers;
+    const long * divisors = arg->divisors;
+    long k, b, c, kprev, len = arg->len;
+    arb_t logk;
+
+    t = _acb_vec_init(len);
+    arb_init(logk);
+    kprev = 0;
+
+    for (k = arg->k0; k < arg->k1; k += 2)
+    {
+        /* t = k^(-s) */
+        if (k == 1)
+        {
+            acb_one(t);
+            _acb_vec_zero(t + 1, len - 1);
+        }
+        else if (DIVISOR(k) == 0)
+        {
+            _acb_poly_powsum_compute_power(t, k, logk, &kprev, arg);
+        }
+        else if (len == 1)
+        {
+            acb_mul(t, POWER(DIVISOR(k)), POWER(k / DIVISOR(k)), arg->prec);
+        }
+        else
+        {
+            _acb_poly_mullow(t, POWER(DIVISOR(k)), len,
+                POWER(k / DIVISOR(k)), len, len, arg->prec);
+        }
+
+        if (k * 3 <= arg->n)
+            _acb_vec_set(POWER(k), t, len);
+
+        b = FLINT_BIT_COUNT(arg->n / k) - 1;
+        for (c = 0; (k << c) < arg->a; c++) ;
+
+        if (c <= b)
+        {
+            b += c * arg->nbins;
+            _acb_vec_add(arg->bins + b * len, arg->bins + b * len, t, len,
+                arg->prec);
+        }
+    }
+
+    _acb_vec_clear(t, len);
+    arb_clear(logk);
+}
+
+/* sum_{k=a}^n k^(-s-t) */
+static void
+_acb_poly_powsum_sieved_range(acb_ptr z, const acb_t s, long a, long n,
+    long len, long prec)
 {
     long * divisors;
-    long powers_alloc;
-    long i, j, k, ibound, kprev, power_of_two, horner_point;
+    long powers_alloc, nbins, nrows, num_chunks, alloc_chunks, num_stages;
+    long i, j, c, b, lo, hi, num_threads;
+    long stages[FLINT_BITS + 1];
     int critical_line, integer;
 
-    acb_ptr powers;
-    acb_ptr t, u, x;
-    acb_ptr p1, p2;
-    arb_t logk, v, w;
+    acb_ptr powers, bins, t, u, x;
+    powsum_chunk_t * args;
+
+    if (n < a)
+    {
+        _acb_vec_zero(z, len);
+        return;
+    }
 
     critical_line = arb_is_exact(acb_realref(s)) &&
         (arf_cmp_2exp_si(arb_midref(acb_realref(s)), -1) == 0);
@@ -92,73 +213,126 @@ _acb_poly_powsum_one_series_sieved(acb_ptr z, const acb_t s, long n, long len, l
     powers_alloc = (n / 6 + 1) * len;
     powers = _acb_vec_init(powers_alloc);
 
-    ibound = n_sqrt(n);
-    for (i = 3; i <= ibound; i += 2)
+    hi = n_sqrt(n);
+    for (i = 3; i <= hi; i += 2)
         if (DIVISOR(i) == 0)
             for (j = i * i; j <= n; j += 2 * i)
                 DIVISOR(j) = i;
 
+    nbins = FLINT_BIT_COUNT(n);
+    nrows = FLINT_BIT_COUNT(a - 1) + 1;
+    bins = _acb_vec_init(nrows * nbins * len);
     t = _acb_vec_init(len);
     u = _acb_vec_init(len);
     x = _acb_vec_init(len);
-    arb_init(logk);
-    arb_init(v);
-    arb_init(w);
 
-    power_of_two = 1;
-    while (power_of_two * 2 <= n)
-        power_of_two *= 2;
-    horner_point = n / power_of_two;
+    alloc_chunks = (n / 2) / POWSUM_CHUNK + 1;
+    args = flint_malloc(sizeof(powsum_chunk_t) * alloc_chunks);
 
-    _acb_vec_zero(z, len);
+    for (j = 0; j < alloc_chunks; j++)
+    {
+        args[j].bins = NULL;
+        args[j].powers = powers;
+        args[j].divisors = divisors;
+        args[j].s = s;
+        args[j].a = a;
+        args[j].n = n;
+        args[j].nbins = nbins;
+        args[j].len = len;
+        args[j].prec = prec;
+        args[j].integer = integer;
+        args[j].critical_line = critical_line;
+    }
 
-    kprev = 0;
-    COMPUTE_POWER(x, 2, kprev);
+    num_threads = flint_get_num_threads();
 
-    for (k = 1; k <= n; k += 2)
+    /* x = 2^(-s) */
     {
-        /* t = k^(-s) */
-        if (DIVISOR(k) == 0)
+        arb_t logk;
+        long kprev = 0;
+        arb_init(logk);
+        _acb_poly_powsum_compute_power(x, 2, logk, &kprev, args);
+        arb_clear(logk);
+    }
+
+    /* stage boundaries n, n / 3, n / 9, ... */
+    num_stages = 1;
+    stages[0] = n;
+    while (stages[num_stages - 1] > 3)
+    {
+        stages[num_stages] = stages[num_stages - 1] / 3;
+        num_stages++;
+    }
+    stages[num_stages] = 0;
+
+    for (i = num_stages - 1; i >= 0; i--)
+    {
+        /* odd k in (lo, hi] */
+        lo = stages[i + 1];
+        hi = stages[i];
+        num_chunks = ((hi + 1) / 2 - (lo + 1) / 2 + POWSUM_CHUNK - 1)
+            / POWSUM_CHUNK;
+
+        for (j = 0; j < num_chunks; j++)
         {
-            COMPUTE_POWER(t, k, kprev);
+            args[j].k0 = ((lo + 1) | 1) + 2 * POWSUM_CHUNK * j;
+            args[j].k1 = FLINT_MIN(args[j].k0 + 2 * POWSUM_CHUNK, hi + 1);
+            args[j].bins = (j == 0) ? bins : _acb_vec_init(nrows * nbins * len);
         }
+
+        if (num_chunks > 1 && num_threads > 1)
+            arb_thread_pool_parallel_do(_acb_poly_powsum_sieved_worker,
+                args, num_chunks, num_threads);
         else
-        {
-            p1 = POWER(DIVISOR(k));
-            p2 = POWER(k / DIVISOR(k));
+            for (j = 0; j < num_chunks; j++)
+                _acb_poly_powsum_sieved_worker(args, j);
 
-            if (len == 1)
-                acb_mul(t, p1, p2, prec);
-            else
-                _acb_poly_mullow(t, p1, len, p2, len, len, prec);
+        for (j = 1; j < num_chunks; j++)
+        {
+            _acb_vec_add(bins, bins, args[j].bins, nrows * nbins * len, prec);
+            _acb_vec_clear(args[j].bins, nrows * nbins * len);
         }
+    }
 
-        if (k * 3 <= n)
-            _acb_vec_set(POWER(k), t, len);
-
-        _acb_vec_add(u, u, t, len, prec);
+    /* z = sum_{c,b} bins[c,b] (x^c + ... + x^b) = sum_j x^j u_j where
+       u_j = sum_{c <= j <= b} bins[c,b]; for c = 0 the rows are summed
+       incrementally */
+    _acb_vec_zero(z, len);
+    _acb_vec_zero(u, len);
 
-        while (k == horner_point && power_of_two != 1)
-        {
-            _acb_poly_mullow(t, z, len, x, len, len, prec);
-            _acb_vec_add(z, t, u, len, prec);
+    for (i = nbins - 1; i >= 0; i--)
+    {
+        _acb_vec_add(u, u, bins + i * len, len, prec);
+        _acb_poly_mullow(t, z, len, x, len, len, prec);
+        _acb_vec_add(z, t, u, len, prec);
 
-            power_of_two /= 2;
-            horner_point = n / power_of_two;
-            horner_point -= (horner_point % 2 == 0);
-        }
+        for (c = 1; c <= i && c < nrows; c++)
+            for (b = i; b < nbins; b++)
+                _acb_vec_add(z, z, bins + (c * nbins + b) * len, len, prec);
     }
 
-    _acb_poly_mullow(t, z, len, x, len, len, prec);
-    _acb_vec_add(z, t, u, len, prec);
-
     flint_free(divisors);
+    flint_free(args);
     _acb_vec_clear(powers, powers_alloc);
+    _acb_vec_clear(bins, nrows * nbins * len);
     _acb_vec_clear(t, len);
     _acb_vec_clear(u, len);
     _acb_vec_clear(x, len);
-    arb_clear(logk);
-    arb_clear(v);
-    arb_clear(w);
 }
 
+void
+_acb_poly_powsum_one_series_sieved(acb_ptr z, const acb_t s, long n, long len, long prec)
+{
+    _acb_poly_powsum_sieved_range(z, s, 1, n, len, prec);
+}
+
+void
+_acb_poly_powsum_ui_series_sieved(acb_ptr z, const acb_t s, ulong a, long n, long len, long prec)
+{
+    if (n <= 0)
+        _acb_vec_zero(z, len);
+    else if (a == 0)
+        _acb_vec_indeterminate(z, len);
+    else
+        _acb_poly_powsum_sieved_range(z, s, a, n + a - 1, len, prec);
+}
@@ -0,0 +1,56 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb_poly.h"
+
+void
+_acb_poly_powsum_series(acb_ptr z, const acb_t s, const acb_t a,
+    const acb_t q, long n, long len, long prec)
+{
+    if (n <= 0)
+    {
+        _acb_vec_zero(z, len);
+        return;
+    }
+
+    /* sieving visits all k <= n + a - 1, so only use it for small a */
+    if (acb_is_one(q) && len <= ACB_POLY_POWSUM_SIEVED_MAX_LEN
+        && acb_is_real(a) && arb_is_int(acb_realref(a))
+        && arf_sgn(arb_midref(acb_realref(a))) > 0
+        && arf_cmpabs_ui(arb_midref(acb_realref(a)), n) <= 0)
+    {
+        _acb_poly_powsum_ui_series_sieved(z, s,
+            arf_get_si(arb_midref(acb_realref(a)), ARF_RND_DOWN),
+            n, len, prec);
+    }
+    else if (n > 50 && flint_get_num_threads() > 1)
+    {
+        _acb_poly_powsum_series_naive_threaded(z, s, a, q, n, len, prec);
+    }
+    else
+    {
+        _acb_poly_powsum_series_naive(z, s, a, q, n, len, prec);
+    }
+}
@@ -0,0 +1,159 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "acb_poly.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("mullow_block....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000; iter++)
+    {
+        long len1, len2, trunc, prec, i;
+        acb_poly_t a, b, c, d, e;
+
+        len1 = n_randint(state, 50);
+        len2 = n_randint(state, 50);
+        trunc = n_randint(state, 100);
+        prec = 2 + n_randint(state, 300);
+
+        acb_poly_init(a);
+        acb_poly_init(b);
+        acb_poly_init(c);
+        acb_poly_init(d);
+        acb_poly_init(e);
+
+        acb_poly_randtest(a, state, len1, 2 + n_randint(state, 300),
+            1 + n_randint(state, 12));
+        acb_poly_randtest(b, state, len2, 2 + n_randint(state, 300),
+            1 + n_randint(state, 12));
+
+        /* exact inputs: compare with the exact product */
+        if (n_randint(state, 2))
+        {
+            for (i = 0; i < a->length; i++)
+            {
+                mag_zero(arb_radref(acb_realref(a->coeffs + i)));
+                mag_zero(arb_radref(acb_imagref(a->coeffs + i)));
+            }
+
+            for (i = 0; i < b->length; i++)
+            {
+                mag_zero(arb_radref(acb_realref(b->coeffs + i)));
+                mag_zero(arb_radref(acb_imagref(b->coeffs + i)));
+            }
+
+            if (n_randint(state, 4) == 0)
+            {
+                acb_poly_mullow_block(c, a, a, trunc, prec);
+                acb_poly_mullow_classical(e, a, a, trunc, ARF_PREC_EXACT);
+            }
+            else
+            {
+                acb_poly_mullow_block(c, a, b, trunc, prec);
+                acb_poly_mullow_classical(e, a, b, trunc, ARF_PREC_EXACT);
+            }
+
+            if (!acb_poly_contains(c, e))
+            {
+                printf("FAIL (containment)\n\n");
+                printf("prec = %ld, trunc = %ld\n\n", prec, trunc);
+                printf("a = "); acb_poly_printd(a, 15); printf("\n\n");
+                printf("b = "); acb_poly_printd(b, 15); printf("\n\n");
+                printf("c = "); acb_poly_printd(c, 15); printf("\n\n");
+                printf("e = "); acb_poly_printd(e, 15); printf("\n\n");
+                abort();
+            }
+        }
+
+        acb_poly_mullow_block(c, a, b, trunc, prec);
+        acb_poly_mullow_classical(d, a, b, trunc, prec);
+
+        if (!acb_poly_overlaps(c, d))
+        {
+            printf("FAIL (overlap)\n\n");
+            printf("prec = %ld, trunc = %ld\n\n", prec, trunc);
+            printf("a = "); acb_poly_printd(a, 15); printf("\n\n");
+            printf("b = "); acb_poly_printd(b, 15); printf("\n\n");
+            printf("c = "); acb_poly_printd(c, 15); printf("\n\n");
+            printf("d = "); acb_poly_printd(d, 15); printf("\n\n");
+            abort();
+        }
+
+        acb_poly_set(d, a);
+        acb_poly_mullow_block(d, d, b, trunc, prec);
+        if (!acb_poly_equal(d, c))
+        {
+            printf("FAIL (aliasing 1)\n\n");
+            abort();
+        }
+
+        acb_poly_set(d, b);
+        acb_poly_mullow_block(d, a, d, trunc, prec);
+        if (!acb_poly_equal(d, c))
+        {
+            printf("FAIL (aliasing 2)\n\n");
+            abort();
+        }
+
+        /* test squaring */
+        acb_poly_set(b, a);
+        acb_poly_mullow_block(c, a, b, trunc, prec);
+        acb_poly_mullow_block(d, a, a, trunc, prec);
+        if (!acb_poly_overlaps(c, d))  /* not guaranteed to be identical */
+        {
+            printf("FAIL (squaring)\n\n");
+            printf("a = "); acb_poly_printd(a, 15); printf("\n\n");
+            printf("c = "); acb_poly_printd(c, 15); printf("\n\n");
+            printf("d = "); acb_poly_printd(d, 15); printf("\n\n");
+            abort();
+        }
+
+        acb_poly_mullow_block(a, a, a, trunc, prec);
+        if (!acb_poly_equal(d, a))
+        {
+            printf("FAIL (aliasing, squaring)\n\n");
+            abort();
+        }
+
+        acb_poly_clear(a);
+        acb_poly_clear(b);
+        acb_poly_clear(c);
+        acb_poly_clear(d);
+        acb_poly_clear(e);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
@@ -43,31 +43,19 @@ void _acb_poly_mullow_cpx(acb_ptr res, acb_srcptr src, long len, const acb_t c,
 }
 
 
+/* everything except the power sum */
 void
-_acb_poly_zeta_em_sum(acb_ptr z, const acb_t s, const acb_t a, int deflate, ulong N, ulong M, long d, long prec)
+_acb_poly_zeta_em_correction(acb_ptr z, const acb_t s, const acb_t a, int deflate, ulong N, ulong M, long d, long prec)
 {
-    acb_ptr t, u, v, term, sum;
-    acb_t Na, one;
+    acb_ptr t, u, v, sum;
+    acb_t Na;
     long i;
 
     t = _acb_vec_init(d + 1);
     u = _acb_vec_init(d);
     v = _acb_vec_init(d);
-    term = _acb_vec_init(d);
     sum = _acb_vec_init(d);
     acb_init(Na);
-    acb_init(one);
-
-    prec += 2 * (FLINT_BIT_COUNT(N) + FLINT_BIT_COUNT(d));
-    acb_one(one);
-
-    /* sum 1/(k+a)^(s+x) */
-    if (acb_is_one(a) && d <= 3)
-        _acb_poly_powsum_one_series_sieved(sum, s, N, d, prec);
-    else if (N > 50 && flint_get_num_threads() > 1)
-        _acb_poly_powsum_series_naive_threaded(sum, s, a, one, N, d, prec);
-    else
-        _acb_poly_powsum_series_naive(sum, s, a, one, N, d, prec);
 
     /* t = 1/(N+a)^(s+x); we might need one extra term for deflation */
     acb_add_ui(Na, a, N, prec);
@@ -139,9 +127,31 @@ _acb_poly_zeta_em_sum(acb_ptr z, const acb_t s, const acb_t a, int deflate, ulon
     _acb_vec_clear(t, d + 1);
     _acb_vec_clear(u, d);
     _acb_vec_clear(v, d);
-    _acb_vec_clear(term, d);
     _acb_vec_clear(sum, d);
     acb_clear(Na);
+}
+
+void
+_acb_poly_zeta_em_sum(acb_ptr z, const acb_t s, const acb_t a, int deflate, ulong N, ulong M, long d, long prec)
+{
+    acb_ptr sum, u;
+    acb_t one;
+
+    sum = _acb_vec_init(d);
+    u = _acb_vec_init(d);
+    acb_init(one);
+
+    prec += 2 * (FLINT_BIT_COUNT(N) + FLINT_BIT_COUNT(d));
+    acb_one(one);
+
+    /* sum 1/(k+a)^(s+x) */
+    _acb_poly_powsum_series(sum, s, a, one, N, d, prec);
+
+    _acb_poly_zeta_em_correction(u, s, a, deflate, N, M, d, prec);
+    _acb_vec_add(z, sum, u, d, prec);
+
+    _acb_vec_clear(sum, d);
+    _acb_vec_clear(u, d);
     acb_clear(one);
 }
 
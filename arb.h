@@ -533,6 +533,11 @@ void arb_submul_si(arb_t z, const arb_t x, long y, long prec);
 void arb_submul_ui(arb_t z, const arb_t x, ulong y, long prec);
 void arb_submul_fmpz(arb_t z, const arb_t x, const fmpz_t y, long prec);
 
+void arb_dot_simple(arb_t res, const arb_t initial, int subtract,
+    arb_srcptr x, long xstep, arb_srcptr y, long ystep, long len, long prec);
+void arb_dot(arb_t res, const arb_t initial, int subtract,
+    arb_srcptr x, long xstep, arb_srcptr y, long ystep, long len, long prec);
+
 void arb_div(arb_t z, const arb_t x, const arb_t y, long prec);
 void arb_div_arf(arb_t z, const arb_t x, const arf_t y, long prec);
 void arb_div_si(arb_t z, const arb_t x, long y, long prec);
@@ -658,6 +663,9 @@ void arb_zeta_ui_borwein_bsplit(arb_t x, ulong s, long prec);
 void arb_zeta_ui_euler_product(arb_t z, ulong s, long prec);
 void arb_zeta_ui_bernoulli(arb_t x, ulong n, long prec);
 void arb_zeta_ui_vec_borwein(arb_ptr z, ulong start, long num, ulong step, long prec);
+void arb_zeta_ui_vec_euler_product(arb_ptr z, ulong start, long num, ulong step, long prec);
+int _arb_zeta_ui_use_euler_product(ulong n, long prec);
+void _arb_zeta_ui_vec_step(arb_ptr x, ulong start, long num, ulong step, long prec);
 void arb_zeta_ui(arb_t x, ulong n, long prec);
 void arb_zeta_ui_vec_even(arb_ptr x, ulong start, long num, long prec);
 void arb_zeta_ui_vec_odd(arb_ptr x, ulong start, long num, long prec);
@@ -678,27 +686,58 @@ void arb_bell_sum_taylor(arb_t res, const fmpz_t n, const fmpz_t a, const fmpz_t
 void arb_bell_sum_bsplit(arb_t res, const fmpz_t n, const fmpz_t a, const fmpz_t b, const fmpz_t mmag, long prec);
 void arb_bell_fmpz(arb_t res, const fmpz_t n, long prec);
 
+/* process-wide cache of constants */
+
+typedef void (*arb_const_cache_eval_t)(arb_t, long);
+
+typedef struct arb_const_cache_node_struct
+{
+    arb_struct value;
+    long prec;
+    struct arb_const_cache_node_struct * next;
+}
+arb_const_cache_node_struct;
+
+typedef struct arb_const_cache_struct
+{
+    arb_const_cache_node_struct * volatile head;
+    void * lock;
+    struct arb_const_cache_struct * next;
+    const char * name;
+}
+arb_const_cache_struct;
+
+typedef arb_const_cache_struct arb_const_cache_t[1];
+
+#define ARB_CONST_CACHE_INITIALIZER(name) { { NULL, NULL, NULL, name } }
+
+void arb_const_cache_get(arb_t x, arb_const_cache_t cache,
+    arb_const_cache_eval_t comp_func, long prec);
+
+long arb_const_cache_prec(const arb_const_cache_t cache);
+
+void arb_const_cache_clear_all(void);
+
+/* persistent cache file */
+
+#define ARB_DISK_CACHE_VERSION 1
+#define ARB_DISK_CACHE_KEY_LEN 32
+#define ARB_DISK_CACHE_MIN_PREC 4096
+#define ARB_DISK_CACHE_MIN_BERNOULLI 512
+
+void arb_disk_cache_set_path(const char * path);
+
+int _arb_disk_cache_load_arb(arb_t x, long * prec, const char * key, long min_prec);
+void _arb_disk_cache_store_arb(const char * key, const arb_t x, long prec);
+
+long _arb_disk_cache_load_fmpq_vec(fmpq * res, const char * key, long start, long end);
+void _arb_disk_cache_store_fmpq_vec(const char * key, const fmpq * vec, long start, long end);
+
 #define ARB_DEF_CACHED_CONSTANT(name, comp_func) \
-    TLS_PREFIX long name ## _cached_prec = 0; \
-    TLS_PREFIX arb_t name ## _cached_value; \
-    void name ## _cleanup(void) \
-    { \
-        arb_clear(name ## _cached_value); \
-        name ## _cached_prec = 0; \
-    } \
+    arb_const_cache_t name ## _cache = ARB_CONST_CACHE_INITIALIZER(#name); \
     void name(arb_t x, long prec) \
     { \
-        if (name ## _cached_prec < prec) \
-        { \
-            if (name ## _cached_prec == 0) \
-            { \
-                arb_init(name ## _cached_value); \
-                flint_register_cleanup_function(name ## _cleanup); \
-            } \
-            comp_func(name ## _cached_value, prec + 32); \
-            name ## _cached_prec = prec; \
-        } \
-        arb_set_round(x, name ## _cached_value, prec); \
+        arb_const_cache_get(x, name ## _cache, comp_func, prec); \
     }
 
 /* vector functions */
@@ -840,10 +879,7 @@ _arb_vec_scalar_addmul(arb_ptr res, arb_srcptr vec,
 ARB_INLINE void
 _arb_vec_dot(arb_t res, arb_srcptr vec1, arb_srcptr vec2, long len2, long prec)
 {
-    long i;
-    arb_zero(res);
-    for (i = 0; i < len2; i++)
-        arb_addmul(res, vec1 + i, vec2 + i, prec);
+    arb_dot(res, NULL, 0, vec1, 1, vec2, 1, len2, prec);
 }
 
 ARB_INLINE void
@@ -855,27 +891,7 @@ _arb_vec_norm(arb_t res, arb_srcptr vec, long len, long prec)
         arb_addmul(res, vec + i, vec + i, prec);
 }
 
-ARB_INLINE void
-_arb_vec_get_mag(mag_t bound, arb_srcptr vec, long len)
-{
-    if (len < 1)
-    {
-        mag_zero(bound);
-    }
-    else
-    {
-        mag_t t;
-        long i;
-        arb_get_mag(bound, vec);
-        mag_init(t);
-        for (i = 1; i < len; i++)
-        {
-            arb_get_mag(t, vec + i);
-            mag_max(bound, bound, t);
-        }
-        mag_clear(t);
-    }
-}
+void _arb_vec_get_mag(mag_t bound, arb_srcptr vec, long len);
 
 ARB_INLINE long
 _arb_vec_bits(arb_srcptr x, long len)
@@ -918,13 +934,7 @@ _arb_vec_add_error_arf_vec(arb_ptr res, arf_srcptr err, long len)
         arb_add_error_arf(res + i, err + i);
 }
 
-ARB_INLINE void
-_arb_vec_add_error_mag_vec(arb_ptr res, mag_srcptr err, long len)
-{
-    long i;
-    for (i = 0; i < len; i++)
-        mag_add(arb_radref(res + i), arb_radref(res + i), err + i);
-}
+void _arb_vec_add_error_mag_vec(arb_ptr res, mag_srcptr err, long len);
 
 ARB_INLINE void
 _arb_vec_indeterminate(arb_ptr vec, long len)
@@ -952,6 +962,30 @@ _arb_vec_get_unique_fmpz_vec(fmpz * res,  arb_srcptr vec, long len)
     return 1;
 }
 
+/* batch evaluation of elementary functions */
+
+#define ARB_VEC_ELEMENTARY_BATCH 16
+#define ARB_VEC_ELEMENTARY_THREAD_WORK 100000
+
+long _arb_vec_elementary_num_threads(long len, long prec);
+
+void _arb_vec_exp(arb_ptr res, arb_srcptr x, long len, long prec);
+
+void _arb_vec_log(arb_ptr res, arb_srcptr x, long len, long prec);
+
+void _arb_vec_sin_cos(arb_ptr s, arb_ptr c, arb_srcptr x, long len, long prec);
+
+/* batch evaluation of the gamma function */
+
+/* minimum work per thread in _arb_vec_gamma, in limb multiplications */
+#define ARB_VEC_GAMMA_THREAD_WORK 100000
+
+long _arb_vec_gamma_num_threads(long len, long prec, int is_complex);
+
+void _arb_vec_gamma(arb_ptr res, arb_srcptr x, long len, long prec);
+
+void _arb_vec_lgamma(arb_ptr res, arb_srcptr x, long len, long prec);
+
 /* arctangent implementation */
 
 #define ARB_ATAN_TAB1_BITS 8
@@ -1019,6 +1053,9 @@ void _arb_exp_taylor_naive(mp_ptr y, mp_limb_t * error,
 void _arb_exp_taylor_rs(mp_ptr y, mp_limb_t * error,
     mp_srcptr x, mp_size_t xn, ulong N);
 
+void _arb_exp_taylor_rs_vec(mp_ptr y, mp_limb_t * error,
+    mp_srcptr x, mp_size_t xn, ulong N, long len);
+
 void arb_exp_arf_bb(arb_t z, const arf_t x, long prec, int minus_one);
 
 int _arb_get_mpn_fixed_mod_log2(mp_ptr w, fmpz_t q, mp_limb_t * error,
@@ -1062,9 +1099,39 @@ void _arb_sin_cos_taylor_rs(mp_ptr ysin, mp_ptr ycos,
     mp_limb_t * error, mp_srcptr x, mp_size_t xn, ulong N,
     int sinonly, int alternating);
 
+void _arb_sin_cos_taylor_rs_vec(mp_ptr ysin, mp_ptr ycos,
+    mp_limb_t * error, mp_srcptr x, mp_size_t xn, ulong N,
+    int sinonly, int alternating, long len);
+
 int _arb_get_mpn_fixed_mod_pi4(mp_ptr w, fmpz_t q, int * octant,
     mp_limb_t * error, const arf_t x, mp_size_t wn);
 
+/* tables built at runtime for precision beyond the static tables */
+
+#define ARB_TAB2_EXP 0
+#define ARB_TAB2_SIN_COS 1
+#define ARB_TAB2_LOG2 2
+#define ARB_TAB2_PI4 3
+#define ARB_TAB2_NUM_KINDS 4
+
+/* the reduced argument is halved about (prec - 1900) / 280 - 10 times,
+   which at 4 bands (73728 bits) costs some 250 full squarings; see
+   arb/profile/p-exp_tab2.c */
+#define ARB_TAB2_RUNTIME_BANDS 3
+#define ARB_TAB2_RUNTIME_PREC (ARB_EXP_TAB2_PREC << ARB_TAB2_RUNTIME_BANDS)
+#define ARB_TAB2_TAYLOR_TERMS 280
+
+int _arb_tab2_table(mp_srcptr * tab21, mp_srcptr * tab22, mp_size_t * tabn,
+    int kind, mp_size_t n);
+
+mp_srcptr _arb_tab2_const(int kind, mp_size_t n);
+
+void _arb_tab2_clear(void);
+
+long _arb_tab2_halvings(long wp);
+
+void _arb_tab2_halve(mp_ptr w, mp_size_t wn, long h);
+
 ARB_INLINE mp_bitcnt_t
 _arb_mpn_leading_zeros(mp_srcptr d, mp_size_t n)
 {
@@ -24,11 +24,36 @@
 ******************************************************************************/
 
 #include "arb.h"
+#include "arb_thread_pool.h"
+
+/* minimum number of terms per leaf when splitting over threads */
+#define BSPLIT_PARALLEL_CUTOFF 128
 
 long _arb_compute_bs_exponents(long * tab, long n);
 
 long _arb_get_exp_pos(const long * tab, long step);
 
+/* merges [a,m) in (T, Q, Qexp) and [m,b) in (T2, Q2, Q2exp) where
+   step = m - a, destroying T2 */
+static void
+bsplit_merge(fmpz_t T, fmpz_t Q, mp_bitcnt_t * Qexp,
+    fmpz_t T2, const fmpz_t Q2, mp_bitcnt_t Q2exp,
+    const long * xexp, const fmpz * xpow, long step)
+{
+    long i;
+
+    fmpz_mul(T, T, Q2);
+    fmpz_mul_2exp(T, T, Q2exp);
+
+    /* find x^step in table */
+    i = _arb_get_exp_pos(xexp, step);
+    fmpz_mul(T2, T2, Q);
+    fmpz_addmul(T, xpow + i, T2);
+
+    fmpz_mul(Q, Q, Q2);
+    *Qexp = *Qexp + Q2exp;
+}
+
 static void
 bsplit(fmpz_t T, fmpz_t Q, mp_bitcnt_t * Qexp,
     const long * xexp,
@@ -60,7 +85,7 @@ bsplit(fmpz_t T, fmpz_t Q, mp_bitcnt_t * Qexp,
     }
     else
     {
-        long step, m, i;
+        long step, m;
         mp_bitcnt_t Q2exp[1];
         fmpz_t Q2, T2;
 
@@ -73,21 +98,65 @@ bsplit(fmpz_t T, fmpz_t Q, mp_bitcnt_t * Qexp,
         bsplit(T,  Q,  Qexp,  xexp, xpow, r, a, m);
         bsplit(T2, Q2, Q2exp, xexp, xpow, r, m, b);
 
-        fmpz_mul(T, T, Q2);
-        fmpz_mul_2exp(T, T, *Q2exp);
+        bsplit_merge(T, Q, Qexp, T2, Q2, *Q2exp, xexp, xpow, step);
 
-        /* find x^step in table */
-        i = _arb_get_exp_pos(xexp, step);
-        fmpz_mul(T2, T2, Q);
-        fmpz_addmul(T, xpow + i, T2);
         fmpz_clear(T2);
-
-        fmpz_mul(Q, Q, Q2);
-        *Qexp = *Qexp + *Q2exp;
         fmpz_clear(Q2);
     }
 }
 
+typedef struct
+{
+    fmpz_t T;
+    fmpz_t Q;
+    mp_bitcnt_t Qexp;
+}
+bsplit_struct;
+
+typedef struct
+{
+    const long * xexp;
+    const fmpz * xpow;
+    mp_bitcnt_t r;
+}
+bsplit_args_t;
+
+static void
+bsplit_init(void * x)
+{
+    bsplit_struct * s = x;
+    fmpz_init(s->T);
+    fmpz_init(s->Q);
+    s->Qexp = 0;
+}
+
+static void
+bsplit_clear(void * x)
+{
+    bsplit_struct * s = x;
+    fmpz_clear(s->T);
+    fmpz_clear(s->Q);
+}
+
+static void
+bsplit_basecase(void * x, long a, long b, int cont, void * args)
+{
+    bsplit_struct * s = x;
+    bsplit_args_t * arg = args;
+    bsplit(s->T, s->Q, &s->Qexp, arg->xexp, arg->xpow, arg->r, a, b);
+}
+
+static void
+bsplit_merge_task(void * left, void * right, long a, long m, long b,
+    int cont, void * args)
+{
+    bsplit_struct * L = left;
+    bsplit_struct * R = right;
+    bsplit_args_t * arg = args;
+    bsplit_merge(L->T, L->Q, &L->Qexp, R->T, R->Q, R->Qexp,
+        arg->xexp, arg->xpow, m - a);
+}
+
 void
 _arb_atan_sum_bs_powtab(fmpz_t T, fmpz_t Q, mp_bitcnt_t * Qexp,
     const fmpz_t x, mp_bitcnt_t r, long N)
@@ -131,7 +200,24 @@ _arb_atan_sum_bs_powtab(fmpz_t T, fmpz_t Q, mp_bitcnt_t * Qexp,
         }
     }
 
-    bsplit(T, Q, Qexp, xexp, xpow, r, 0, N);
+    {
+        bsplit_struct s;
+        bsplit_args_t args;
+
+        args.xexp = xexp;
+        args.xpow = xpow;
+        args.r = r;
+
+        bsplit_init(&s);
+        arb_thread_pool_bsplit(&s, 0, N, &args, sizeof(bsplit_struct),
+            bsplit_init, bsplit_clear, bsplit_basecase, bsplit_merge_task,
+            BSPLIT_PARALLEL_CUTOFF, flint_get_num_threads());
+
+        fmpz_swap(T, s.T);
+        fmpz_swap(Q, s.Q);
+        *Qexp = s.Qexp;
+        bsplit_clear(&s);
+    }
 
     _fmpz_vec_clear(xpow, length);
     flint_free(xexp);
@@ -24,6 +24,10 @@
 ******************************************************************************/
 
 #include "arb.h"
+#include "arb_thread_pool.h"
+
+/* minimum number of terms per leaf when splitting over threads */
+#define BSPLIT_PARALLEL_CUTOFF 32
 
 static void
 bsplit(arb_t P, arb_t Q, const fmpz_t n, const fmpz_t a, const fmpz_t b, long prec)
@@ -88,6 +92,71 @@ bsplit(arb_t P, arb_t Q, const fmpz_t n, const fmpz_t a, const fmpz_t b, long pr
     fmpz_clear(t);
 }
 
+/* The interval [a + lo, a + hi) is handled as [lo, hi) by the
+   parallel driver; the split points agree with those of bsplit. */
+
+typedef struct
+{
+    arb_t P;
+    arb_t Q;
+}
+bsplit_struct;
+
+typedef struct
+{
+    const fmpz * n;
+    const fmpz * a;
+    long prec;
+}
+bsplit_args_t;
+
+static void
+bsplit_init(void * x)
+{
+    bsplit_struct * s = x;
+    arb_init(s->P);
+    arb_init(s->Q);
+}
+
+static void
+bsplit_clear(void * x)
+{
+    bsplit_struct * s = x;
+    arb_clear(s->P);
+    arb_clear(s->Q);
+}
+
+static void
+bsplit_basecase(void * x, long lo, long hi, int cont, void * args)
+{
+    bsplit_struct * s = x;
+    bsplit_args_t * arg = args;
+    fmpz_t a, b;
+
+    fmpz_init(a);
+    fmpz_init(b);
+    fmpz_add_si(a, arg->a, lo);
+    fmpz_add_si(b, arg->a, hi);
+
+    bsplit(s->P, s->Q, arg->n, a, b, arg->prec);
+
+    fmpz_clear(a);
+    fmpz_clear(b);
+}
+
+static void
+bsplit_merge(void * left, void * right, long a, long m, long b,
+    int cont, void * args)
+{
+    bsplit_struct * L = left;
+    bsplit_struct * R = right;
+    bsplit_args_t * arg = args;
+
+    arb_mul(L->Q, L->Q, R->Q, arg->prec);
+    arb_addmul(R->P, L->P, R->Q, arg->prec);
+    arb_swap(L->P, R->P);
+}
+
 void
 arb_bell_sum_bsplit(arb_t res, const fmpz_t n,
     const fmpz_t a, const fmpz_t b, const fmpz_t mmag, long prec)
@@ -98,29 +167,33 @@ arb_bell_sum_bsplit(arb_t res, const fmpz_t n,
     }
     else
     {
-        long wp;
-        arb_t P, Q;
+        long wp, len;
+        bsplit_struct s;
+        bsplit_args_t args;
 
-        wp = _fmpz_sub_small(b, a);
-        wp = FLINT_BIT_COUNT(FLINT_ABS(wp));
+        len = _fmpz_sub_small(b, a);
+        wp = FLINT_BIT_COUNT(FLINT_ABS(len));
         wp = prec + fmpz_bits(n) + fmpz_bits(a) + wp;
 
-        arb_init(P);
-        arb_init(Q);
+        args.n = n;
+        args.a = a;
+        args.prec = wp;
 
-        bsplit(P, Q, n, a, b, wp);
-        arb_div(res, P, Q, wp);
+        bsplit_init(&s);
+        arb_thread_pool_bsplit(&s, 0, len, &args, sizeof(bsplit_struct),
+            bsplit_init, bsplit_clear, bsplit_basecase, bsplit_merge,
+            BSPLIT_PARALLEL_CUTOFF, flint_get_num_threads());
+        arb_div(res, s.P, s.Q, wp);
 
         if (!fmpz_is_zero(a))
         {
-            arb_gamma_fmpz(P, a, wp);
-            arb_div(res, res, P, wp);
+            arb_gamma_fmpz(s.P, a, wp);
+            arb_div(res, res, s.P, wp);
         }
 
         arb_set_round(res, res, prec);
 
-        arb_clear(P);
-        arb_clear(Q);
+        bsplit_clear(&s);
     }
 }
 
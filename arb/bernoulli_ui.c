@@ -29,7 +29,7 @@
 void
 arb_bernoulli_ui(arb_t b, ulong n, long prec)
 {
-    if (n < bernoulli_cache_num)
+    if (bernoulli_cache_contains(n))
     {
         arb_set_fmpq(b, bernoulli_cache + n, prec);
     }
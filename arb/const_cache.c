@@ -0,0 +1,218 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <pthread.h>
+#include "arb.h"
+
+/*
+    Each cache holds a list of values of increasing precision, the most
+    precise one at the head. A node is never modified after it has been
+    published, so readers only need to load the head pointer and can
+    round from it without locking. Writers hold the lock of the cache.
+    Superseded nodes are kept until the cache is cleared, since a reader
+    may still be using them; as the precision grows geometrically, they
+    take up at most a few times the memory of the head.
+
+    Values of at least ARB_DISK_CACHE_MIN_PREC bits are also looked up
+    in, and written to, the cache file if one has been set with
+    arb_disk_cache_set_path.
+
+    Every thread that reads a constant registers a cleanup function,
+    and the values are only freed when the last such thread has called
+    flint_cleanup(). A worker thread that exits therefore does not take
+    the constants away from the other threads.
+*/
+
+#if defined(__GNUC__)
+#define CACHE_BARRIER() __sync_synchronize()
+#define CACHE_LOCK_FREE 1
+#else
+#define CACHE_BARRIER()
+#define CACHE_LOCK_FREE 0
+#endif
+
+static pthread_mutex_t cache_list_lock = PTHREAD_MUTEX_INITIALIZER;
+static arb_const_cache_struct * cache_list = NULL;
+static long cache_users = 0;
+static TLS_PREFIX int cache_have_registered_cleanup = 0;
+
+static void
+_arb_const_cache_clear_all_locked(void)
+{
+    arb_const_cache_struct * cache, * next;
+    arb_const_cache_node_struct * node, * node_next;
+
+    for (cache = cache_list; cache != NULL; cache = next)
+    {
+        for (node = cache->head; node != NULL; node = node_next)
+        {
+            node_next = node->next;
+            arb_clear(&node->value);
+            flint_free(node);
+        }
+
+        pthread_mutex_destroy(cache->lock);
+        flint_free(cache->lock);
+
+        next = cache->next;
+        cache->head = NULL;
+        cache->lock = NULL;
+        cache->next = NULL;
+    }
+
+    cache_list = NULL;
+}
+
+void
+arb_const_cache_clear_all(void)
+{
+    pthread_mutex_lock(&cache_list_lock);
+    _arb_const_cache_clear_all_locked();
+    pthread_mutex_unlock(&cache_list_lock);
+}
+
+static void
+_arb_const_cache_thread_cleanup(void)
+{
+    pthread_mutex_lock(&cache_list_lock);
+
+    cache_have_registered_cleanup = 0;
+    cache_users--;
+
+    if (cache_users == 0)
+        _arb_const_cache_clear_all_locked();
+
+    pthread_mutex_unlock(&cache_list_lock);
+}
+
+static void
+_arb_const_cache_register_thread(void)
+{
+    pthread_mutex_lock(&cache_list_lock);
+    cache_users++;
+    pthread_mutex_unlock(&cache_list_lock);
+
+    flint_register_cleanup_function(_arb_const_cache_thread_cleanup);
+    cache_have_registered_cleanup = 1;
+}
+
+/* Returns the lock of the cache, creating it on first use. */
+static pthread_mutex_t *
+_arb_const_cache_lock(arb_const_cache_t cache)
+{
+    pthread_mutex_t * lock;
+
+    pthread_mutex_lock(&cache_list_lock);
+
+    if (cache->lock == NULL)
+    {
+        lock = flint_malloc(sizeof(pthread_mutex_t));
+        pthread_mutex_init(lock, NULL);
+        cache->lock = lock;
+        cache->next = cache_list;
+        cache_list = cache;
+    }
+
+    lock = cache->lock;
+
+    pthread_mutex_unlock(&cache_list_lock);
+
+    return lock;
+}
+
+void
+arb_const_cache_get(arb_t x, arb_const_cache_t cache,
+    arb_const_cache_eval_t comp_func, long prec)
+{
+    arb_const_cache_node_struct * node, * new_node;
+    pthread_mutex_t * lock;
+
+    if (!cache_have_registered_cleanup)
+        _arb_const_cache_register_thread();
+
+#if CACHE_LOCK_FREE
+    node = cache->head;
+    CACHE_BARRIER();
+
+    if (node != NULL && node->prec >= prec)
+    {
+        arb_set_round(x, &node->value, prec);
+        return;
+    }
+#endif
+
+    lock = _arb_const_cache_lock(cache);
+    pthread_mutex_lock(lock);
+
+    node = cache->head;
+
+    if (node == NULL || node->prec < prec)
+    {
+        /* the cached value must not live in the arena of this thread */
+        arf_arena_suspend();
+
+        new_node = flint_malloc(sizeof(arb_const_cache_node_struct));
+        arb_init(&new_node->value);
+
+        if (node == NULL)
+            new_node->prec = prec;
+        else
+            new_node->prec = FLINT_MAX(prec, node->prec + node->prec / 4);
+
+        if (cache->name == NULL || new_node->prec < ARB_DISK_CACHE_MIN_PREC ||
+            !_arb_disk_cache_load_arb(&new_node->value, &new_node->prec,
+                cache->name, new_node->prec))
+        {
+            comp_func(&new_node->value, new_node->prec + 32);
+
+            if (cache->name != NULL &&
+                new_node->prec >= ARB_DISK_CACHE_MIN_PREC)
+                _arb_disk_cache_store_arb(cache->name, &new_node->value,
+                    new_node->prec);
+        }
+
+        new_node->next = node;
+
+        arf_arena_resume();
+
+        CACHE_BARRIER();
+        cache->head = new_node;
+        node = new_node;
+    }
+
+    arb_set_round(x, &node->value, prec);
+
+    pthread_mutex_unlock(lock);
+}
+
+long
+arb_const_cache_prec(const arb_const_cache_t cache)
+{
+    arb_const_cache_node_struct * node;
+
+    node = cache->head;
+
+    return (node == NULL) ? 0 : node->prec;
+}
@@ -25,6 +25,10 @@
 
 #include "arb.h"
 #include "hypgeom.h"
+#include "arb_thread_pool.h"
+
+/* minimum number of terms per leaf when splitting over threads */
+#define EULER_BSPLIT_PARALLEL_CUTOFF 256
 
 typedef struct
 {
@@ -128,6 +132,28 @@ euler_bsplit_1(euler_bsplit_t s, long n1, long n2, long N, long wp, int cont)
     }
 }
 
+typedef struct
+{
+    arb_t P;
+    arb_t Q;
+    arb_t T;
+}
+euler_bsplit_2_struct;
+
+static void
+euler_bsplit_2_merge(arb_t P, arb_t Q, arb_t T, arb_t P2, arb_t Q2, arb_t T2,
+    long wp, int cont)
+{
+    arb_mul(T, T, Q2, wp);
+    arb_mul(T2, T2, P, wp);
+    arb_add(T, T, T2, wp);
+
+    if (cont)
+        arb_mul(P, P, P2, wp);
+
+    arb_mul(Q, Q, Q2, wp);
+}
+
 static void
 euler_bsplit_2(arb_t P, arb_t Q, arb_t T, long n1, long n2,
                         long N, long wp, int cont)
@@ -163,15 +189,7 @@ euler_bsplit_2(arb_t P, arb_t Q, arb_t T, long n1, long n2,
 
         euler_bsplit_2(P, Q, T, n1, m, N, wp, 1);
         euler_bsplit_2(P2, Q2, T2, m, n2, N, wp, 1);
-
-        arb_mul(T, T, Q2, wp);
-        arb_mul(T2, T2, P, wp);
-        arb_add(T, T, T2, wp);
-
-        if (cont)
-            arb_mul(P, P, P2, wp);
-
-        arb_mul(Q, Q, Q2, wp);
+        euler_bsplit_2_merge(P, Q, T, P2, Q2, T2, wp, cont);
 
         arb_clear(P2);
         arb_clear(Q2);
@@ -179,6 +197,89 @@ euler_bsplit_2(arb_t P, arb_t Q, arb_t T, long n1, long n2,
     }
 }
 
+/* callbacks for splitting the two series over threads */
+
+typedef struct
+{
+    long N;
+    long wp;
+}
+euler_bsplit_args_t;
+
+static void
+euler_bsplit_1_init(void * x)
+{
+    euler_bsplit_init(x);
+}
+
+static void
+euler_bsplit_1_clear(void * x)
+{
+    euler_bsplit_clear(x);
+}
+
+static void
+euler_bsplit_1_basecase(void * x, long a, long b, int cont, void * args)
+{
+    euler_bsplit_args_t * arg = args;
+    euler_bsplit_1(x, a, b, arg->N, arg->wp, cont);
+}
+
+static void
+euler_bsplit_1_merge_task(void * left, void * right, long a, long m, long b,
+    int cont, void * args)
+{
+    euler_bsplit_args_t * arg = args;
+    euler_bsplit_struct * L = left;
+    euler_bsplit_struct tmp;
+
+    /* the merge does not allow aliasing */
+    tmp = *L;
+    euler_bsplit_init(L);
+    euler_bsplit_1_merge(L, &tmp, right, arg->wp, cont);
+    euler_bsplit_clear(&tmp);
+}
+
+static void
+euler_bsplit_2_init(void * x)
+{
+    euler_bsplit_2_struct * s = x;
+
+    arb_init(s->P);
+    arb_init(s->Q);
+    arb_init(s->T);
+}
+
+static void
+euler_bsplit_2_clear(void * x)
+{
+    euler_bsplit_2_struct * s = x;
+
+    arb_clear(s->P);
+    arb_clear(s->Q);
+    arb_clear(s->T);
+}
+
+static void
+euler_bsplit_2_basecase(void * x, long a, long b, int cont, void * args)
+{
+    euler_bsplit_2_struct * s = x;
+    euler_bsplit_args_t * arg = args;
+
+    euler_bsplit_2(s->P, s->Q, s->T, a, b, arg->N, arg->wp, cont);
+}
+
+static void
+euler_bsplit_2_merge_task(void * left, void * right, long a, long m, long b,
+    int cont, void * args)
+{
+    euler_bsplit_2_struct * L = left;
+    euler_bsplit_2_struct * R = right;
+    euler_bsplit_args_t * arg = args;
+
+    euler_bsplit_2_merge(L->P, L->Q, L->T, R->P, R->Q, R->T, arg->wp, cont);
+}
+
 static void
 atanh_bsplit(arb_t s, ulong c, long a, long prec)
 {
@@ -250,6 +351,8 @@ void
 arb_const_euler_eval(arb_t res, long prec)
 {
     euler_bsplit_t sum;
+    euler_bsplit_2_struct sum2;
+    euler_bsplit_args_t args;
     arb_t t, u, v, P2, T2, Q2;
     long bits, wp, wp2, n, N, M;
 
@@ -295,7 +398,12 @@ arb_const_euler_eval(arb_t res, long prec)
     arb_init(v);
 
     /* Compute S0 = V / (Q D), I0 = 1 + T / Q */
-    euler_bsplit_1(sum, 0, N, n, wp, 0);
+    args.N = n;
+    args.wp = wp;
+    arb_thread_pool_bsplit(sum, 0, N, &args, sizeof(euler_bsplit_struct),
+        euler_bsplit_1_init, euler_bsplit_1_clear,
+        euler_bsplit_1_basecase, euler_bsplit_1_merge_task,
+        EULER_BSPLIT_PARALLEL_CUTOFF, flint_get_num_threads());
 
     /* I0 = T / Q */
     arb_add(sum->T, sum->T, sum->Q, wp);
@@ -305,7 +413,16 @@ arb_const_euler_eval(arb_t res, long prec)
     arb_div(res, sum->V, t, wp);
 
     /* Compute K0 (actually I_0(2n) K_0(2n)) = T2 / Q2 */
-    euler_bsplit_2(P2, Q2, T2, 0, M, n, wp2, 0);
+    args.wp = wp2;
+    euler_bsplit_2_init(&sum2);
+    arb_thread_pool_bsplit(&sum2, 0, M, &args, sizeof(euler_bsplit_2_struct),
+        euler_bsplit_2_init, euler_bsplit_2_clear,
+        euler_bsplit_2_basecase, euler_bsplit_2_merge_task,
+        EULER_BSPLIT_PARALLEL_CUTOFF, flint_get_num_threads());
+    arb_swap(P2, sum2.P);
+    arb_swap(Q2, sum2.Q);
+    arb_swap(T2, sum2.T);
+    euler_bsplit_2_clear(&sum2);
 
     /* Compute K0 / I^2 = Q^2 * T2 / (Q2 * T^2) */
     arb_set_round(t, sum->Q, wp2);
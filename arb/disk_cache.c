@@ -0,0 +1,728 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "arb.h"
+
+/*
+    The cache file starts with a header consisting of the magic string
+    "ARBCACHE" followed by three limbs: the format version, FLINT_BITS
+    and an endianness marker. A file written on a machine with a
+    different word size or byte order is never read or modified.
+
+    The header is followed by records, each consisting of a key of
+    ARB_DISK_CACHE_KEY_LEN bytes, five limbs (kind, start, prec,
+    payload length in limbs, checksum) and the payload. Records are
+    only ever appended, so a constant computed to a higher precision
+    (or more Bernoulli numbers) extends the file in place; old records
+    stay valid. Integers in the payload are stored as a signed limb
+    count followed by the absolute value.
+
+    An arb_t record holds the midpoint and radius as pairs of integers
+    (mantissa, exponent), with start = 0. A vector record holds the
+    entries with index start <= i < prec, each as numerator and
+    denominator.
+
+    The file is scanned the first time it is used, building an index of
+    the records; payloads are only read when they are needed, and are
+    checked against the checksum before being used. A scan stops at the
+    first truncated record, and nothing is appended to a file with a
+    truncated record. Writing to the same file from several processes
+    at the same time is not supported.
+*/
+
+#define DISK_MAGIC "ARBCACHE"
+#define DISK_ENDIAN_MARKER ((ulong) 0x01020304UL)
+#define DISK_HEADER_LIMBS 3
+#define DISK_RECORD_LIMBS 5
+
+#define DISK_KIND_ARB 0
+#define DISK_KIND_FMPQ_VEC 1
+
+#if FLINT_BITS == 64
+#define DISK_HASH_INIT UWORD(0xcbf29ce484222325)
+#define DISK_HASH_MUL UWORD(0x100000001b3)
+#else
+#define DISK_HASH_INIT UWORD(0x811c9dc5)
+#define DISK_HASH_MUL UWORD(0x01000193)
+#endif
+
+typedef struct
+{
+    char key[ARB_DISK_CACHE_KEY_LEN];
+    ulong kind;
+    ulong start;
+    ulong prec;
+    ulong len;
+    ulong checksum;
+    long offset;
+}
+disk_entry_struct;
+
+typedef struct
+{
+    mp_ptr d;
+    ulong len;
+    ulong alloc;
+}
+disk_buf_struct;
+
+static pthread_mutex_t disk_lock = PTHREAD_MUTEX_INITIALIZER;
+static char * disk_path = NULL;
+static int disk_scanned = 0;
+static int disk_foreign = 0;
+static int disk_readonly = 0;
+static disk_entry_struct * disk_entries = NULL;
+static long disk_num = 0;
+static long disk_alloc = 0;
+
+static ulong
+_disk_checksum(const disk_entry_struct * e, mp_srcptr data)
+{
+    ulong h, i;
+
+    h = DISK_HASH_INIT;
+
+    for (i = 0; i < ARB_DISK_CACHE_KEY_LEN; i++)
+        h = (h ^ (unsigned char) e->key[i]) * DISK_HASH_MUL;
+
+    h = (h ^ e->kind) * DISK_HASH_MUL;
+    h = (h ^ e->start) * DISK_HASH_MUL;
+    h = (h ^ e->prec) * DISK_HASH_MUL;
+    h = (h ^ e->len) * DISK_HASH_MUL;
+
+    for (i = 0; i < e->len; i++)
+        h = (h ^ data[i]) * DISK_HASH_MUL;
+
+    return h;
+}
+
+static void
+_disk_index_clear(void)
+{
+    flint_free(disk_entries);
+    disk_entries = NULL;
+    disk_num = disk_alloc = 0;
+    disk_scanned = 0;
+    disk_foreign = 0;
+    disk_readonly = 0;
+}
+
+static void
+_disk_index_append(const disk_entry_struct * e)
+{
+    if (disk_num == disk_alloc)
+    {
+        disk_alloc = FLINT_MAX(16, 2 * disk_alloc);
+        disk_entries = flint_realloc(disk_entries,
+            sizeof(disk_entry_struct) * disk_alloc);
+    }
+
+    disk_entries[disk_num++] = *e;
+}
+
+static int
+_disk_read_header(FILE * fp)
+{
+    char magic[8];
+    ulong h[DISK_HEADER_LIMBS];
+
+    if (fread(magic, 1, 8, fp) != 8 ||
+        fread(h, sizeof(ulong), DISK_HEADER_LIMBS, fp) != DISK_HEADER_LIMBS)
+        return 0;
+
+    return memcmp(magic, DISK_MAGIC, 8) == 0 &&
+        h[0] == ARB_DISK_CACHE_VERSION &&
+        h[1] == FLINT_BITS &&
+        h[2] == DISK_ENDIAN_MARKER;
+}
+
+static void
+_disk_scan(void)
+{
+    disk_entry_struct e;
+    ulong h[DISK_RECORD_LIMBS];
+    long size, end;
+    FILE * fp;
+
+    disk_scanned = 1;
+
+    fp = fopen(disk_path, "rb");
+
+    if (fp == NULL)
+        return;
+
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+
+    if (size <= 0)
+    {
+        fclose(fp);
+        return;
+    }
+
+    rewind(fp);
+
+    if (!_disk_read_header(fp))
+    {
+        disk_foreign = 1;
+        fclose(fp);
+        return;
+    }
+
+    end = ftell(fp);
+
+    while (fread(e.key, 1, ARB_DISK_CACHE_KEY_LEN, fp) ==
+            ARB_DISK_CACHE_KEY_LEN &&
+        fread(h, sizeof(ulong), DISK_RECORD_LIMBS, fp) == DISK_RECORD_LIMBS)
+    {
+        e.kind = h[0];
+        e.start = h[1];
+        e.prec = h[2];
+        e.len = h[3];
+        e.checksum = h[4];
+        e.offset = ftell(fp);
+
+        if (e.len > (ulong) (size - e.offset) / sizeof(ulong) ||
+            fseek(fp, e.len * sizeof(ulong), SEEK_CUR) != 0)
+            break;
+
+        _disk_index_append(&e);
+        end = e.offset + e.len * sizeof(ulong);
+    }
+
+    /* appending after a truncated record would make the new
+       records unreachable */
+    if (end != size)
+        disk_readonly = 1;
+
+    fclose(fp);
+}
+
+/* Reads and verifies the payload of an entry; returns NULL on failure. */
+static mp_ptr
+_disk_read_payload(const disk_entry_struct * e)
+{
+    FILE * fp;
+    mp_ptr data;
+    int ok;
+
+    fp = fopen(disk_path, "rb");
+
+    if (fp == NULL)
+        return NULL;
+
+    data = flint_malloc(sizeof(ulong) * FLINT_MAX(e->len, 1));
+
+    ok = (fseek(fp, e->offset, SEEK_SET) == 0) &&
+        (fread(data, sizeof(ulong), e->len, fp) == e->len) &&
+        (_disk_checksum(e, data) == e->checksum);
+
+    fclose(fp);
+
+    if (!ok)
+    {
+        flint_free(data);
+        return NULL;
+    }
+
+    return data;
+}
+
+/* Appends a record. If any part of it cannot be written, the partial
+   record is truncated away and nothing more is written to the file
+   during this session. */
+static void
+_disk_write(disk_entry_struct * e, mp_srcptr data)
+{
+    ulong h[DISK_RECORD_LIMBS];
+    long old;
+    FILE * fp;
+    int ok;
+
+    if (disk_readonly)
+        return;
+
+    fp = fopen(disk_path, "ab");
+
+    if (fp == NULL)
+        return;
+
+    /* write directly, so that a failed write can be undone */
+    setvbuf(fp, NULL, _IONBF, 0);
+
+    fseek(fp, 0, SEEK_END);
+    old = ftell(fp);
+
+    if (old < 0)
+    {
+        disk_readonly = 1;
+        fclose(fp);
+        return;
+    }
+
+    ok = 1;
+
+    if (old == 0)
+    {
+        h[0] = ARB_DISK_CACHE_VERSION;
+        h[1] = FLINT_BITS;
+        h[2] = DISK_ENDIAN_MARKER;
+        ok = (fwrite(DISK_MAGIC, 1, 8, fp) == 8) &&
+            (fwrite(h, sizeof(ulong), DISK_HEADER_LIMBS, fp) ==
+                DISK_HEADER_LIMBS);
+    }
+
+    e->checksum = _disk_checksum(e, data);
+
+    h[0] = e->kind;
+    h[1] = e->start;
+    h[2] = e->prec;
+    h[3] = e->len;
+    h[4] = e->checksum;
+
+    e->offset = ftell(fp) + ARB_DISK_CACHE_KEY_LEN +
+        DISK_RECORD_LIMBS * sizeof(ulong);
+
+    ok = ok &&
+        (fwrite(e->key, 1, ARB_DISK_CACHE_KEY_LEN, fp) ==
+            ARB_DISK_CACHE_KEY_LEN) &&
+        (fwrite(h, sizeof(ulong), DISK_RECORD_LIMBS, fp) ==
+            DISK_RECORD_LIMBS) &&
+        (fwrite(data, sizeof(ulong), e->len, fp) == e->len);
+
+    if (!ok)
+    {
+        /* remove the partial record, which would end every later scan
+           of the file (the stream is unbuffered, so nothing is written
+           after this); if that fails too, the next scan finds it and
+           leaves the file read-only */
+        if (ftruncate(fileno(fp), old) != 0)
+            disk_readonly = 1;
+    }
+
+    ok = (fclose(fp) == 0) && ok;
+
+    if (ok)
+        _disk_index_append(e);
+    else
+        disk_readonly = 1;
+}
+
+/* Returns nonzero if the cache is enabled and usable; must be
+   called with the lock held. */
+static int
+_disk_ready(void)
+{
+    if (disk_path == NULL)
+        return 0;
+
+    if (!disk_scanned)
+        _disk_scan();
+
+    return !disk_foreign;
+}
+
+static int
+_disk_set_key(char * key, const char * name)
+{
+    size_t n = strlen(name);
+
+    if (n >= ARB_DISK_CACHE_KEY_LEN)
+        return 0;
+
+    memset(key, 0, ARB_DISK_CACHE_KEY_LEN);
+    memcpy(key, name, n);
+    return 1;
+}
+
+static void
+_disk_buf_push(disk_buf_struct * buf, ulong x)
+{
+    if (buf->len == buf->alloc)
+    {
+        buf->alloc = FLINT_MAX(16, 2 * buf->alloc);
+        buf->d = flint_realloc(buf->d, sizeof(ulong) * buf->alloc);
+    }
+
+    buf->d[buf->len++] = x;
+}
+
+static void
+_disk_buf_push_fmpz(disk_buf_struct * buf, const fmpz_t x)
+{
+    if (!COEFF_IS_MPZ(*x))
+    {
+        if (*x == 0)
+        {
+            _disk_buf_push(buf, 0);
+        }
+        else
+        {
+            _disk_buf_push(buf, (*x < 0) ? -(ulong) 1 : 1);
+            _disk_buf_push(buf, FLINT_ABS(*x));
+        }
+    }
+    else
+    {
+        __mpz_struct * z = COEFF_TO_PTR(*x);
+        long i, n = FLINT_ABS(z->_mp_size);
+
+        _disk_buf_push(buf, (z->_mp_size < 0) ? -(ulong) n : n);
+
+        for (i = 0; i < n; i++)
+            _disk_buf_push(buf, z->_mp_d[i]);
+    }
+}
+
+/* Reads an integer at position *pos of {data, len}; returns success. */
+static int
+_disk_get_fmpz(fmpz_t x, mp_srcptr data, ulong len, ulong * pos)
+{
+    __mpz_struct z;
+    ulong u, n;
+
+    if (*pos >= len)
+        return 0;
+
+    u = data[*pos];
+    (*pos)++;
+
+    /* the signed limb count comes from the file, so its absolute
+       value is computed without overflow and checked against the
+       remaining length before anything is read */
+    n = ((long) u < 0) ? -u : u;
+
+    if (n > len - *pos || n > INT_MAX)
+        return 0;
+
+    if (n == 0)
+    {
+        fmpz_zero(x);
+        return 1;
+    }
+
+    z._mp_d = (mp_ptr) data + *pos;
+    z._mp_size = ((long) u < 0) ? -(int) n : (int) n;
+    z._mp_alloc = n;
+
+    /* the top limb must be nonzero */
+    if (z._mp_d[n - 1] == 0)
+        return 0;
+
+    fmpz_set_mpz(x, &z);
+    *pos += n;
+    return 1;
+}
+
+void
+arb_disk_cache_set_path(const char * path)
+{
+    pthread_mutex_lock(&disk_lock);
+
+    _disk_index_clear();
+    flint_free(disk_path);
+    disk_path = NULL;
+
+    if (path != NULL)
+    {
+        disk_path = flint_malloc(strlen(path) + 1);
+        strcpy(disk_path, path);
+    }
+
+    pthread_mutex_unlock(&disk_lock);
+}
+
+int
+_arb_disk_cache_load_arb(arb_t x, long * prec, const char * key, long min_prec)
+{
+    char k[ARB_DISK_CACHE_KEY_LEN];
+    fmpz_t m, e, rm, re;
+    arf_t r;
+    mp_ptr data;
+    ulong pos;
+    long i, best;
+    int success = 0;
+
+    pthread_mutex_lock(&disk_lock);
+
+    if (!_disk_ready() || !_disk_set_key(k, key))
+    {
+        pthread_mutex_unlock(&disk_lock);
+        return 0;
+    }
+
+    /* use the least precise record which is precise enough */
+    best = -1;
+    for (i = 0; i < disk_num; i++)
+    {
+        if (disk_entries[i].kind == DISK_KIND_ARB &&
+            memcmp(disk_entries[i].key, k, ARB_DISK_CACHE_KEY_LEN) == 0 &&
+            disk_entries[i].prec >= (ulong) min_prec &&
+            disk_entries[i].prec <= (ulong) WORD_MAX &&
+            (best == -1 || disk_entries[i].prec < disk_entries[best].prec))
+            best = i;
+    }
+
+    data = (best == -1) ? NULL : _disk_read_payload(disk_entries + best);
+
+    if (data != NULL)
+    {
+        fmpz_init(m);
+        fmpz_init(e);
+        fmpz_init(rm);
+        fmpz_init(re);
+        arf_init(r);
+
+        pos = 0;
+
+        if (_disk_get_fmpz(m, data, disk_entries[best].len, &pos) &&
+            _disk_get_fmpz(e, data, disk_entries[best].len, &pos) &&
+            _disk_get_fmpz(rm, data, disk_entries[best].len, &pos) &&
+            _disk_get_fmpz(re, data, disk_entries[best].len, &pos) &&
+            fmpz_sgn(rm) >= 0)
+        {
+            arf_set_fmpz_2exp(arb_midref(x), m, e);
+            arf_set_fmpz_2exp(r, rm, re);
+            arf_get_mag(arb_radref(x), r);
+            *prec = disk_entries[best].prec;
+            success = 1;
+        }
+
+        fmpz_clear(m);
+        fmpz_clear(e);
+        fmpz_clear(rm);
+        fmpz_clear(re);
+        arf_clear(r);
+        flint_free(data);
+    }
+
+    pthread_mutex_unlock(&disk_lock);
+
+    return success;
+}
+
+void
+_arb_disk_cache_store_arb(const char * key, const arb_t x, long prec)
+{
+    disk_entry_struct ent;
+    disk_buf_struct buf;
+    fmpz_t m, e;
+    arf_t r;
+    long i;
+
+    if (!arb_is_finite(x))
+        return;
+
+    pthread_mutex_lock(&disk_lock);
+
+    if (!_disk_ready() || !_disk_set_key(ent.key, key))
+    {
+        pthread_mutex_unlock(&disk_lock);
+        return;
+    }
+
+    for (i = 0; i < disk_num; i++)
+    {
+        if (disk_entries[i].kind == DISK_KIND_ARB &&
+            memcmp(disk_entries[i].key, ent.key, ARB_DISK_CACHE_KEY_LEN) == 0
+            && disk_entries[i].prec >= (ulong) prec)
+        {
+            pthread_mutex_unlock(&disk_lock);
+            return;
+        }
+    }
+
+    fmpz_init(m);
+    fmpz_init(e);
+    arf_init(r);
+    buf.d = NULL;
+    buf.len = buf.alloc = 0;
+
+    arf_get_fmpz_2exp(m, e, arb_midref(x));
+    _disk_buf_push_fmpz(&buf, m);
+    _disk_buf_push_fmpz(&buf, e);
+
+    arf_set_mag(r, arb_radref(x));
+    arf_get_fmpz_2exp(m, e, r);
+    _disk_buf_push_fmpz(&buf, m);
+    _disk_buf_push_fmpz(&buf, e);
+
+    ent.kind = DISK_KIND_ARB;
+    ent.start = 0;
+    ent.prec = prec;
+    ent.len = buf.len;
+
+    _disk_write(&ent, buf.d);
+
+    fmpz_clear(m);
+    fmpz_clear(e);
+    arf_clear(r);
+    flint_free(buf.d);
+
+    pthread_mutex_unlock(&disk_lock);
+}
+
+long
+_arb_disk_cache_load_fmpq_vec(fmpq * res, const char * key, long start, long end)
+{
+    char k[ARB_DISK_CACHE_KEY_LEN];
+    disk_entry_struct * ent;
+    mp_ptr data;
+    fmpz_t num, den;
+    ulong pos;
+    long i, j, best, cur;
+    int ok;
+
+    cur = start;
+
+    pthread_mutex_lock(&disk_lock);
+
+    if (!_disk_ready() || !_disk_set_key(k, key))
+    {
+        pthread_mutex_unlock(&disk_lock);
+        return cur;
+    }
+
+    fmpz_init(num);
+    fmpz_init(den);
+
+    while (cur < end)
+    {
+        /* the record covering cur which reaches the furthest */
+        best = -1;
+        for (i = 0; i < disk_num; i++)
+        {
+            ent = disk_entries + i;
+
+            if (ent->kind == DISK_KIND_FMPQ_VEC &&
+                memcmp(ent->key, k, ARB_DISK_CACHE_KEY_LEN) == 0 &&
+                ent->start <= (ulong) cur && ent->prec > (ulong) cur &&
+                ent->prec <= (ulong) WORD_MAX &&
+                (best == -1 || ent->prec > disk_entries[best].prec))
+                best = i;
+        }
+
+        if (best == -1)
+            break;
+
+        ent = disk_entries + best;
+        data = _disk_read_payload(ent);
+
+        if (data == NULL)
+        {
+            /* do not try this record again */
+            ent->kind = ~(ulong) 0;
+            continue;
+        }
+
+        pos = 0;
+        ok = 1;
+
+        for (j = ent->start; j < (long) ent->prec && j < end && ok; j++)
+        {
+            ok = _disk_get_fmpz(num, data, ent->len, &pos) &&
+                 _disk_get_fmpz(den, data, ent->len, &pos) &&
+                 fmpz_sgn(den) > 0;
+
+            if (ok && j >= cur)
+            {
+                fmpz_swap(fmpq_numref(res + j - start), num);
+                fmpz_swap(fmpq_denref(res + j - start), den);
+                cur = j + 1;
+            }
+        }
+
+        flint_free(data);
+
+        if (!ok)
+        {
+            ent->kind = ~(ulong) 0;
+            break;
+        }
+    }
+
+    fmpz_clear(num);
+    fmpz_clear(den);
+
+    pthread_mutex_unlock(&disk_lock);
+
+    return cur;
+}
+
+void
+_arb_disk_cache_store_fmpq_vec(const char * key, const fmpq * vec, long start, long end)
+{
+    disk_entry_struct ent;
+    disk_buf_struct buf;
+    long i;
+
+    if (start >= end)
+        return;
+
+    pthread_mutex_lock(&disk_lock);
+
+    if (!_disk_ready() || !_disk_set_key(ent.key, key))
+    {
+        pthread_mutex_unlock(&disk_lock);
+        return;
+    }
+
+    for (i = 0; i < disk_num; i++)
+    {
+        if (disk_entries[i].kind == DISK_KIND_FMPQ_VEC &&
+            memcmp(disk_entries[i].key, ent.key, ARB_DISK_CACHE_KEY_LEN) == 0
+            && disk_entries[i].start <= (ulong) start
+            && disk_entries[i].prec >= (ulong) end)
+        {
+            pthread_mutex_unlock(&disk_lock);
+            return;
+        }
+    }
+
+    buf.d = NULL;
+    buf.len = buf.alloc = 0;
+
+    for (i = 0; i < end - start; i++)
+    {
+        _disk_buf_push_fmpz(&buf, fmpq_numref(vec + i));
+        _disk_buf_push_fmpz(&buf, fmpq_denref(vec + i));
+    }
+
+    ent.kind = DISK_KIND_FMPQ_VEC;
+    ent.start = start;
+    ent.prec = end;
+    ent.len = buf.len;
+
+    _disk_write(&ent, buf.d);
+
+    flint_free(buf.d);
+
+    pthread_mutex_unlock(&disk_lock);
+}
@@ -0,0 +1,369 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+
+/*
+    The midpoints are summed exactly in a two's complement accumulator
+    of wn limbs, representing acc * 2^bot where bot = top - wn * FLINT_BITS.
+    The top of the accumulator leaves room for carries, so the sum never
+    wraps around. Bits of a term falling below bot are truncated; each
+    truncated term adds at most 2 * 2^bot to the error (counting the error
+    from truncating overlong input mantissas to wn + 1 limbs).
+*/
+
+/* Adds or subtracts {t, tn} * 2^shift to the accumulator; returns
+   nonzero if any nonzero bits had to be discarded. Destroys t. */
+static int
+_arb_dot_add_mpn(mp_ptr acc, mp_size_t wn, mp_ptr t, mp_size_t tn,
+    long shift, int negative)
+{
+    mp_size_t off, i;
+    int inexact = 0;
+    long bits;
+
+    if (shift >= 0)
+    {
+        off = shift / FLINT_BITS;
+        bits = shift % FLINT_BITS;
+
+        if (bits != 0)
+        {
+            t[tn] = mpn_lshift(t, t, tn, bits);
+            tn++;
+        }
+    }
+    else
+    {
+        off = (-shift) / FLINT_BITS;
+        bits = (-shift) % FLINT_BITS;
+
+        if (off >= tn)
+            return 1;
+
+        for (i = 0; i < off && !inexact; i++)
+            inexact = (t[i] != 0);
+
+        if (bits != 0)
+        {
+            inexact |= ((t[off] << (FLINT_BITS - bits)) != 0);
+            mpn_rshift(t, t + off, tn - off, bits);
+        }
+        else if (off != 0)
+        {
+            flint_mpn_copyi(t, t + off, tn - off);
+        }
+
+        tn -= off;
+        off = 0;
+    }
+
+    /* The value fits; only leading zero limbs can stick out. */
+    while (tn > 0 && t[tn - 1] == 0)
+        tn--;
+
+    if (tn == 0)
+        return inexact;
+
+    if (negative)
+        mpn_sub(acc + off, acc + off, wn - off, t, tn);
+    else
+        mpn_add(acc + off, acc + off, wn - off, t, tn);
+
+    return inexact;
+}
+
+void
+arb_dot_simple(arb_t res, const arb_t initial, int subtract,
+    arb_srcptr x, long xstep, arb_srcptr y, long ystep, long len, long prec)
+{
+    arb_t t;
+    long i;
+
+    arb_init(t);
+
+    if (initial == NULL)
+        arb_zero(t);
+    else if (subtract)
+        arb_neg(t, initial);
+    else
+        arb_set(t, initial);
+
+    for (i = 0; i < len; i++)
+        arb_addmul(t, x + i * xstep, y + i * ystep, prec);
+
+    if (subtract)
+        arb_neg(t, t);
+
+    if (len == 0)
+        arb_set_round(res, t, prec);
+    else
+        arb_swap(res, t);
+
+    arb_clear(t);
+}
+
+void
+arb_dot(arb_t res, const arb_t initial, int subtract,
+    arb_srcptr x, long xstep, arb_srcptr y, long ystep, long len, long prec)
+{
+    arb_srcptr xi, yi;
+    arf_srcptr xm, ym;
+    mag_srcptr xr, yr;
+    mp_srcptr xp, yp;
+    mp_size_t xn, yn, tn, wn, an;
+    mp_ptr acc, t;
+    long i, e, top, bot, max_exp, min_lsb, pad, shift, fix, truncated, wp;
+    int have_mid, negative, inexact;
+    mag_t rad, u;
+    arf_t s;
+    TMP_INIT;
+
+    if (len <= 0)
+    {
+        arb_dot_simple(res, initial, subtract, x, xstep, y, ystep, len, prec);
+        return;
+    }
+
+    /* First pass: check exponents, find the range of the midpoint
+       products, and bound the propagated error. */
+    mag_init(rad);
+    have_mid = 0;
+    max_exp = min_lsb = 0;
+
+    if (initial != NULL)
+    {
+        xm = arb_midref(initial);
+        xr = arb_radref(initial);
+
+        if (!ARF_IS_LAGOM(xm) || !MAG_IS_LAGOM(xr))
+            goto fallback;
+
+        if (!arf_is_zero(xm))
+        {
+            ARF_GET_MPN_READONLY(xp, xn, xm);
+            max_exp = ARF_EXP(xm);
+            min_lsb = max_exp - xn * FLINT_BITS;
+            have_mid = 1;
+        }
+
+        mag_fast_init_set(rad, xr);
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        xi = x + i * xstep;
+        yi = y + i * ystep;
+        xm = arb_midref(xi);
+        ym = arb_midref(yi);
+        xr = arb_radref(xi);
+        yr = arb_radref(yi);
+
+        if (!ARF_IS_LAGOM(xm) || !ARF_IS_LAGOM(ym) ||
+            !MAG_IS_LAGOM(xr) || !MAG_IS_LAGOM(yr))
+            goto fallback;
+
+        if (!arf_is_zero(xm) && !arf_is_zero(ym))
+        {
+            ARF_GET_MPN_READONLY(xp, xn, xm);
+            ARF_GET_MPN_READONLY(yp, yn, ym);
+
+            e = ARF_EXP(xm) + ARF_EXP(ym);
+
+            if (!have_mid)
+            {
+                max_exp = e;
+                min_lsb = e - (xn + yn) * FLINT_BITS;
+                have_mid = 1;
+            }
+            else
+            {
+                max_exp = FLINT_MAX(max_exp, e);
+                min_lsb = FLINT_MIN(min_lsb, e - (xn + yn) * FLINT_BITS);
+            }
+        }
+
+        /* |x| y_rad + |y| x_rad + x_rad y_rad */
+        if (!mag_fast_is_zero(yr))
+        {
+            mag_fast_init_set_arf(u, xm);
+            mag_fast_addmul(rad, u, yr);
+        }
+
+        if (!mag_fast_is_zero(xr))
+        {
+            mag_fast_init_set_arf(u, ym);
+            mag_fast_addmul(rad, u, xr);
+            mag_fast_addmul(rad, xr, yr);
+        }
+    }
+
+    arf_init(s);
+    inexact = 0;
+
+    if (have_mid)
+    {
+        /* The sum of len + 1 terms bounded by 2^max_exp, plus a sign bit. */
+        pad = FLINT_BIT_COUNT(len + 1) + 1;
+        top = max_exp + pad;
+
+        /* Clamp the precision (which may be ARF_PREC_EXACT) before
+           converting to limbs; the exact sum never needs more than
+           top - min_lsb bits. */
+        wp = FLINT_MIN(prec, top - min_lsb);
+        wn = (wp + 2 * pad + FLINT_BITS + FLINT_BITS - 1) / FLINT_BITS;
+
+        /* Use a shorter accumulator if everything fits exactly. */
+        if (top - min_lsb < wn * FLINT_BITS)
+            wn = (top - min_lsb + FLINT_BITS - 1) / FLINT_BITS;
+
+        bot = top - wn * FLINT_BITS;
+
+        TMP_START;
+        acc = TMP_ALLOC(sizeof(mp_limb_t) * wn);
+        t = TMP_ALLOC(sizeof(mp_limb_t) * (2 * wn + 3));
+        flint_mpn_zero(acc, wn);
+
+        truncated = 0;
+
+        if (initial != NULL && !arf_is_zero(arb_midref(initial)))
+        {
+            xm = arb_midref(initial);
+            ARF_GET_MPN_READONLY(xp, xn, xm);
+
+            if (xn > wn + 1)
+            {
+                xp += xn - (wn + 1);
+                xn = wn + 1;
+                truncated++;
+            }
+
+            flint_mpn_copyi(t, xp, xn);
+            shift = ARF_EXP(xm) - xn * FLINT_BITS - bot;
+            truncated += _arb_dot_add_mpn(acc, wn, t, xn, shift,
+                ARF_SGNBIT(xm) ^ subtract);
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            xm = arb_midref(x + i * xstep);
+            ym = arb_midref(y + i * ystep);
+
+            if (arf_is_zero(xm) || arf_is_zero(ym))
+                continue;
+
+            e = ARF_EXP(xm) + ARF_EXP(ym);
+
+            /* Entirely below the accumulator. */
+            if (e <= bot)
+            {
+                truncated++;
+                continue;
+            }
+
+            ARF_GET_MPN_READONLY(xp, xn, xm);
+            ARF_GET_MPN_READONLY(yp, yn, ym);
+
+            fix = 0;
+
+            if (xn > wn + 1)
+            {
+                xp += xn - (wn + 1);
+                xn = wn + 1;
+                fix = 1;
+            }
+
+            if (yn > wn + 1)
+            {
+                yp += yn - (wn + 1);
+                yn = wn + 1;
+                fix = 1;
+            }
+
+            if (xn == 1 && yn == 1)
+            {
+                umul_ppmm(t[1], t[0], xp[0], yp[0]);
+            }
+            else if (xn >= yn)
+            {
+                mpn_mul(t, xp, xn, yp, yn);
+            }
+            else
+            {
+                mpn_mul(t, yp, yn, xp, xn);
+            }
+
+            tn = xn + yn;
+            shift = e - tn * FLINT_BITS - bot;
+
+            fix |= _arb_dot_add_mpn(acc, wn, t, tn, shift,
+                ARF_SGNBIT(xm) ^ ARF_SGNBIT(ym));
+
+            truncated += fix;
+        }
+
+        /* Terms were added with the subtraction sign applied to the
+           initial value instead; restore the requested sign. */
+        negative = (acc[wn - 1] >> (FLINT_BITS - 1)) ^ subtract;
+
+        if (acc[wn - 1] >> (FLINT_BITS - 1))
+        {
+            for (i = 0; i < wn; i++)
+                acc[i] = ~acc[i];
+            mpn_add_1(acc, acc, wn, 1);
+        }
+
+        an = wn;
+        while (an > 0 && acc[an - 1] == 0)
+            an--;
+
+        if (an != 0)
+        {
+            inexact = _arf_set_round_mpn(s, &fix, acc, an, negative,
+                prec, ARB_RND);
+            fmpz_set_si(ARF_EXPREF(s), bot + an * FLINT_BITS + fix);
+        }
+
+        if (truncated != 0)
+            mag_fast_add_2exp_si(rad, rad,
+                bot + 1 + FLINT_BIT_COUNT(truncated));
+
+        TMP_END;
+    }
+
+    if (inexact)
+        arf_mag_add_ulp(rad, rad, s, prec);
+
+    arf_swap(arb_midref(res), s);
+    mag_swap(arb_radref(res), rad);
+
+    arf_clear(s);
+    mag_clear(rad);
+    return;
+
+fallback:
+    mag_clear(rad);
+    arb_dot_simple(res, initial, subtract, x, xstep, y, ystep, len, prec);
+}
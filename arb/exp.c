@@ -155,10 +155,12 @@ arb_exp_arf(arb_t z, const arf_t x, long prec, int minus_one)
     }
     else
     {
-        long exp, wp, wn, N, r, wprounded, finaln;
+        long exp, wp, wn, N, r, wprounded, finaln, halvings, errexp, i;
         fmpz_t n;
         mp_ptr tmp, w, t, u, finalvalue;
-        mp_limb_t p1, q1bits, p2, q2bits, error, error2;
+        mp_srcptr tab21, tab22;
+        mp_size_t tabn;
+        mp_limb_t p1, q1bits, p2, q2bits, error, error2, cy;
         int negative, inexact;
         TMP_INIT;
 
@@ -202,8 +204,28 @@ arb_exp_arf(arb_t z, const arf_t x, long prec, int minus_one)
            Taylor series truncation error without overflow) */
         wp = FLINT_MAX(wp, wprounded - (FLINT_BITS - 4));
 
+        halvings = 0;
+        tab21 = tab22 = NULL;
+        tabn = 0;
+
+        /* Beyond the static tables, use tables built at runtime, and halve
+           the reduced argument h times so that the Taylor series stays short;
+           the h squarings at the end lose about h bits. */
+        if (wp > ARB_EXP_TAB2_PREC && wp <= ARB_TAB2_RUNTIME_PREC)
+        {
+            halvings = _arb_tab2_halvings(wp);
+
+            wp = prec + 8 + halvings;
+            if (minus_one && exp <= 0)
+                wp += (-exp);
+            wn = (wp + FLINT_BITS - 1) / FLINT_BITS;
+            wprounded = FLINT_BITS * wn;
+            wp = FLINT_MAX(wp, wprounded - (FLINT_BITS - 4));
+        }
+
         /* Too high precision to use table -- use generic algorithm */
-        if (wp > ARB_EXP_TAB2_PREC)
+        if (wp > ARB_EXP_TAB1_PREC &&
+            !_arb_tab2_table(&tab21, &tab22, &tabn, ARB_TAB2_EXP, wn))
         {
             arb_exp_arf_fallback(z, x, exp, prec, minus_one);
             return;
@@ -252,6 +274,14 @@ arb_exp_arf(arb_t z, const arf_t x, long prec, int minus_one)
             w[wn-1] -= (p2 << (FLINT_BITS - q2bits));
         }
 
+        /* w / 2^h has error bounded by err(w) / 2^h + 1 ulp, giving
+           an error of at most 2 ulp in exp(w / 2^h) */
+        if (halvings != 0)
+        {
+            _arb_tab2_halve(w, wn, halvings);
+            error = (halvings >= FLINT_BITS ? 0 : error >> halvings) + 2;
+        }
+
         /* |w| <= 2^-r */
         r = _arb_mpn_leading_zeros(w, wn);
 
@@ -298,6 +328,31 @@ arb_exp_arf(arb_t z, const arf_t x, long prec, int minus_one)
             error += error2;
         }
 
+        /* The error is error * 2^errexp ulp. */
+        errexp = 0;
+
+        /*
+        Square h times, writing t = 1 + f with 0 <= f < 2^-9:
+        t^2 = 1 + 2f + f^2, where f^2 is truncated (1 ulp).
+        An error of e ulp in t becomes at most
+        2e(1 + f) + e^2 ulp + 1 ulp <= 2e + e/2^8 + 3 ulp.
+        */
+        for (i = 0; i < halvings; i++)
+        {
+            mpn_sqr(u, t, wn);
+            cy = mpn_lshift(t, t, wn, 1);
+            cy += mpn_add_n(t, t, u + wn, wn);
+            t[wn] = 1 + cy;
+
+            error = 2 * error + (error >> 8) + 3;
+
+            if (error >> (FLINT_BITS - 12))
+            {
+                error = (error >> 8) + 1;
+                errexp += 8;
+            }
+        }
+
         if (wp <= ARB_EXP_TAB1_PREC)
         {
             if (p1 == 0)
@@ -338,8 +393,8 @@ arb_exp_arf(arb_t z, const arf_t x, long prec, int minus_one)
                 mpn_rshift(t, t, wn + 1, 1);
                 error = (error >> 1) + 2;
 
-                mpn_mul_n(u, arb_exp_tab21[p1] + ARB_EXP_TAB2_LIMBS - wn,
-                             arb_exp_tab22[p2] + ARB_EXP_TAB2_LIMBS - wn, wn);
+                mpn_mul_n(u, tab21 + p1 * tabn + tabn - wn,
+                             tab22 + p2 * tabn + tabn - wn, wn);
 
                 /* error of w <= 4 ulp */
                 flint_mpn_copyi(w, u + wn, wn);  /* todo: avoid with better alloc */
@@ -360,7 +415,7 @@ arb_exp_arf(arb_t z, const arf_t x, long prec, int minus_one)
         }
 
         /* The accumulated arithmetic error */
-        mag_set_ui_2exp_si(arb_radref(z), error, -wprounded);
+        mag_set_ui_2exp_si(arb_radref(z), error, errexp - wprounded);
 
         /* Set the midpoint */
         if (!minus_one)
@@ -1324,3 +1324,110 @@ void _arb_exp_taylor_rs(mp_ptr y, mp_limb_t * error,
     TMP_END;
 }
 
+
+/* The same as _arb_exp_taylor_rs, evaluated for len arguments at once
+   (x and y holding len consecutive entries of xn and xn + 1 limbs).
+   The loop over the arguments is innermost, so that all the
+   coefficient bookkeeping is shared. */
+void _arb_exp_taylor_rs_vec(mp_ptr y, mp_limb_t * error,
+    mp_srcptr x, mp_size_t xn, ulong N, long len)
+{
+    mp_ptr s, t, xpow;
+    mp_limb_t new_denom, old_denom, c;
+    long power, k, m, j;
+    mp_size_t xpn;
+
+    TMP_INIT;
+
+    if (N >= FACTORIAL_TAB_SIZE - 1)
+    {
+        printf("_arb_exp_taylor_rs_vec: N too large!\n");
+        abort();
+    }
+
+    if (N <= 3 || len <= 1)
+    {
+        for (j = 0; j < len; j++)
+            _arb_exp_taylor_rs(y + j * (xn + 1), error, x + j * xn, xn, N);
+        return;
+    }
+
+    TMP_START;
+
+    m = 2;
+    while (m * m < N)
+        m += 2;
+
+    xpn = (m + 1) * xn;
+    xpow = TMP_ALLOC_LIMBS(len * xpn);
+    s = TMP_ALLOC_LIMBS(len * (xn + 2));
+    t = TMP_ALLOC_LIMBS(2 * xn + 2);
+
+#define XPOW_WRITE_J(__k) (xpow + j * xpn + (m - (__k)) * xn)
+#define XPOW_READ_J(__k) (xpow + j * xpn + (m - (__k) + 1) * xn)
+#define S_J (s + j * (xn + 2))
+
+    for (j = 0; j < len; j++)
+    {
+        flint_mpn_copyi(XPOW_READ_J(1), x + j * xn, xn);
+        mpn_sqr(XPOW_WRITE_J(2), XPOW_READ_J(1), xn);
+
+        for (k = 4; k <= m; k += 2)
+        {
+            mpn_mul_n(XPOW_WRITE_J(k - 1), XPOW_READ_J(k / 2),
+                XPOW_READ_J(k / 2 - 1), xn);
+            mpn_sqr(XPOW_WRITE_J(k), XPOW_READ_J(k / 2), xn);
+        }
+
+        flint_mpn_zero(S_J, xn + 1);
+    }
+
+    power = (N - 1) % m;
+
+    for (k = N - 1; k >= 0; k--)
+    {
+        c = factorial_tab_numer[k];
+        new_denom = factorial_tab_denom[k];
+        old_denom = factorial_tab_denom[k+1];
+
+        if (new_denom != old_denom && k < N - 1)
+        {
+            for (j = 0; j < len; j++)
+                mpn_divrem_1(S_J, 0, S_J, xn + 1, old_denom);
+        }
+
+        if (power == 0)
+        {
+            for (j = 0; j < len; j++)
+            {
+                S_J[xn] += c;
+
+                if (k != 0)
+                {
+                    mpn_mul(t, S_J, xn + 1, XPOW_READ_J(m), xn);
+                    flint_mpn_copyi(S_J, t + xn, xn + 1);
+                }
+            }
+
+            power = m - 1;
+        }
+        else
+        {
+            for (j = 0; j < len; j++)
+                S_J[xn] += mpn_addmul_1(S_J, XPOW_READ_J(power), xn, c);
+
+            power--;
+        }
+    }
+
+    for (j = 0; j < len; j++)
+        mpn_divrem_1(y + j * (xn + 1), 0, S_J, xn + 1, factorial_tab_denom[0]);
+
+#undef XPOW_WRITE_J
+#undef XPOW_READ_J
+#undef S_J
+
+    error[0] = 2;
+
+    TMP_END;
+}
@@ -28,6 +28,8 @@
 #include "bernoulli.h"
 #include "hypgeom.h"
 
+arb_srcptr _arb_gamma_stirling_coeffs(long nterms, int digamma, long prec);
+
 /* tuning factor */
 #define GAMMA_STIRLING_BETA 0.27
 
@@ -363,16 +365,24 @@ arb_gamma_stirling_coeff(arb_t b, ulong k, int digamma, long prec)
     fmpz_clear(d);
 }
 
+/*
+    The sum over k of c_k w^(k-1), w = 1/z^2, is evaluated by rectangular
+    splitting: blocks of m consecutive terms are computed as dot products
+    of the cached coefficients with the powers w^0, ..., w^(m-1), and
+    the blocks are combined using Horner's rule in w^m. Each block is
+    evaluated at the precision needed for its leading term.
+*/
 void
 arb_gamma_stirling_eval(arb_t s, const arb_t z, long nterms, int digamma, long prec)
 {
-    arb_t b, t, logz, zinv, zinv2;
+    arb_t t, logz, zinv, zinv2;
+    arb_ptr zpow;
+    arb_srcptr c;
     mag_t err;
 
-    long k, term_prec;
+    long k, j, m, N, len, term_prec;
     double z_mag, term_mag;
 
-    arb_init(b);
     arb_init(t);
     arb_init(logz);
     arb_init(zinv);
@@ -387,30 +397,44 @@ arb_gamma_stirling_eval(arb_t s, const arb_t z, long nterms, int digamma, long p
 
     if (nterms > 1)
     {
+        N = nterms - 1;
+        c = _arb_gamma_stirling_coeffs(nterms, digamma, prec);
+
         arb_mul(zinv2, zinv, zinv, prec);
 
         z_mag = arf_get_d(arb_midref(logz), ARF_RND_UP) * 1.44269504088896;
 
-        for (k = nterms - 1; k >= 1; k--)
+        m = n_sqrt(N);
+        zpow = _arb_vec_init(m + 1);
+        _arb_vec_set_powers(zpow, zinv2, m + 1, prec);
+
+        for (j = (N - 1) / m; j >= 0; j--)
         {
+            k = j * m + 1;
+            len = FLINT_MIN(m, N - j * m);
+
             term_mag = bernoulli_bound_2exp_si(2 * k);
             term_mag -= (2 * k - 1) * z_mag;
             term_prec = prec + term_mag;
             term_prec = FLINT_MIN(term_prec, prec);
             term_prec = FLINT_MAX(term_prec, 10);
 
-            if (prec > 2000)
+            if (j != (N - 1) / m)
             {
-                arb_set_round(t, zinv2, term_prec);
-                arb_mul(s, s, t, term_prec);
+                if (prec > 2000)
+                {
+                    arb_set_round(t, zpow + m, term_prec);
+                    arb_mul(s, s, t, term_prec);
+                }
+                else
+                    arb_mul(s, s, zpow + m, term_prec);
             }
-            else
-                arb_mul(s, s, zinv2, term_prec);
 
-            arb_gamma_stirling_coeff(b, k, digamma, term_prec);
-            arb_add(s, s, b, term_prec);
+            arb_dot(s, s, 0, c + k, 1, zpow, 1, len, term_prec);
         }
 
+        _arb_vec_clear(zpow, m + 1);
+
         if (digamma)
             arb_mul(s, s, zinv2, prec);
         else
@@ -444,7 +468,6 @@ arb_gamma_stirling_eval(arb_t s, const arb_t z, long nterms, int digamma, long p
     }
 
     arb_clear(t);
-    arb_clear(b);
     arb_clear(zinv);
     arb_clear(zinv2);
     arb_clear(logz);
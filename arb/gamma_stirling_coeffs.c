@@ -0,0 +1,150 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+#include "bernoulli.h"
+
+/*
+    Each thread keeps a few tables of the Stirling series coefficients
+    B_{2k} / (2k (2k-1)) (or B_{2k} / (2k) for the digamma function),
+    one for each recently used precision. Every entry is computed by
+    arb_gamma_stirling_coeff at exactly the precision of its table,
+    so the coefficients (and thus the function values) do not depend
+    on which precisions were used earlier. A table grows by at least
+    a quarter of its length at a time; when all slots are in use,
+    the least recently used table is recomputed.
+*/
+
+#define STIRLING_TAB_SLOTS 4
+
+TLS_PREFIX arb_ptr arb_gamma_stirling_tab[2][STIRLING_TAB_SLOTS];
+TLS_PREFIX long arb_gamma_stirling_tab_num[2][STIRLING_TAB_SLOTS];
+TLS_PREFIX long arb_gamma_stirling_tab_prec[2][STIRLING_TAB_SLOTS];
+TLS_PREFIX ulong arb_gamma_stirling_tab_used[2][STIRLING_TAB_SLOTS];
+TLS_PREFIX ulong arb_gamma_stirling_tab_clock = 0;
+TLS_PREFIX int arb_gamma_stirling_tab_have_registered_cleanup = 0;
+
+static void
+arb_gamma_stirling_tab_cleanup(void)
+{
+    int i, j;
+
+    for (i = 0; i < 2; i++)
+    {
+        for (j = 0; j < STIRLING_TAB_SLOTS; j++)
+        {
+            _arb_vec_clear(arb_gamma_stirling_tab[i][j],
+                arb_gamma_stirling_tab_num[i][j]);
+            arb_gamma_stirling_tab[i][j] = NULL;
+            arb_gamma_stirling_tab_num[i][j] = 0;
+            arb_gamma_stirling_tab_prec[i][j] = 0;
+            arb_gamma_stirling_tab_used[i][j] = 0;
+        }
+    }
+
+    arb_gamma_stirling_tab_clock = 0;
+    arb_gamma_stirling_tab_have_registered_cleanup = 0;
+}
+
+arb_srcptr
+_arb_gamma_stirling_coeffs(long nterms, int digamma, long prec)
+{
+    long k, num, new_num;
+    arb_ptr tab;
+    int i, j;
+
+    digamma = (digamma != 0);
+
+    /* look for a table at this precision, or else the least
+       recently used one (empty slots have never been used) */
+    j = 0;
+    for (i = 0; i < STIRLING_TAB_SLOTS; i++)
+    {
+        if (arb_gamma_stirling_tab_prec[digamma][i] == prec)
+        {
+            j = i;
+            break;
+        }
+
+        if (arb_gamma_stirling_tab_used[digamma][i] <
+            arb_gamma_stirling_tab_used[digamma][j])
+            j = i;
+    }
+
+    arb_gamma_stirling_tab_used[digamma][j] = ++arb_gamma_stirling_tab_clock;
+
+    num = arb_gamma_stirling_tab_num[digamma][j];
+    tab = arb_gamma_stirling_tab[digamma][j];
+
+    if (arb_gamma_stirling_tab_prec[digamma][j] == prec && nterms <= num)
+        return tab;
+
+    if (!arb_gamma_stirling_tab_have_registered_cleanup)
+    {
+        flint_register_cleanup_function(arb_gamma_stirling_tab_cleanup);
+        arb_gamma_stirling_tab_have_registered_cleanup = 1;
+    }
+
+    /* reuse the memory of a table at another precision */
+    if (arb_gamma_stirling_tab_prec[digamma][j] != prec)
+    {
+        new_num = nterms;
+        k = 1;
+    }
+    else
+    {
+        new_num = FLINT_MAX(nterms, num + num / 4);
+        k = FLINT_MAX(num, 1);
+    }
+
+    /* the cached coefficients must not live in the arena of this thread */
+    arf_arena_suspend();
+
+    if (new_num > num)
+    {
+        tab = flint_realloc(tab, sizeof(arb_struct) * new_num);
+
+        for (i = num; i < new_num; i++)
+            arb_init(tab + i);
+    }
+    else
+    {
+        new_num = num;
+    }
+
+    if (new_num > 1)
+        BERNOULLI_ENSURE_CACHED(2 * (new_num - 1));
+
+    for ( ; k < new_num; k++)
+        arb_gamma_stirling_coeff(tab + k, k, digamma, prec);
+
+    arf_arena_resume();
+
+    arb_gamma_stirling_tab[digamma][j] = tab;
+    arb_gamma_stirling_tab_num[digamma][j] = new_num;
+    arb_gamma_stirling_tab_prec[digamma][j] = prec;
+
+    return tab;
+}
@@ -107,10 +107,12 @@ _arb_get_mpn_fixed_mod_log2(mp_ptr w, fmpz_t q, mp_limb_t * error,
         }
         else
         {
-            if (wn > ARB_LOG_TAB2_LIMBS)
+            mp_srcptr dp = _arb_tab2_const(ARB_TAB2_LOG2, wn);
+
+            if (dp == NULL)
                 return 0;
 
-            mpn_sub_n(w, arb_log_log2_tab + ARB_LOG_TAB2_LIMBS - wn, w, wn);
+            mpn_sub_n(w, dp, w, wn);
             *error += 1;    /* log(2) has 1 ulp error */
             fmpz_set_si(q, -1);
         }
@@ -131,7 +133,9 @@ _arb_get_mpn_fixed_mod_log2(mp_ptr w, fmpz_t q, mp_limb_t * error,
         qn = nn - dn + 1;       /* quotient */
         rn = dn;                /* remainder */
 
-        if (dn > ARB_LOG_TAB2_LIMBS)
+        dp = _arb_tab2_const(ARB_TAB2_LOG2, dn);
+
+        if (dp == NULL)
             return 0;
 
         TMP_START;
@@ -141,8 +145,6 @@ _arb_get_mpn_fixed_mod_log2(mp_ptr w, fmpz_t q, mp_limb_t * error,
         rp = qp + qn;
         np = rp + rn;
 
-        dp = arb_log_log2_tab + ARB_LOG_TAB2_LIMBS - dn;
-
         /* todo: prove that zeroing is unnecessary */
         flint_mpn_zero(np, nn);
 
@@ -55,14 +55,14 @@ _arb_get_mpn_fixed_mod_pi4(mp_ptr w, fmpz_t q, int * octant,
     {
         mp_srcptr dp;
 
-        if (wn > ARB_PI4_TAB_LIMBS)
+        dp = _arb_tab2_const(ARB_TAB2_PI4, wn);
+
+        if (dp == NULL)
             return 0;
 
         flint_mpn_zero(w, wn);
         *error = _arf_get_integer_mpn(w, xp, xn, exp + wn * FLINT_BITS);
 
-        dp = arb_pi4_tab + ARB_PI4_TAB_LIMBS - wn;
-
         if (mpn_cmp(w, dp, wn) < 0)
         {
             *octant = 0;
@@ -96,7 +96,9 @@ _arb_get_mpn_fixed_mod_pi4(mp_ptr w, fmpz_t q, int * octant,
         qn = nn - dn + 1;       /* quotient */
         rn = dn;                /* remainder */
 
-        if (dn > ARB_PI4_TAB_LIMBS)
+        dp = _arb_tab2_const(ARB_TAB2_PI4, dn);
+
+        if (dp == NULL)
             return 0;
 
         TMP_START;
@@ -106,8 +108,6 @@ _arb_get_mpn_fixed_mod_pi4(mp_ptr w, fmpz_t q, int * octant,
         rp = qp + qn;
         np = rp + rn;
 
-        dp = arb_pi4_tab + ARB_PI4_TAB_LIMBS - dn;
-
         flint_mpn_zero(np, nn);
         _arf_get_integer_mpn(np, xp, xn, exp + dn * FLINT_BITS);
 
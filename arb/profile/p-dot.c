@@ -0,0 +1,84 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+#include "profiler.h"
+
+/*
+    Compares arb_dot with repeated arb_addmul (arb_dot_simple)
+    for random vectors of various lengths and precisions.
+*/
+
+int main()
+{
+    long len, prec, i, reps;
+    arb_ptr x, y;
+    arb_t s;
+    flint_rand_t state;
+    timeit_t t0, t1;
+
+    flint_randinit(state);
+    arb_init(s);
+
+    for (prec = 64; prec <= 4096; prec *= 4)
+    {
+        for (len = 1; len <= 1000; len *= 10)
+        {
+            x = _arb_vec_init(len);
+            y = _arb_vec_init(len);
+
+            for (i = 0; i < len; i++)
+            {
+                arb_randtest(x + i, state, prec, 4);
+                arb_randtest(y + i, state, prec, 4);
+            }
+
+            reps = FLINT_MAX(1, 1000000 / (len * prec));
+
+            timeit_start(t0);
+            for (i = 0; i < reps; i++)
+                arb_dot_simple(s, NULL, 0, x, 1, y, 1, len, prec);
+            timeit_stop(t0);
+
+            timeit_start(t1);
+            for (i = 0; i < reps; i++)
+                arb_dot(s, NULL, 0, x, 1, y, 1, len, prec);
+            timeit_stop(t1);
+
+            printf("prec = %5ld  len = %5ld  reps = %7ld  "
+                "addmul: %6ld ms  dot: %6ld ms  speedup: %.2f\n",
+                prec, len, reps, (long) t0->cpu, (long) t1->cpu,
+                (double) t0->cpu / FLINT_MAX(t1->cpu, 1));
+
+            _arb_vec_clear(x, len);
+            _arb_vec_clear(y, len);
+        }
+    }
+
+    arb_clear(s);
+    flint_randclear(state);
+    flint_cleanup();
+    return EXIT_SUCCESS;
+}
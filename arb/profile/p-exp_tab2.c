@@ -0,0 +1,106 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+#include "profiler.h"
+
+/*
+    Compares arb_exp and arb_sin_cos, which use the tables built at
+    runtime above ARB_EXP_TAB2_PREC bits, with the generic algorithms
+    used beyond ARB_TAB2_RUNTIME_PREC (bit-burst evaluation for exp,
+    MPFR for sin_cos), for random points in [0, 4). The tables are built
+    before timing. ARB_TAB2_RUNTIME_BANDS should be the largest band
+    count for which the first column of each pair is still the smaller.
+*/
+
+int main()
+{
+    long prec, i, reps;
+    arb_t x, y, z;
+    mpfr_t t, u, v;
+    flint_rand_t state;
+    timeit_t t0, t1, t2, t3;
+
+    flint_randinit(state);
+
+    arb_init(x);
+    arb_init(y);
+    arb_init(z);
+
+    for (prec = ARB_EXP_TAB2_PREC + ARB_EXP_TAB2_PREC / 2;
+        prec <= ARB_TAB2_RUNTIME_PREC - 64; prec += prec / 2)
+    {
+        arb_randtest(x, state, prec, 2);
+        arb_abs(x, x);
+        mag_zero(arb_radref(x));
+
+        mpfr_init2(t, prec);
+        mpfr_init2(u, prec);
+        mpfr_init2(v, prec);
+        arf_get_mpfr(t, arb_midref(x), MPFR_RNDN);
+
+        reps = FLINT_MAX(1, 2000000 / prec);
+
+        arb_exp(y, x, prec);
+        arb_sin_cos(y, z, x, prec);
+
+        timeit_start(t0);
+        for (i = 0; i < reps; i++)
+            arb_exp(y, x, prec);
+        timeit_stop(t0);
+
+        timeit_start(t1);
+        for (i = 0; i < reps; i++)
+            arb_exp_arf_bb(y, arb_midref(x), prec, 0);
+        timeit_stop(t1);
+
+        timeit_start(t2);
+        for (i = 0; i < reps; i++)
+            arb_sin_cos(y, z, x, prec);
+        timeit_stop(t2);
+
+        timeit_start(t3);
+        for (i = 0; i < reps; i++)
+            mpfr_sin_cos(u, v, t, MPFR_RNDN);
+        timeit_stop(t3);
+
+        printf("prec = %5ld  reps = %4ld  exp: %5ld ms  bb: %5ld ms  "
+            "sin_cos: %5ld ms  mpfr: %5ld ms\n",
+            prec, reps, (long) t0->wall, (long) t1->wall,
+            (long) t2->wall, (long) t3->wall);
+
+        mpfr_clear(t);
+        mpfr_clear(u);
+        mpfr_clear(v);
+    }
+
+    arb_clear(x);
+    arb_clear(y);
+    arb_clear(z);
+
+    flint_randclear(state);
+    flint_cleanup();
+    return EXIT_SUCCESS;
+}
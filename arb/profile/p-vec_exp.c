@@ -0,0 +1,96 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+#include "profiler.h"
+
+/*
+    Compares calling arb_exp and arb_sin_cos in a loop with
+    _arb_vec_exp and _arb_vec_sin_cos, for vectors of random
+    points in [0, 4) at various precisions.
+*/
+
+int main()
+{
+    long len, prec, i, j, reps;
+    arb_ptr x, y, z;
+    flint_rand_t state;
+    timeit_t t0, t1, t2, t3;
+
+    flint_randinit(state);
+
+    len = 1000;
+
+    for (prec = 32; prec <= 512; prec *= 2)
+    {
+        x = _arb_vec_init(len);
+        y = _arb_vec_init(len);
+        z = _arb_vec_init(len);
+
+        for (i = 0; i < len; i++)
+        {
+            arb_randtest(x + i, state, prec, 2);
+            arb_abs(x + i, x + i);
+            mag_zero(arb_radref(x + i));
+        }
+
+        reps = FLINT_MAX(1, 100000 / prec);
+
+        timeit_start(t0);
+        for (j = 0; j < reps; j++)
+            for (i = 0; i < len; i++)
+                arb_exp(y + i, x + i, prec);
+        timeit_stop(t0);
+
+        timeit_start(t1);
+        for (j = 0; j < reps; j++)
+            _arb_vec_exp(y, x, len, prec);
+        timeit_stop(t1);
+
+        timeit_start(t2);
+        for (j = 0; j < reps; j++)
+            for (i = 0; i < len; i++)
+                arb_sin_cos(y + i, z + i, x + i, prec);
+        timeit_stop(t2);
+
+        timeit_start(t3);
+        for (j = 0; j < reps; j++)
+            _arb_vec_sin_cos(y, z, x, len, prec);
+        timeit_stop(t3);
+
+        printf("prec = %4ld  reps = %5ld  exp: %5ld ms  vec_exp: %5ld ms  "
+            "sin_cos: %5ld ms  vec_sin_cos: %5ld ms\n",
+            prec, reps, (long) t0->wall, (long) t1->wall,
+            (long) t2->wall, (long) t3->wall);
+
+        _arb_vec_clear(x, len);
+        _arb_vec_clear(y, len);
+        _arb_vec_clear(z, len);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    return EXIT_SUCCESS;
+}
@@ -24,6 +24,10 @@
 ******************************************************************************/
 
 #include "arb.h"
+#include "arb_thread_pool.h"
+
+/* minimum number of factors per leaf when splitting over threads */
+#define BSPLIT_PARALLEL_CUTOFF 32
 
 /* assumes y and x are not aliased */
 static void
@@ -69,6 +73,40 @@ bsplit(arb_t y, const arb_t x, ulong a, ulong b, long prec)
     }
 }
 
+typedef struct
+{
+    arb_srcptr x;
+    long prec;
+}
+bsplit_args_t;
+
+static void
+bsplit_init(void * y)
+{
+    arb_init(y);
+}
+
+static void
+bsplit_clear(void * y)
+{
+    arb_clear(y);
+}
+
+static void
+bsplit_basecase(void * y, long a, long b, int cont, void * args)
+{
+    bsplit_args_t * arg = args;
+    bsplit(y, arg->x, a, b, arg->prec);
+}
+
+static void
+bsplit_merge(void * left, void * right, long a, long m, long b,
+    int cont, void * args)
+{
+    bsplit_args_t * arg = args;
+    arb_mul(left, left, right, arg->prec);
+}
+
 void
 arb_rising_ui_bs(arb_t y, const arb_t x, ulong n, long prec)
 {
@@ -83,10 +121,18 @@ arb_rising_ui_bs(arb_t y, const arb_t x, ulong n, long prec)
     else
     {
         arb_t t;
+        bsplit_args_t args;
         long wp = ARF_PREC_ADD(prec, FLINT_BIT_COUNT(n));
 
+        args.x = x;
+        args.prec = wp;
+
+        /* the factors are only worth distributing at high precision */
         arb_init(t);
-        bsplit(t, x, 0, n, wp);
+        arb_thread_pool_bsplit(t, 0, n, &args, sizeof(arb_struct),
+            bsplit_init, bsplit_clear, bsplit_basecase, bsplit_merge,
+            BSPLIT_PARALLEL_CUTOFF,
+            (wp >= 4096) ? flint_get_num_threads() : 1);
         arb_set_round(y, t, prec);
         arb_clear(t);
     }
@@ -183,9 +183,11 @@ void
 arb_sin_cos_arf_new(arb_t zsin, arb_t zcos, const arf_t x, long prec)
 {
     int want_sin, want_cos;
-    long exp, wp, wn, N, r, wprounded;
+    long exp, wp, wn, N, r, wprounded, halvings, errexp, i;
     mp_ptr tmp, w, sina, cosa, sinb, cosb, ta, tb;
     mp_ptr sinptr, cosptr;
+    mp_srcptr tab21, tab22;
+    mp_size_t tabn;
     mp_limb_t p1, q1bits, p2, q2bits, error, error2;
     int negative, inexact, octant;
     int sinnegative, cosnegative, swapsincos;
@@ -209,8 +211,28 @@ arb_sin_cos_arf_new(arb_t zsin, arb_t zcos, const arf_t x, long prec)
        Taylor series truncation error without overflow) */
     wp = FLINT_MAX(wp, wprounded - (FLINT_BITS - 4));
 
+    halvings = 0;
+    tab21 = tab22 = NULL;
+    tabn = 0;
+
+    /* Beyond the static tables, use tables built at runtime, and halve
+       the reduced argument h times so that the Taylor series stays short;
+       the h angle doublings at the end lose about h bits. */
+    if (wp > ARB_SIN_COS_TAB2_PREC && wp <= ARB_TAB2_RUNTIME_PREC)
+    {
+        halvings = _arb_tab2_halvings(wp);
+
+        wp = prec + 8 + halvings;
+        if (want_sin && exp <= 0)
+            wp += (-exp);
+        wn = (wp + FLINT_BITS - 1) / FLINT_BITS;
+        wprounded = FLINT_BITS * wn;
+        wp = FLINT_MAX(wp, wprounded - (FLINT_BITS - 4));
+    }
+
     /* Too high precision to use table -- use generic algorithm */
-    if (wp > ARB_SIN_COS_TAB2_PREC)
+    if (wp > ARB_SIN_COS_TAB1_PREC &&
+        !_arb_tab2_table(&tab21, &tab22, &tabn, ARB_TAB2_SIN_COS, wn))
     {
         if (want_sin && want_cos)
         {
@@ -290,6 +312,13 @@ arb_sin_cos_arf_new(arb_t zsin, arb_t zcos, const arf_t x, long prec)
         w[wn-1] -= (p2 << (FLINT_BITS - q2bits));
     }
 
+    /* w / 2^h has error bounded by err(w) / 2^h + 1 ulp */
+    if (halvings != 0)
+    {
+        _arb_tab2_halve(w, wn, halvings);
+        error = (halvings >= FLINT_BITS ? 0 : error >> halvings) + 2;
+    }
+
     /* |w| <= 2^-r */
     r = _arb_mpn_leading_zeros(w, wn);
 
@@ -337,6 +366,41 @@ arb_sin_cos_arf_new(arb_t zsin, arb_t zcos, const arf_t x, long prec)
         }
     }
 
+    /* The error is error * 2^errexp ulp. */
+    errexp = 0;
+
+    /*
+    Double the angle h times:
+
+        sin(2a) = 2 sin(a) cos(a)
+        cos(2a) = 1 - 2 sin(a)^2
+
+    where 0 <= sin(a) < 2^-9, and each product is truncated (1 ulp,
+    doubled). An error of e ulp in sin(a) and cos(a) becomes at most
+    2e(1 + sin(a)) + e^2 ulp + 2 ulp <= 2e + e/2^8 + 3 ulp, plus 1 ulp
+    if cos(2a) has to be rounded down from 1.
+    */
+    for (i = 0; i < halvings; i++)
+    {
+        mpn_mul_n(ta, sina, cosa, wn);
+        mpn_sqr(tb, sina, wn);
+        mpn_lshift(sina, ta + wn, wn, 1);
+        mpn_lshift(tb + wn, tb + wn, wn, 1);
+
+        if (flint_mpn_zero_p(tb + wn, wn))
+            flint_mpn_store(cosa, wn, LIMB_ONES);
+        else
+            mpn_neg(cosa, tb + wn, wn);
+
+        error = 2 * error + (error >> 8) + 4;
+
+        if (error >> (FLINT_BITS - 12))
+        {
+            error = (error >> 8) + 1;
+            errexp += 8;
+        }
+    }
+
     /*
     sin(a+b) = sin(a)*cos(b) + cos(a)*sin(b)
     cos(a+b) = cos(a)*cos(b) - sin(a)*sin(b)
@@ -371,13 +435,13 @@ arb_sin_cos_arf_new(arb_t zsin, arb_t zcos, const arf_t x, long prec)
         }
         else if (p1 != 0)
         {
-            sinc = arb_sin_cos_tab21[2 * p1] + ARB_SIN_COS_TAB2_LIMBS - wn;
-            cosc = arb_sin_cos_tab21[2 * p1 + 1] + ARB_SIN_COS_TAB2_LIMBS - wn;
+            sinc = tab21 + (2 * p1) * tabn + tabn - wn;
+            cosc = tab21 + (2 * p1 + 1) * tabn + tabn - wn;
         }
         else
         {
-            sinc = arb_sin_cos_tab22[2 * p2] + ARB_SIN_COS_TAB2_LIMBS - wn;
-            cosc = arb_sin_cos_tab22[2 * p2 + 1] + ARB_SIN_COS_TAB2_LIMBS - wn;
+            sinc = tab22 + (2 * p2) * tabn + tabn - wn;
+            cosc = tab22 + (2 * p2 + 1) * tabn + tabn - wn;
         }
 
         if ((want_sin && !swapsincos) || (want_cos && swapsincos))
@@ -403,10 +467,10 @@ arb_sin_cos_arf_new(arb_t zsin, arb_t zcos, const arf_t x, long prec)
     {
         mp_srcptr sinc, cosc, sind, cosd;
 
-        sinc = arb_sin_cos_tab21[2 * p1] + ARB_SIN_COS_TAB2_LIMBS - wn;
-        cosc = arb_sin_cos_tab21[2 * p1 + 1] + ARB_SIN_COS_TAB2_LIMBS - wn;
-        sind = arb_sin_cos_tab22[2 * p2] + ARB_SIN_COS_TAB2_LIMBS - wn;
-        cosd = arb_sin_cos_tab22[2 * p2 + 1] + ARB_SIN_COS_TAB2_LIMBS - wn;
+        sinc = tab21 + (2 * p1) * tabn + tabn - wn;
+        cosc = tab21 + (2 * p1 + 1) * tabn + tabn - wn;
+        sind = tab22 + (2 * p2) * tabn + tabn - wn;
+        cosd = tab22 + (2 * p2 + 1) * tabn + tabn - wn;
 
         mpn_mul_n(ta, sinc, cosd, wn);
         mpn_mul_n(tb, cosc, sind, wn);
@@ -448,14 +512,14 @@ arb_sin_cos_arf_new(arb_t zsin, arb_t zcos, const arf_t x, long prec)
     /* The accumulated error */
     if (want_sin)
     {
-        mag_set_ui_2exp_si(arb_radref(zsin), error, -wprounded);
+        mag_set_ui_2exp_si(arb_radref(zsin), error, errexp - wprounded);
 
         if (want_cos)
             mag_set(arb_radref(zcos), arb_radref(zsin));
     }
     else
     {
-        mag_set_ui_2exp_si(arb_radref(zcos), error, -wprounded);
+        mag_set_ui_2exp_si(arb_radref(zcos), error, errexp - wprounded);
     }
 
     /* Set the midpoint */
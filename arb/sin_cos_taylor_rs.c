@@ -178,3 +178,150 @@ void _arb_sin_cos_taylor_rs(mp_ptr ysin, mp_ptr ycos,
     TMP_END;
 }
 
+
+/* The same as _arb_sin_cos_taylor_rs, evaluated for len arguments at once
+   (x, ysin and ycos holding len consecutive entries of xn limbs).
+   The loop over the arguments is innermost, so that all the
+   coefficient bookkeeping is shared. */
+void _arb_sin_cos_taylor_rs_vec(mp_ptr ysin, mp_ptr ycos,
+    mp_limb_t * error, mp_srcptr x, mp_size_t xn, ulong N,
+    int sinonly, int alternating, long len)
+{
+    mp_ptr s, t, xpow;
+    mp_limb_t new_denom, old_denom, c;
+    long power, k, m, j;
+    mp_size_t xpn;
+    int cosorsin;
+
+    TMP_INIT;
+
+    if (2 * N >= FACTORIAL_TAB_SIZE - 1)
+    {
+        printf("_arb_sin_cos_taylor_rs_vec: N too large!\n");
+        abort();
+    }
+
+    if (N <= 1 || len <= 1)
+    {
+        for (j = 0; j < len; j++)
+            _arb_sin_cos_taylor_rs(ysin + j * xn,
+                sinonly ? NULL : ycos + j * xn, error, x + j * xn, xn, N,
+                sinonly, alternating);
+        return;
+    }
+
+    TMP_START;
+
+    m = 2;
+    while (m * m < N)
+        m += 2;
+
+    xpn = (m + 1) * xn;
+    xpow = TMP_ALLOC_LIMBS(len * xpn);
+    s = TMP_ALLOC_LIMBS(len * (xn + 2));
+    t = TMP_ALLOC_LIMBS(2 * xn + 2);
+
+#define XPOW_WRITE_J(__k) (xpow + j * xpn + (m - (__k)) * xn)
+#define XPOW_READ_J(__k) (xpow + j * xpn + (m - (__k) + 1) * xn)
+#define S_J (s + j * (xn + 2))
+
+    for (j = 0; j < len; j++)
+    {
+        mpn_sqr(XPOW_WRITE_J(1), x + j * xn, xn);
+        mpn_sqr(XPOW_WRITE_J(2), XPOW_READ_J(1), xn);
+
+        for (k = 4; k <= m; k += 2)
+        {
+            mpn_mul_n(XPOW_WRITE_J(k - 1), XPOW_READ_J(k / 2),
+                XPOW_READ_J(k / 2 - 1), xn);
+            mpn_sqr(XPOW_WRITE_J(k), XPOW_READ_J(k / 2), xn);
+        }
+    }
+
+    for (cosorsin = sinonly; cosorsin < 2; cosorsin++)
+    {
+        for (j = 0; j < len; j++)
+            flint_mpn_zero(S_J, xn + 1);
+
+        power = (N - 1) % m;
+
+        for (k = N - 1; k >= 0; k--)
+        {
+            c = factorial_tab_numer[2 * k + cosorsin];
+            new_denom = factorial_tab_denom[2 * k + cosorsin];
+            old_denom = factorial_tab_denom[2 * k + cosorsin + 2];
+
+            if (new_denom != old_denom && k < N - 1)
+            {
+                for (j = 0; j < len; j++)
+                {
+                    if (alternating && (k % 2 == 0))
+                        S_J[xn] += old_denom;
+
+                    mpn_divrem_1(S_J, 0, S_J, xn + 1, old_denom);
+
+                    if (alternating && (k % 2 == 0))
+                        S_J[xn] -= 1;
+                }
+            }
+
+            if (power == 0)
+            {
+                for (j = 0; j < len; j++)
+                {
+                    if (alternating & k)
+                        S_J[xn] -= c;
+                    else
+                        S_J[xn] += c;
+
+                    if (k != 0)
+                    {
+                        mpn_mul(t, S_J, xn + 1, XPOW_READ_J(m), xn);
+                        flint_mpn_copyi(S_J, t + xn, xn + 1);
+                    }
+                }
+
+                power = m - 1;
+            }
+            else
+            {
+                for (j = 0; j < len; j++)
+                {
+                    if (alternating & k)
+                        S_J[xn] -= mpn_submul_1(S_J, XPOW_READ_J(power), xn, c);
+                    else
+                        S_J[xn] += mpn_addmul_1(S_J, XPOW_READ_J(power), xn, c);
+                }
+
+                power--;
+            }
+        }
+
+        for (j = 0; j < len; j++)
+        {
+            if (cosorsin == 0)
+            {
+                mpn_divrem_1(t, 0, S_J, xn + 1, factorial_tab_denom[0]);
+
+                if (t[xn] == 0)
+                    flint_mpn_copyi(ycos + j * xn, t, xn);
+                else
+                    flint_mpn_store(ycos + j * xn, xn, LIMB_ONES);
+            }
+            else
+            {
+                mpn_divrem_1(S_J, 0, S_J, xn + 1, factorial_tab_denom[0]);
+                mpn_mul(t, S_J, xn + 1, x + j * xn, xn);
+                flint_mpn_copyi(ysin + j * xn, t + xn, xn);
+            }
+        }
+    }
+
+#undef XPOW_WRITE_J
+#undef XPOW_READ_J
+#undef S_J
+
+    error[0] = 2;
+
+    TMP_END;
+}
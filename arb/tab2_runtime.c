@@ -0,0 +1,332 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <pthread.h>
+#include "arb.h"
+
+/*
+    Tables for the exponential and trigonometric functions, and the
+    constants log(2) and pi/4, at precision higher than the static tables.
+    Band b holds ARB_EXP_TAB2_LIMBS * 2^b limbs per entry. Bands are built
+    lazily the first time they are needed and are then shared by all
+    threads. Since any thread may be reading a band, they are not tied
+    to flint_cleanup (which only runs for the calling thread); they live
+    until the process exits, or until _arb_tab2_clear is called explicitly.
+
+    As in the static tables, each entry is the exact floor of the value
+    as a fixed-point fraction, and a value equal to one is stored as
+    all ones.
+*/
+
+#define TAB2_BASE_LIMBS ARB_EXP_TAB2_LIMBS
+#define TAB2_MAX_BANDS (ARB_TAB2_RUNTIME_BANDS + 2)
+
+/* the functions evaluated with MPFR */
+#define TAB2_FUNC_EXP_HALF 0
+#define TAB2_FUNC_SIN 1
+#define TAB2_FUNC_COS 2
+#define TAB2_FUNC_LOG2 3
+#define TAB2_FUNC_PI4 4
+
+static mp_ptr tab2_bands[ARB_TAB2_NUM_KINDS][TAB2_MAX_BANDS + 1];
+static pthread_mutex_t tab2_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void
+_arb_tab2_eval(mpfr_t v, int func, ulong j, int qbits)
+{
+    mpfr_t x;
+
+    mpfr_init2(x, FLINT_BITS);
+    mpfr_set_ui_2exp(x, j, -qbits, MPFR_RNDD);
+
+    switch (func)
+    {
+        case TAB2_FUNC_EXP_HALF:
+            mpfr_exp(v, x, MPFR_RNDD);
+            mpfr_div_2ui(v, v, 1, MPFR_RNDD);
+            break;
+        case TAB2_FUNC_SIN:
+            mpfr_sin(v, x, MPFR_RNDD);
+            break;
+        case TAB2_FUNC_COS:
+            mpfr_cos(v, x, MPFR_RNDD);
+            break;
+        case TAB2_FUNC_LOG2:
+            mpfr_const_log2(v, MPFR_RNDD);
+            break;
+        default:
+            mpfr_const_pi(v, MPFR_RNDD);
+            mpfr_div_2ui(v, v, 2, MPFR_RNDD);
+    }
+
+    mpfr_clear(x);
+}
+
+/* Sets {res, n} to the floor of 2^(n * FLINT_BITS) times the value,
+   which must be in [0, 1]. */
+static void
+_arb_tab2_set_entry(mp_ptr res, mp_size_t n, int func, ulong j, int qbits)
+{
+    mpfr_t v;
+    mpz_t z;
+    long prec;
+
+    prec = n * FLINT_BITS;
+
+    mpfr_init2(v, prec);
+    mpz_init(z);
+
+    _arb_tab2_eval(v, func, j, qbits);
+
+    /* a value in [2^(e-1), 2^e) needs prec + e bits to be correctly
+       rounded down to a multiple of 2^(-prec) */
+    if (!mpfr_zero_p(v) && mpfr_get_exp(v) < 0)
+    {
+        mpfr_set_prec(v, FLINT_MAX(prec + mpfr_get_exp(v), 2));
+        _arb_tab2_eval(v, func, j, qbits);
+    }
+
+    mpfr_mul_2ui(v, v, prec, MPFR_RNDD);
+    mpfr_get_z(z, v, MPFR_RNDD);
+
+    if (mpz_size(z) > n)
+    {
+        flint_mpn_store(res, n, LIMB_ONES);
+    }
+    else
+    {
+        flint_mpn_zero(res, n);
+        flint_mpn_copyi(res, z->_mp_d, mpz_size(z));
+    }
+
+    mpfr_clear(v);
+    mpz_clear(z);
+}
+
+static mp_ptr
+_arb_tab2_build(int kind, mp_size_t n)
+{
+    mp_ptr tab;
+    long j;
+
+    if (kind == ARB_TAB2_EXP)
+    {
+        tab = flint_malloc(sizeof(mp_limb_t) * n *
+            (ARB_EXP_TAB21_NUM + ARB_EXP_TAB22_NUM));
+
+        for (j = 0; j < ARB_EXP_TAB21_NUM; j++)
+            _arb_tab2_set_entry(tab + j * n, n, TAB2_FUNC_EXP_HALF,
+                j, ARB_EXP_TAB21_BITS);
+
+        for (j = 0; j < ARB_EXP_TAB22_NUM; j++)
+            _arb_tab2_set_entry(tab + (ARB_EXP_TAB21_NUM + j) * n, n,
+                TAB2_FUNC_EXP_HALF, j, ARB_EXP_TAB21_BITS + ARB_EXP_TAB22_BITS);
+    }
+    else if (kind == ARB_TAB2_SIN_COS)
+    {
+        tab = flint_malloc(sizeof(mp_limb_t) * n *
+            2 * (ARB_SIN_COS_TAB21_NUM + ARB_SIN_COS_TAB22_NUM));
+
+        for (j = 0; j < ARB_SIN_COS_TAB21_NUM; j++)
+        {
+            _arb_tab2_set_entry(tab + (2 * j) * n, n, TAB2_FUNC_SIN,
+                j, ARB_SIN_COS_TAB21_BITS);
+            _arb_tab2_set_entry(tab + (2 * j + 1) * n, n, TAB2_FUNC_COS,
+                j, ARB_SIN_COS_TAB21_BITS);
+        }
+
+        tab += 2 * ARB_SIN_COS_TAB21_NUM * n;
+
+        for (j = 0; j < ARB_SIN_COS_TAB22_NUM; j++)
+        {
+            _arb_tab2_set_entry(tab + (2 * j) * n, n, TAB2_FUNC_SIN,
+                j, ARB_SIN_COS_TAB21_BITS + ARB_SIN_COS_TAB22_BITS);
+            _arb_tab2_set_entry(tab + (2 * j + 1) * n, n, TAB2_FUNC_COS,
+                j, ARB_SIN_COS_TAB21_BITS + ARB_SIN_COS_TAB22_BITS);
+        }
+
+        tab -= 2 * ARB_SIN_COS_TAB21_NUM * n;
+    }
+    else
+    {
+        tab = flint_malloc(sizeof(mp_limb_t) * n);
+        _arb_tab2_set_entry(tab, n, (kind == ARB_TAB2_LOG2) ?
+            TAB2_FUNC_LOG2 : TAB2_FUNC_PI4, 0, 0);
+    }
+
+    return tab;
+}
+
+/* Returns band b, building it if necessary. */
+static mp_srcptr
+_arb_tab2_band(int kind, int b)
+{
+    mp_ptr tab;
+
+    pthread_mutex_lock(&tab2_lock);
+
+    tab = tab2_bands[kind][b];
+
+    if (tab == NULL)
+    {
+        tab = _arb_tab2_build(kind, TAB2_BASE_LIMBS << b);
+        tab2_bands[kind][b] = tab;
+    }
+
+    pthread_mutex_unlock(&tab2_lock);
+
+    return tab;
+}
+
+int
+_arb_tab2_table(mp_srcptr * tab21, mp_srcptr * tab22, mp_size_t * tabn,
+    int kind, mp_size_t n)
+{
+    mp_srcptr tab;
+    int b;
+
+    if (n <= TAB2_BASE_LIMBS)
+    {
+        *tabn = TAB2_BASE_LIMBS;
+
+        if (kind == ARB_TAB2_EXP)
+        {
+            *tab21 = arb_exp_tab21[0];
+            *tab22 = arb_exp_tab22[0];
+        }
+        else
+        {
+            *tab21 = arb_sin_cos_tab21[0];
+            *tab22 = arb_sin_cos_tab22[0];
+        }
+
+        return 1;
+    }
+
+    for (b = 1; b <= ARB_TAB2_RUNTIME_BANDS; b++)
+    {
+        if (n <= (TAB2_BASE_LIMBS << b))
+        {
+            *tabn = TAB2_BASE_LIMBS << b;
+            tab = _arb_tab2_band(kind, b);
+
+            *tab21 = tab;
+
+            if (kind == ARB_TAB2_EXP)
+                *tab22 = tab + ARB_EXP_TAB21_NUM * (*tabn);
+            else
+                *tab22 = tab + 2 * ARB_SIN_COS_TAB21_NUM * (*tabn);
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+mp_srcptr
+_arb_tab2_const(int kind, mp_size_t n)
+{
+    int b;
+
+    if (n <= TAB2_BASE_LIMBS)
+    {
+        if (kind == ARB_TAB2_LOG2)
+            return arb_log_log2_tab + ARB_LOG_TAB2_LIMBS - n;
+        else
+            return arb_pi4_tab + ARB_PI4_TAB_LIMBS - n;
+    }
+
+    for (b = 1; b <= TAB2_MAX_BANDS; b++)
+    {
+        if (n <= (TAB2_BASE_LIMBS << b))
+            return _arb_tab2_band(kind, b) + (TAB2_BASE_LIMBS << b) - n;
+    }
+
+    return NULL;
+}
+
+void
+_arb_tab2_clear(void)
+{
+    int kind, b;
+
+    pthread_mutex_lock(&tab2_lock);
+
+    for (kind = 0; kind < ARB_TAB2_NUM_KINDS; kind++)
+    {
+        for (b = 0; b <= TAB2_MAX_BANDS; b++)
+        {
+            if (tab2_bands[kind][b] != NULL)
+            {
+                flint_free(tab2_bands[kind][b]);
+                tab2_bands[kind][b] = NULL;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&tab2_lock);
+}
+
+long
+_arb_tab2_halvings(long wp)
+{
+    long h;
+
+    /* N (10 + h) + log2(N!) >= wp must hold with N terms;
+       log2(N!) < 1900 for the largest allowed N */
+    h = FLINT_MAX(0, (wp - 1900) / ARB_TAB2_TAYLOR_TERMS - 10);
+
+    while (_arb_exp_taylor_bound(-(ARB_EXP_TAB21_BITS +
+        ARB_EXP_TAB22_BITS + h), wp + h) > ARB_TAB2_TAYLOR_TERMS)
+    {
+        h++;
+    }
+
+    return h;
+}
+
+void
+_arb_tab2_halve(mp_ptr w, mp_size_t wn, long h)
+{
+    mp_size_t limbs = h / FLINT_BITS;
+
+    h = h % FLINT_BITS;
+
+    if (limbs >= wn)
+    {
+        flint_mpn_zero(w, wn);
+        return;
+    }
+
+    if (limbs != 0)
+    {
+        flint_mpn_copyi(w, w + limbs, wn - limbs);
+        flint_mpn_zero(w + wn - limbs, limbs);
+    }
+
+    if (h != 0)
+        mpn_rshift(w, w, wn - limbs, h);
+}
@@ -0,0 +1,157 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <pthread.h>
+#include "arb.h"
+#include "arb_thread_pool.h"
+
+/* the evaluation function may run on several threads at once */
+static long num_evals = 0;
+static pthread_mutex_t num_evals_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void
+two_pi_eval(arb_t x, long prec)
+{
+    pthread_mutex_lock(&num_evals_lock);
+    num_evals++;
+    pthread_mutex_unlock(&num_evals_lock);
+
+    arb_const_pi(x, prec);
+    arb_mul_2exp_si(x, x, 1);
+}
+
+ARB_DEF_CACHED_CONSTANT(two_pi, two_pi_eval)
+
+typedef struct
+{
+    long max_prec;
+    int fail;
+}
+task_args_t;
+
+static void
+task(void * args, long i)
+{
+    task_args_t * t = args;
+    arb_t x, y;
+    long prec;
+
+    prec = 2 + (i * 1009) % t->max_prec;
+
+    arb_init(x);
+    arb_init(y);
+
+    two_pi(x, prec);
+    arb_const_pi(y, prec + 10);
+    arb_mul_2exp_si(y, y, 1);
+
+    if (!arb_overlaps(x, y) || arb_rel_accuracy_bits(x) < prec - 2)
+    {
+        pthread_mutex_lock(&num_evals_lock);
+        t->fail = 1;
+        pthread_mutex_unlock(&num_evals_lock);
+    }
+
+    arb_clear(x);
+    arb_clear(y);
+}
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("const_cache....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000; iter++)
+    {
+        arb_t x, y;
+        long prec, evals;
+
+        prec = 2 + n_randint(state, 2000);
+
+        arb_init(x);
+        arb_init(y);
+
+        two_pi(x, prec);
+        arb_const_pi(y, prec + 10);
+        arb_mul_2exp_si(y, y, 1);
+
+        if (!arb_overlaps(x, y) || arb_rel_accuracy_bits(x) < prec - 2 ||
+            arb_const_cache_prec(two_pi_cache) < prec)
+        {
+            printf("FAIL: overlap\n\n");
+            printf("prec = %ld\n\n", prec);
+            printf("x = "); arb_printd(x, 50); printf("\n\n");
+            printf("y = "); arb_printd(y, 50); printf("\n\n");
+            abort();
+        }
+
+        /* a lower precision must not cause a recomputation */
+        evals = num_evals;
+        two_pi(x, 2 + n_randint(state, prec));
+
+        if (num_evals != evals)
+        {
+            printf("FAIL: recomputed\n\n");
+            printf("prec = %ld\n\n", prec);
+            abort();
+        }
+
+        arb_clear(x);
+        arb_clear(y);
+
+        if (iter % 100 == 99)
+            arb_const_cache_clear_all();
+    }
+
+    /* concurrent readers and writers */
+    for (iter = 0; iter < 20; iter++)
+    {
+        task_args_t args;
+
+        arb_const_cache_clear_all();
+
+        args.max_prec = 1000 + n_randint(state, 10000);
+        args.fail = 0;
+
+        num_evals = 0;
+        arb_thread_pool_parallel_do(task, &args, 200, 4);
+
+        if (args.fail || num_evals > 64)
+        {
+            printf("FAIL: threaded (num_evals = %ld)\n\n", num_evals);
+            abort();
+        }
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,278 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <stdio.h>
+#include "arb.h"
+#include "bernoulli.h"
+
+#define TMPFILE "t-disk_cache.tmp"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("disk_cache....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    remove(TMPFILE);
+    arb_disk_cache_set_path(TMPFILE);
+
+    /* arb_t records */
+    for (iter = 0; iter < 1000; iter++)
+    {
+        arb_t x, y;
+        long prec, prec2;
+        char key[16];
+
+        arb_init(x);
+        arb_init(y);
+
+        sprintf(key, "k%ld", iter % 10);
+        prec = 2 + n_randint(state, 1000);
+
+        arb_randtest(x, state, 1 + n_randint(state, 1000), 100);
+        if (!arb_is_finite(x))
+            arb_zero(x);
+
+        _arb_disk_cache_store_arb(key, x, prec);
+
+        if (n_randint(state, 10) == 0)
+            arb_disk_cache_set_path(TMPFILE);
+
+        /* some record at least as precise must exist */
+        if (!_arb_disk_cache_load_arb(y, &prec2, key, prec) || prec2 < prec)
+        {
+            printf("FAIL: load\n\n");
+            printf("prec = %ld, prec2 = %ld\n\n", prec, prec2);
+            abort();
+        }
+
+        if (_arb_disk_cache_load_arb(y, &prec2, "nonexistent", 2))
+        {
+            printf("FAIL: nonexistent key\n\n");
+            abort();
+        }
+
+        arb_clear(x);
+        arb_clear(y);
+    }
+
+    /* exact round trip */
+    for (iter = 0; iter < 100; iter++)
+    {
+        arb_t x, y;
+        long prec, prec2;
+        char key[16];
+
+        arb_init(x);
+        arb_init(y);
+
+        sprintf(key, "exact%ld", iter);
+        prec = 2 + n_randint(state, 1000);
+        arb_randtest(x, state, 1 + n_randint(state, 5000), 100);
+
+        _arb_disk_cache_store_arb(key, x, prec);
+
+        if (iter % 2)
+            arb_disk_cache_set_path(TMPFILE);
+
+        if (arb_is_finite(x))
+        {
+            if (!_arb_disk_cache_load_arb(y, &prec2, key, prec) ||
+                prec2 != prec || !arb_equal(x, y))
+            {
+                printf("FAIL: round trip\n\n");
+                printf("x = "); arb_printd(x, 50); printf("\n\n");
+                printf("y = "); arb_printd(y, 50); printf("\n\n");
+                abort();
+            }
+        }
+
+        arb_clear(x);
+        arb_clear(y);
+    }
+
+    /* vectors stored in pieces */
+    for (iter = 0; iter < 100; iter++)
+    {
+        fmpq * v, * w;
+        long i, j, n, m, got;
+        char key[16];
+
+        n = 1 + n_randint(state, 100);
+        m = n_randint(state, n + 1);
+
+        v = flint_malloc(sizeof(fmpq) * n);
+        w = flint_malloc(sizeof(fmpq) * n);
+
+        for (i = 0; i < n; i++)
+        {
+            fmpq_init(v + i);
+            fmpq_init(w + i);
+        }
+
+        for (i = 0; i < n; i++)
+            fmpq_randtest(v + i, state, 1 + n_randint(state, 300));
+
+        sprintf(key, "vec%ld", iter);
+        _arb_disk_cache_store_fmpq_vec(key, v, 0, m);
+        _arb_disk_cache_store_fmpq_vec(key, v + m, m, n);
+
+        if (iter % 2)
+            arb_disk_cache_set_path(TMPFILE);
+
+        got = _arb_disk_cache_load_fmpq_vec(w, key, 0, n);
+
+        for (j = 0; j < n && got == n; j++)
+            if (!fmpq_equal(v + j, w + j))
+                got = -1;
+
+        if (got != n)
+        {
+            printf("FAIL: vector (n = %ld, m = %ld, got = %ld)\n\n", n, m, got);
+            abort();
+        }
+
+        /* load from the middle */
+        i = n_randint(state, n);
+        got = _arb_disk_cache_load_fmpq_vec(w + i, key, i, n);
+
+        for (j = i; j < n && got == n; j++)
+            if (!fmpq_equal(v + j, w + j))
+                got = -1;
+
+        if (got != n)
+        {
+            printf("FAIL: vector offset\n\n");
+            abort();
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            fmpq_clear(v + i);
+            fmpq_clear(w + i);
+        }
+
+        flint_free(v);
+        flint_free(w);
+    }
+
+    /* Bernoulli numbers read back from the file */
+    {
+        long n = 2 * ARB_DISK_CACHE_MIN_BERNOULLI;
+        fmpq_t b;
+
+        flint_cleanup();
+        bernoulli_cache_compute(n);
+        flint_cleanup();
+        bernoulli_cache_compute(n);
+
+        fmpq_init(b);
+
+        for (iter = 0; iter < n; iter += 37)
+        {
+            arith_bernoulli_number(b, iter);
+
+            if (!fmpq_equal(b, bernoulli_cache + iter))
+            {
+                printf("FAIL: bernoulli %ld\n\n", iter);
+                abort();
+            }
+        }
+
+        fmpq_clear(b);
+    }
+
+    /* a damaged payload is rejected */
+    {
+        arb_t x, y;
+        long prec2, size;
+        int c;
+        FILE * fp;
+
+        arb_init(x);
+        arb_init(y);
+
+        arb_disk_cache_set_path(TMPFILE);
+        arb_const_pi(x, 5000);
+        _arb_disk_cache_store_arb("damaged", x, 5000);
+
+        fp = fopen(TMPFILE, "r+b");
+        fseek(fp, 0, SEEK_END);
+        size = ftell(fp);
+        fseek(fp, size - 100, SEEK_SET);
+        c = fgetc(fp);
+        fseek(fp, size - 100, SEEK_SET);
+        fputc(c ^ 1, fp);
+        fclose(fp);
+
+        arb_disk_cache_set_path(TMPFILE);
+
+        if (_arb_disk_cache_load_arb(y, &prec2, "damaged", 2))
+        {
+            printf("FAIL: damaged record\n\n");
+            abort();
+        }
+
+        arb_clear(x);
+        arb_clear(y);
+    }
+
+    /* a foreign file is neither read nor written */
+    {
+        arb_t x;
+        long prec2;
+        FILE * fp;
+
+        arb_init(x);
+
+        fp = fopen(TMPFILE, "wb");
+        fprintf(fp, "not a cache file\n");
+        fclose(fp);
+
+        arb_disk_cache_set_path(TMPFILE);
+        arb_one(x);
+        _arb_disk_cache_store_arb("one", x, 100);
+
+        if (_arb_disk_cache_load_arb(x, &prec2, "one", 2))
+        {
+            printf("FAIL: foreign file\n\n");
+            abort();
+        }
+
+        arb_clear(x);
+    }
+
+    arb_disk_cache_set_path(NULL);
+    remove(TMPFILE);
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("dot....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100000; iter++)
+    {
+        arb_ptr x, y;
+        arb_t s, res;
+        fmpq * xq, * yq;
+        fmpq_t sq, t;
+        long i, len, prec, xstep, ystep, mag_bits;
+        int initial, subtract, alias, cancel;
+
+        len = n_randint(state, 30);
+        prec = 2 + n_randint(state, 300);
+        mag_bits = 1 + n_randint(state, 20);
+        if (n_randint(state, 8) == 0)
+            prec = ARF_PREC_EXACT;
+        initial = n_randint(state, 2);
+        subtract = n_randint(state, 2);
+        alias = initial && n_randint(state, 2);
+        cancel = 0;
+
+        x = _arb_vec_init(len);
+        y = _arb_vec_init(len);
+        xq = _fmpq_vec_init(len);
+        yq = _fmpq_vec_init(len);
+        arb_init(s);
+        arb_init(res);
+        fmpq_init(sq);
+        fmpq_init(t);
+
+        for (i = 0; i < len; i++)
+        {
+            if (n_randint(state, 2))
+                arb_randtest(x + i, state, 1 + n_randint(state, 400), mag_bits);
+            else
+                arb_randtest_exact(x + i, state, 1 + n_randint(state, 400), mag_bits);
+
+            if (n_randint(state, 2))
+                arb_randtest(y + i, state, 1 + n_randint(state, 400), mag_bits);
+            else
+                arb_randtest_exact(y + i, state, 1 + n_randint(state, 400), mag_bits);
+
+            /* force some cancellation */
+            if (i > 0 && n_randint(state, 4) == 0)
+            {
+                arb_neg(x + i, x + i - 1);
+                arb_set(y + i, y + i - 1);
+                cancel = 1;
+            }
+
+            arb_get_rand_fmpq(xq + i, state, x + i, 1 + n_randint(state, 200));
+            arb_get_rand_fmpq(yq + i, state, y + i, 1 + n_randint(state, 200));
+        }
+
+        arb_randtest(s, state, 1 + n_randint(state, 400), mag_bits);
+        arb_get_rand_fmpq(sq, state, s, 1 + n_randint(state, 200));
+
+        xstep = n_randint(state, 2) ? 1 : -1;
+        ystep = n_randint(state, 2) ? 1 : -1;
+
+        /* exact value, with the entries visited in stride order */
+        fmpq_zero(t);
+        for (i = 0; i < len; i++)
+            fmpq_addmul(t, xq + ((xstep == 1) ? i : len - 1 - i),
+                           yq + ((ystep == 1) ? i : len - 1 - i));
+        if (subtract)
+            fmpq_neg(t, t);
+        if (initial)
+            fmpq_add(t, t, sq);
+
+        if (alias)
+        {
+            arb_dot(s, s, subtract,
+                (xstep == 1) ? x : x + len - 1, xstep,
+                (ystep == 1) ? y : y + len - 1, ystep, len, prec);
+            arb_swap(res, s);
+        }
+        else
+        {
+            arb_dot(res, initial ? s : NULL, subtract,
+                (xstep == 1) ? x : x + len - 1, xstep,
+                (ystep == 1) ? y : y + len - 1, ystep, len, prec);
+        }
+
+        if (!arb_contains_fmpq(res, t))
+        {
+            printf("FAIL: containment\n\n");
+            printf("len = %ld, prec = %ld, initial = %d, subtract = %d\n\n",
+                len, prec, initial, subtract);
+            for (i = 0; i < len; i++)
+            {
+                printf("x[%ld] = ", i); arb_printd(x + i, 30); printf("\n");
+                printf("y[%ld] = ", i); arb_printd(y + i, 30); printf("\n");
+            }
+            printf("\nres = "); arb_printd(res, 30); printf("\n\n");
+            printf("t = "); fmpq_print(t); printf("\n\n");
+            abort();
+        }
+
+        /* no cancellation: the result must be accurate to about prec bits */
+        if (!initial && !cancel && !arb_is_zero(res))
+        {
+            int ok = 1;
+
+            for (i = 0; i < len && ok; i++)
+                ok = arb_is_exact(x + i) && arb_is_exact(y + i) &&
+                    arf_sgn(arb_midref(x + i)) * arf_sgn(arb_midref(y + i)) >= 0;
+
+            if (ok && arb_rel_accuracy_bits(res) < prec - 3)
+            {
+                printf("FAIL: accuracy\n\n");
+                printf("len = %ld, prec = %ld\n\n", len, prec);
+                printf("res = "); arb_printd(res, 30); printf("\n\n");
+                abort();
+            }
+        }
+
+        _arb_vec_clear(x, len);
+        _arb_vec_clear(y, len);
+        _fmpq_vec_clear(xq, len);
+        _fmpq_vec_clear(yq, len);
+        arb_clear(s);
+        arb_clear(res);
+        fmpq_clear(sq);
+        fmpq_clear(t);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+
+arb_srcptr _arb_gamma_stirling_coeffs(long nterms, int digamma, long prec);
+void arb_gamma_stirling_coeff(arb_t b, ulong k, int digamma, long prec);
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("gamma_stirling_coeffs....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000; iter++)
+    {
+        arb_srcptr c;
+        arb_t b;
+        long k, nterms, prec;
+        int digamma;
+
+        arb_init(b);
+
+        nterms = 1 + n_randint(state, 300);
+        /* a few precisions, so that tables are both reused and evicted */
+        prec = (n_randint(state, 2) == 0) ? 2 + n_randint(state, 1000) :
+            64 * (1 + n_randint(state, 6));
+        digamma = n_randint(state, 2);
+
+        c = _arb_gamma_stirling_coeffs(nterms, digamma, prec);
+
+        for (k = 1; k < nterms; k += 1 + n_randint(state, 10))
+        {
+            arb_gamma_stirling_coeff(b, k, digamma, prec + 20);
+
+            if (!arb_overlaps(b, c + k) || arb_rel_accuracy_bits(c + k) < prec - 2)
+            {
+                printf("FAIL\n\n");
+                printf("digamma = %d, nterms = %ld, prec = %ld, k = %ld\n\n",
+                    digamma, nterms, prec, k);
+                printf("b = "); arb_printd(b, 30); printf("\n\n");
+                printf("c = "); arb_printd(c + k, 30); printf("\n\n");
+                abort();
+            }
+
+            /* the cached value must not depend on earlier calls */
+            arb_gamma_stirling_coeff(b, k, digamma, prec);
+
+            if (!arb_equal(b, c + k))
+            {
+                printf("FAIL (history)\n\n");
+                printf("digamma = %d, nterms = %ld, prec = %ld, k = %ld\n\n",
+                    digamma, nterms, prec, k);
+                printf("b = "); arb_printd(b, 30); printf("\n\n");
+                printf("c = "); arb_printd(c + k, 30); printf("\n\n");
+                abort();
+            }
+        }
+
+        arb_clear(b);
+
+        if (iter % 100 == 99)
+            flint_cleanup();
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,219 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("tab2_runtime....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* the tables must agree with the static tables, on both sides of
+       every band boundary */
+    {
+        mp_srcptr tab21, tab22, c;
+        mp_size_t n, tabn;
+        long b, i, k;
+
+        for (b = -1; b <= ARB_TAB2_RUNTIME_BANDS + 2; b++)
+        {
+            for (k = 0; k < 2; k++)
+            {
+                if (b == -1)
+                    n = 1;
+                else
+                    n = (ARB_EXP_TAB2_LIMBS << b) + k;
+
+                if (_arb_tab2_table(&tab21, &tab22, &tabn, ARB_TAB2_EXP, n)
+                    != (n <= (ARB_EXP_TAB2_LIMBS << ARB_TAB2_RUNTIME_BANDS)))
+                {
+                    printf("FAIL (exp table range)\n");
+                    printf("n = %ld\n", n);
+                    abort();
+                }
+
+                if (n <= (ARB_EXP_TAB2_LIMBS << ARB_TAB2_RUNTIME_BANDS))
+                {
+                    if (tabn < n || tabn < ARB_EXP_TAB2_LIMBS)
+                    {
+                        printf("FAIL (exp table size)\n");
+                        printf("n = %ld, tabn = %ld\n", n, tabn);
+                        abort();
+                    }
+
+                    for (i = 0; i < ARB_EXP_TAB21_NUM + ARB_EXP_TAB22_NUM; i++)
+                    {
+                        if (i < ARB_EXP_TAB21_NUM)
+                            c = tab21 + i * tabn;
+                        else
+                            c = tab22 + (i - ARB_EXP_TAB21_NUM) * tabn;
+
+                        if (mpn_cmp(c + tabn - ARB_EXP_TAB2_LIMBS,
+                            (i < ARB_EXP_TAB21_NUM) ? arb_exp_tab21[i] :
+                                arb_exp_tab22[i - ARB_EXP_TAB21_NUM],
+                            ARB_EXP_TAB2_LIMBS) != 0)
+                        {
+                            printf("FAIL (exp table)\n");
+                            printf("n = %ld, i = %ld\n", n, i);
+                            abort();
+                        }
+                    }
+                }
+
+                if (_arb_tab2_table(&tab21, &tab22, &tabn, ARB_TAB2_SIN_COS, n)
+                    != (n <= (ARB_EXP_TAB2_LIMBS << ARB_TAB2_RUNTIME_BANDS)))
+                {
+                    printf("FAIL (sin_cos table range)\n");
+                    printf("n = %ld\n", n);
+                    abort();
+                }
+
+                if (n <= (ARB_EXP_TAB2_LIMBS << ARB_TAB2_RUNTIME_BANDS))
+                {
+                    if (tabn < n || tabn < ARB_SIN_COS_TAB2_LIMBS)
+                    {
+                        printf("FAIL (sin_cos table size)\n");
+                        printf("n = %ld, tabn = %ld\n", n, tabn);
+                        abort();
+                    }
+
+                    for (i = 0; i < 2 * (ARB_SIN_COS_TAB21_NUM +
+                        ARB_SIN_COS_TAB22_NUM); i++)
+                    {
+                        if (i < 2 * ARB_SIN_COS_TAB21_NUM)
+                            c = tab21 + i * tabn;
+                        else
+                            c = tab22 + (i - 2 * ARB_SIN_COS_TAB21_NUM) * tabn;
+
+                        if (mpn_cmp(c + tabn - ARB_SIN_COS_TAB2_LIMBS,
+                            (i < 2 * ARB_SIN_COS_TAB21_NUM) ?
+                                arb_sin_cos_tab21[i] :
+                                arb_sin_cos_tab22[i - 2 * ARB_SIN_COS_TAB21_NUM],
+                            ARB_SIN_COS_TAB2_LIMBS) != 0)
+                        {
+                            printf("FAIL (sin_cos table)\n");
+                            printf("n = %ld, i = %ld\n", n, i);
+                            abort();
+                        }
+                    }
+                }
+
+                if (n < ARB_LOG_TAB2_LIMBS)
+                    continue;
+
+                c = _arb_tab2_const(ARB_TAB2_LOG2, n);
+
+                if (c != NULL && mpn_cmp(c + n - ARB_LOG_TAB2_LIMBS,
+                    arb_log_log2_tab, ARB_LOG_TAB2_LIMBS) != 0)
+                {
+                    printf("FAIL (log2)\n");
+                    printf("n = %ld\n", n);
+                    abort();
+                }
+
+                c = _arb_tab2_const(ARB_TAB2_PI4, n);
+
+                if (c != NULL && mpn_cmp(c + n - ARB_PI4_TAB_LIMBS,
+                    arb_pi4_tab, ARB_PI4_TAB_LIMBS) != 0)
+                {
+                    printf("FAIL (pi4)\n");
+                    printf("n = %ld\n", n);
+                    abort();
+                }
+            }
+        }
+    }
+
+    /* exp and sin_cos using the runtime tables */
+    for (iter = 0; iter < 200; iter++)
+    {
+        arb_t x, y, z, s, c;
+        long prec;
+
+        arb_init(x);
+        arb_init(y);
+        arb_init(z);
+        arb_init(s);
+        arb_init(c);
+
+        /* up to the largest band, where the reduced argument is halved
+           more than FLINT_BITS times */
+        prec = ARB_EXP_TAB2_PREC +
+            n_randint(state, ARB_TAB2_RUNTIME_PREC - ARB_EXP_TAB2_PREC);
+
+        arb_randtest(x, state, 1 + n_randint(state, prec), 4);
+        mag_zero(arb_radref(x));
+
+        arb_exp(y, x, prec);
+        arb_exp_arf_bb(z, arb_midref(x), prec, 0);
+
+        if (!arb_overlaps(y, z) ||
+            (!arb_is_zero(x) && arb_rel_accuracy_bits(y) < prec - 10))
+        {
+            printf("FAIL (exp)\n");
+            printf("prec = %ld\n", prec);
+            printf("x = "); arb_printd(x, 50); printf("\n\n");
+            printf("y = "); arb_printd(y, 50); printf("\n\n");
+            printf("z = "); arb_printd(z, 50); printf("\n\n");
+            abort();
+        }
+
+        arb_sin_cos(s, c, x, prec);
+        arb_mul(y, s, s, prec);
+        arb_addmul(y, c, c, prec);
+        arb_sin(z, x, prec + 100);
+
+        if (!arb_contains_si(y, 1) || !arb_overlaps(s, z) ||
+            (!arb_is_zero(x) && arb_rel_accuracy_bits(c) < prec - 10))
+        {
+            printf("FAIL (sin_cos)\n");
+            printf("prec = %ld\n", prec);
+            printf("x = "); arb_printd(x, 50); printf("\n\n");
+            printf("s = "); arb_printd(s, 50); printf("\n\n");
+            printf("c = "); arb_printd(c, 50); printf("\n\n");
+            printf("z = "); arb_printd(z, 50); printf("\n\n");
+            abort();
+        }
+
+        arb_clear(x);
+        arb_clear(y);
+        arb_clear(z);
+        arb_clear(s);
+        arb_clear(c);
+    }
+
+    _arb_tab2_clear();
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,104 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("vec_gamma....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 2000; iter++)
+    {
+        arb_ptr x, y, z, w;
+        long i, len, prec;
+        int lgamma;
+
+        /* the result must not depend on the number of threads, or on
+           which precisions each thread has used before */
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        len = n_randint(state, 30);
+        prec = 2 + n_randint(state, (iter % 10 == 0) ? 2000 : 600);
+        lgamma = n_randint(state, 2);
+
+        x = _arb_vec_init(len);
+        y = _arb_vec_init(len);
+        z = _arb_vec_init(len);
+        w = _arb_vec_init(len);
+
+        for (i = 0; i < len; i++)
+            arb_randtest(x + i, state, 1 + n_randint(state, 1000), 1 + n_randint(state, 10));
+
+        if (lgamma)
+            _arb_vec_lgamma(y, x, len, prec);
+        else
+            _arb_vec_gamma(y, x, len, prec);
+
+        /* aliasing */
+        _arb_vec_set(z, x, len);
+
+        if (lgamma)
+            _arb_vec_lgamma(z, z, len, prec);
+        else
+            _arb_vec_gamma(z, z, len, prec);
+
+        for (i = 0; i < len; i++)
+        {
+            if (lgamma)
+                arb_lgamma(w + i, x + i, prec);
+            else
+                arb_gamma(w + i, x + i, prec);
+
+            if (!arb_equal(y + i, w + i) || !arb_equal(z + i, w + i))
+            {
+                printf("FAIL\n\n");
+                printf("lgamma = %d, prec = %ld, len = %ld, i = %ld, threads = %d\n\n",
+                    lgamma, prec, len, i, flint_get_num_threads());
+                printf("x = "); arb_printd(x + i, 30); printf("\n\n");
+                printf("y = "); arb_printd(y + i, 30); printf("\n\n");
+                printf("z = "); arb_printd(z + i, 30); printf("\n\n");
+                printf("w = "); arb_printd(w + i, 30); printf("\n\n");
+                abort();
+            }
+        }
+
+        _arb_vec_clear(x, len);
+        _arb_vec_clear(y, len);
+        _arb_vec_clear(z, len);
+        _arb_vec_clear(w, len);
+    }
+
+    flint_set_num_threads(1);
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
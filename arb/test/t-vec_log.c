@@ -0,0 +1,97 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("vec_log....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000; iter++)
+    {
+        arb_ptr x, y, z, w;
+        long i, len, prec;
+
+        len = n_randint(state, 60);
+        prec = 2 + n_randint(state, (iter % 10 == 0) ? 2000 : 600);
+
+        x = _arb_vec_init(len);
+        y = _arb_vec_init(len);
+        z = _arb_vec_init(len);
+        w = _arb_vec_init(len);
+
+        for (i = 0; i < len; i++)
+        {
+            if (n_randint(state, 10) == 0)
+                arb_randtest_special(x + i, state, 1 + n_randint(state, 1000), 1 + n_randint(state, 100));
+            else
+                arb_randtest(x + i, state, 1 + n_randint(state, 1000), 1 + n_randint(state, 8));
+
+            if (n_randint(state, 2))
+                mag_zero(arb_radref(x + i));
+        }
+
+        _arb_vec_log(y, x, len, prec);
+
+        /* aliasing */
+        _arb_vec_set(z, x, len);
+        _arb_vec_log(z, z, len, prec);
+
+        for (i = 0; i < len; i++)
+        {
+            arb_log(w + i, x + i, prec);
+
+            if (!arb_overlaps(y + i, w + i) || !arb_equal(y + i, z + i) ||
+                (arb_is_exact(x + i) && arb_is_finite(w + i) &&
+                    arb_rel_accuracy_bits(y + i) < arb_rel_accuracy_bits(w + i) - 2))
+            {
+                printf("FAIL\n\n");
+                printf("prec = %ld, len = %ld, i = %ld\n\n", prec, len, i);
+                printf("x = "); arb_printd(x + i, 30); printf("\n\n");
+                printf("y = "); arb_printd(y + i, 30); printf("\n\n");
+                printf("z = "); arb_printd(z + i, 30); printf("\n\n");
+                printf("w = "); arb_printd(w + i, 30); printf("\n\n");
+                abort();
+            }
+        }
+
+        _arb_vec_clear(x, len);
+        _arb_vec_clear(y, len);
+        _arb_vec_clear(z, len);
+        _arb_vec_clear(w, len);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
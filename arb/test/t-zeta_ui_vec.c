@@ -50,6 +50,7 @@ int main()
 
         do { n = n_randint(state, 1 << n_randint(state, 10)); } while (n < 2);
 
+        flint_set_num_threads(1 + n_randint(state, 4));
         arb_zeta_ui_vec(r, n, num, prec);
 
         for (i = 0; i < num; i++)
@@ -51,6 +51,7 @@ int main()
 
         do { n = n_randint(state, 1 << n_randint(state, 10)); } while (n < 2);
 
+        flint_set_num_threads(1 + n_randint(state, 4));
         arb_zeta_ui_vec_borwein(r, n, num, step, prec);
 
         for (i = 0; i < num; i++)
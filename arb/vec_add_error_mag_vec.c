@@ -0,0 +1,52 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+
+void
+_arb_vec_add_error_mag_vec(arb_ptr res, mag_srcptr err, long len)
+{
+    mag_ptr r;
+    long i;
+    TMP_INIT;
+
+    if (len < 1)
+        return;
+
+    /* move the radii into a contiguous array and back */
+    TMP_START;
+    r = TMP_ALLOC(sizeof(mag_struct) * len);
+
+    for (i = 0; i < len; i++)
+        r[i] = *arb_radref(res + i);
+
+    _mag_vec_add(r, r, err, len);
+
+    for (i = 0; i < len; i++)
+        *arb_radref(res + i) = r[i];
+
+    TMP_END;
+}
+
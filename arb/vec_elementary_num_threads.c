@@ -0,0 +1,51 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+
+/* The work is estimated as the number of evaluations times the
+   square of the number of limbs (plus overhead), weighted by the
+   rough number of multiplications in one evaluation. */
+long
+_arb_vec_elementary_num_threads(long len, long prec)
+{
+    double work, limbs;
+    long num_threads;
+
+    num_threads = flint_get_num_threads();
+
+    if (num_threads <= 1 || len < 2 * ARB_VEC_ELEMENTARY_BATCH)
+        return 1;
+
+    limbs = (prec + FLINT_BITS - 1) / FLINT_BITS + 2;
+
+    work = 32.0 * (double) len * limbs * limbs;
+    work /= ARB_VEC_ELEMENTARY_THREAD_WORK;
+
+    if (work < num_threads)
+        num_threads = FLINT_MAX(1, (long) work);
+
+    return FLINT_MIN(num_threads, len / ARB_VEC_ELEMENTARY_BATCH);
+}
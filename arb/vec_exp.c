@@ -0,0 +1,215 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+#include "arb_thread_pool.h"
+
+#define TMP_ALLOC_LIMBS(__n) TMP_ALLOC((__n) * sizeof(mp_limb_t))
+
+int _arf_set_mpn_fixed(arf_t z, mp_srcptr xp, mp_size_t xn, mp_size_t fixn, int negative, long prec);
+
+/*
+    Computes exp of up to ARB_VEC_ELEMENTARY_BATCH entries. Entries with a
+    moderate exact midpoint and a small radius go through the same steps as
+    arb_exp at precision up to ARB_EXP_TAB1_PREC, except that the Taylor
+    series is evaluated for all of them at once with a common number of terms
+    (chosen for the largest reduced argument). Other entries use arb_exp.
+*/
+static void
+_arb_vec_exp_batch(arb_ptr res, arb_srcptr x, long len, long prec)
+{
+    long wp, wn, wprounded, i, j, num, N, r, rmin, exp;
+    mp_ptr w, t, u, finalvalue;
+    mp_limb_t error2;
+    mp_size_t finaln;
+    long lane[ARB_VEC_ELEMENTARY_BATCH];
+    mp_limb_t error[ARB_VEC_ELEMENTARY_BATCH];
+    mp_limb_t p1[ARB_VEC_ELEMENTARY_BATCH];
+    fmpz n[ARB_VEC_ELEMENTARY_BATCH];
+    mag_struct rad[ARB_VEC_ELEMENTARY_BATCH];
+    mag_t v, z;
+    TMP_INIT;
+
+    wp = prec + 8;
+    wn = (wp + FLINT_BITS - 1) / FLINT_BITS;
+    wprounded = FLINT_BITS * wn;
+    wp = FLINT_MAX(wp, wprounded - (FLINT_BITS - 4));
+
+    if (wp > ARB_EXP_TAB1_PREC || len < 2)
+    {
+        for (i = 0; i < len; i++)
+            arb_exp(res + i, x + i, prec);
+        return;
+    }
+
+    TMP_START;
+
+    w = TMP_ALLOC_LIMBS(len * wn);
+    t = TMP_ALLOC_LIMBS(len * (wn + 1));
+    u = TMP_ALLOC_LIMBS(2 * wn + 1);
+
+    num = 0;
+    rmin = wprounded;
+
+    /* Reduce the arguments; entries not handled here are computed
+       directly (this is safe with aliasing, since each output only
+       depends on the corresponding input). */
+    for (i = 0; i < len; i++)
+    {
+        arf_srcptr m = arb_midref(x + i);
+
+        if (arf_is_special(m) || !MAG_IS_LAGOM(arb_radref(x + i)) ||
+            mag_cmp_2exp_si(arb_radref(x + i), 20) >= 0 ||
+            COEFF_IS_MPZ(ARF_EXP(m)))
+        {
+            arb_exp(res + i, x + i, prec);
+            continue;
+        }
+
+        exp = ARF_EXP(m);
+
+        if (exp < -(prec / 2) - 4 || exp > FLINT_BITS - 4)
+        {
+            arb_exp(res + i, x + i, prec);
+            continue;
+        }
+
+        fmpz_init(n + num);
+
+        if (_arb_get_mpn_fixed_mod_log2(w + num * wn, n + num,
+            error + num, m, wn) == 0)
+        {
+            fmpz_clear(n + num);
+            arb_exp(res + i, x + i, prec);
+            continue;
+        }
+
+        /* err(w) translates to a propagated error bounded by
+           err(w) * exp'(x) < err(w) * exp(1) < err(w) * 3 */
+        error[num] *= 3;
+
+        p1[num] = w[num * wn + wn - 1] >> (FLINT_BITS - ARB_EXP_TAB1_BITS);
+        w[num * wn + wn - 1] -= (p1[num] << (FLINT_BITS - ARB_EXP_TAB1_BITS));
+
+        r = _arb_mpn_leading_zeros(w + num * wn, wn);
+        rmin = FLINT_MIN(rmin, r);
+
+        mag_init_set(rad + num, arb_radref(x + i));
+        lane[num] = i;
+        num++;
+    }
+
+    if (num != 0)
+    {
+        N = _arb_exp_taylor_bound(-rmin, wp);
+        _arb_exp_taylor_rs_vec(t, &error2, w, wn, N, num);
+
+        mag_init(v);
+        mag_init(z);
+
+        for (j = 0; j < num; j++)
+        {
+            arb_ptr y = res + lane[j];
+            mp_ptr tj = t + j * (wn + 1);
+
+            error[j] += error2;
+            error[j] += 1UL << (wprounded - wp);
+
+            if (p1[j] == 0)
+            {
+                finalvalue = tj;
+                finaln = wn + 1;
+            }
+            else
+            {
+                /* see arb_exp_arf */
+                mpn_rshift(tj, tj, wn + 1, 1);
+                error[j] = (error[j] >> 1) + 2;
+
+                mpn_mul_n(u, tj, arb_exp_tab1[p1[j]] + ARB_EXP_TAB1_LIMBS - wn, wn);
+                error[j] += 4;
+
+                finalvalue = u + wn;
+                finaln = wn;
+                fmpz_add_ui(n + j, n + j, 2);
+            }
+
+            mag_set_ui_2exp_si(arb_radref(y), error[j], -wprounded);
+
+            if (_arf_set_mpn_fixed(arb_midref(y), finalvalue, finaln, wn, 0, prec))
+                arf_mag_add_ulp(arb_radref(y), arb_radref(y), arb_midref(y), prec);
+
+            arb_mul_2exp_fmpz(y, y, n + j);
+
+            /* exp(a+b) - exp(a) = exp(a) * (exp(b)-1) */
+            if (!mag_is_zero(rad + j))
+            {
+                mag_expm1(v, rad + j);
+                arb_get_mag(z, y);
+                mag_addmul(arb_radref(y), v, z);
+            }
+
+            fmpz_clear(n + j);
+            mag_clear(rad + j);
+        }
+
+        mag_clear(v);
+        mag_clear(z);
+    }
+
+    TMP_END;
+}
+
+typedef struct
+{
+    arb_ptr res;
+    arb_srcptr x;
+    long prec;
+}
+_arb_vec_exp_arg_t;
+
+static void
+_arb_vec_exp_worker(void * arg_ptr, long a, long b)
+{
+    _arb_vec_exp_arg_t * arg = arg_ptr;
+    long i;
+
+    for (i = a; i < b; i += ARB_VEC_ELEMENTARY_BATCH)
+        _arb_vec_exp_batch(arg->res + i, arg->x + i,
+            FLINT_MIN(ARB_VEC_ELEMENTARY_BATCH, b - i), arg->prec);
+}
+
+void
+_arb_vec_exp(arb_ptr res, arb_srcptr x, long len, long prec)
+{
+    _arb_vec_exp_arg_t arg;
+
+    arg.res = res;
+    arg.x = x;
+    arg.prec = prec;
+
+    arb_thread_pool_parallel_chunks(_arb_vec_exp_worker, &arg, len,
+        _arb_vec_elementary_num_threads(len, prec));
+}
@@ -0,0 +1,106 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+#include "arb_thread_pool.h"
+
+/* The work is estimated as the number of evaluations times the
+   rough number of multiplications in one evaluation (the rising
+   factorial and the Stirling series each need O(prec) of them)
+   times the square of the number of limbs; a complex evaluation
+   counts as four real ones. */
+long
+_arb_vec_gamma_num_threads(long len, long prec, int is_complex)
+{
+    double work, limbs;
+    long num_threads;
+
+    num_threads = flint_get_num_threads();
+
+    if (num_threads <= 1 || len < 2)
+        return 1;
+
+    limbs = (prec + FLINT_BITS - 1) / FLINT_BITS + 2;
+
+    work = (double) len * (0.25 * prec + 40.0) * limbs * limbs;
+    if (is_complex)
+        work *= 4.0;
+    work /= ARB_VEC_GAMMA_THREAD_WORK;
+
+    if (work < num_threads)
+        num_threads = FLINT_MAX(1, (long) work);
+
+    return FLINT_MIN(num_threads, len);
+}
+
+typedef void (*_arb_vec_gamma_func_t)(arb_t, const arb_t, long);
+
+typedef struct
+{
+    _arb_vec_gamma_func_t func;
+    arb_ptr res;
+    arb_srcptr x;
+    long prec;
+}
+_arb_vec_gamma_arg_t;
+
+static void
+_arb_vec_gamma_worker(void * arg_ptr, long a, long b)
+{
+    _arb_vec_gamma_arg_t * arg = arg_ptr;
+    long i;
+
+    for (i = a; i < b; i++)
+        arg->func(arg->res + i, arg->x + i, arg->prec);
+}
+
+/* The points are split into contiguous chunks, so that each thread
+   reuses its table of Stirling coefficients for many points. */
+static void
+_arb_vec_gamma_generic(_arb_vec_gamma_func_t func,
+    arb_ptr res, arb_srcptr x, long len, long prec)
+{
+    _arb_vec_gamma_arg_t arg;
+
+    arg.func = func;
+    arg.res = res;
+    arg.x = x;
+    arg.prec = prec;
+
+    arb_thread_pool_parallel_chunks(_arb_vec_gamma_worker, &arg, len,
+        _arb_vec_gamma_num_threads(len, prec, 0));
+}
+
+void
+_arb_vec_gamma(arb_ptr res, arb_srcptr x, long len, long prec)
+{
+    _arb_vec_gamma_generic(arb_gamma, res, x, len, prec);
+}
+
+void
+_arb_vec_lgamma(arb_ptr res, arb_srcptr x, long len, long prec)
+{
+    _arb_vec_gamma_generic(arb_lgamma, res, x, len, prec);
+}
@@ -0,0 +1,59 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+
+void
+_arb_vec_get_mag(mag_t bound, arb_srcptr vec, long len)
+{
+    mag_ptr t, r;
+    long i;
+    TMP_INIT;
+
+    if (len < 1)
+    {
+        mag_zero(bound);
+        return;
+    }
+
+    /* |mid| + rad for all entries at once, using shallow
+       copies of the radii */
+    TMP_START;
+    r = TMP_ALLOC(sizeof(mag_struct) * len);
+    t = _mag_vec_init(len);
+
+    for (i = 0; i < len; i++)
+    {
+        arf_get_mag(t + i, arb_midref(vec + i));
+        r[i] = *arb_radref(vec + i);
+    }
+
+    _mag_vec_add(t, t, r, len);
+    _mag_vec_max(bound, t, len);
+
+    _mag_vec_clear(t, len);
+    TMP_END;
+}
+
@@ -0,0 +1,58 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+#include "arb_thread_pool.h"
+
+typedef struct
+{
+    arb_ptr res;
+    arb_srcptr x;
+    long prec;
+}
+_arb_vec_log_arg_t;
+
+static void
+_arb_vec_log_worker(void * arg_ptr, long a, long b)
+{
+    _arb_vec_log_arg_t * arg = arg_ptr;
+    long i;
+
+    for (i = a; i < b; i++)
+        arb_log(arg->res + i, arg->x + i, arg->prec);
+}
+
+void
+_arb_vec_log(arb_ptr res, arb_srcptr x, long len, long prec)
+{
+    _arb_vec_log_arg_t arg;
+
+    arg.res = res;
+    arg.x = x;
+    arg.prec = prec;
+
+    arb_thread_pool_parallel_chunks(_arb_vec_log_worker, &arg, len,
+        _arb_vec_elementary_num_threads(len, prec));
+}
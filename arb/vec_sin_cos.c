@@ -0,0 +1,279 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb.h"
+#include "arb_thread_pool.h"
+
+#define TMP_ALLOC_LIMBS(__n) TMP_ALLOC((__n) * sizeof(mp_limb_t))
+
+int _arf_set_mpn_fixed(arf_t z, mp_srcptr xp, mp_size_t xn, mp_size_t fixn, int negative, long prec);
+
+/*
+    Computes sin and cos of up to ARB_VEC_ELEMENTARY_BATCH entries. Entries
+    with a moderate midpoint go through the same steps as arb_sin_cos at
+    precision up to ARB_SIN_COS_TAB1_PREC, except that the Taylor series is
+    evaluated for all of them at once, with a common working precision
+    and number of terms. Other entries use arb_sin_cos.
+*/
+static void
+_arb_vec_sin_cos_batch(arb_ptr s, arb_ptr c, arb_srcptr x, long len, long prec)
+{
+    long wp, wn, wprounded, i, j, num, N, r, rmin, exp, extra;
+    mp_ptr w, sina, cosa, ta, tb, sinptr, cosptr;
+    mp_srcptr sinc, cosc;
+    mp_limb_t error2;
+    long lane[ARB_VEC_ELEMENTARY_BATCH];
+    mp_limb_t error[ARB_VEC_ELEMENTARY_BATCH];
+    mp_limb_t p1[ARB_VEC_ELEMENTARY_BATCH];
+    int octant[ARB_VEC_ELEMENTARY_BATCH];
+    mag_struct rad[ARB_VEC_ELEMENTARY_BATCH];
+    int fast[ARB_VEC_ELEMENTARY_BATCH];
+    int sinnegative, cosnegative;
+    TMP_INIT;
+
+    if (len < 2 || prec > ARB_SIN_COS_TAB1_PREC)
+    {
+        for (i = 0; i < len; i++)
+            arb_sin_cos(s + i, c + i, x + i, prec);
+        return;
+    }
+
+    /* The working precision depends on the smallest exponent,
+       so find the entries to handle here first. */
+    extra = 0;
+    num = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        arf_srcptr m = arb_midref(x + i);
+
+        fast[i] = 0;
+
+        if (arf_is_special(m) || !MAG_IS_LAGOM(arb_radref(x + i)) ||
+            COEFF_IS_MPZ(ARF_EXP(m)))
+            continue;
+
+        exp = ARF_EXP(m);
+
+        if (exp < FLINT_MAX(-(prec / 2) - 2, -FLINT_BITS) ||
+            exp > FLINT_BITS - 4)
+            continue;
+
+        fast[i] = 1;
+        extra = FLINT_MAX(extra, -exp);
+        num++;
+    }
+
+    wp = prec + 8 + extra;
+    wn = (wp + FLINT_BITS - 1) / FLINT_BITS;
+    wprounded = FLINT_BITS * wn;
+    wp = FLINT_MAX(wp, wprounded - (FLINT_BITS - 4));
+
+    if (num < 2 || wp > ARB_SIN_COS_TAB1_PREC)
+    {
+        for (i = 0; i < len; i++)
+            arb_sin_cos(s + i, c + i, x + i, prec);
+        return;
+    }
+
+    TMP_START;
+
+    w = TMP_ALLOC_LIMBS(3 * len * wn + 4 * wn);
+    sina = w + len * wn;
+    cosa = sina + len * wn;
+    ta = cosa + len * wn;
+    tb = ta + 2 * wn;
+
+    num = 0;
+    rmin = wprounded;
+
+    /* Reduce the arguments; entries not handled here are computed
+       directly (this is safe with aliasing, since each output only
+       depends on the corresponding input). */
+    for (i = 0; i < len; i++)
+    {
+        if (!fast[i] || _arb_get_mpn_fixed_mod_pi4(w + num * wn, NULL,
+            octant + num, error + num, arb_midref(x + i), wn) == 0)
+        {
+            arb_sin_cos(s + i, c + i, x + i, prec);
+            continue;
+        }
+
+        p1[num] = w[num * wn + wn - 1] >> (FLINT_BITS - ARB_SIN_COS_TAB1_BITS);
+        w[num * wn + wn - 1] -= (p1[num] << (FLINT_BITS - ARB_SIN_COS_TAB1_BITS));
+
+        r = _arb_mpn_leading_zeros(w + num * wn, wn);
+        rmin = FLINT_MIN(rmin, r);
+
+        /* the sign of x is stored in the octant */
+        if (ARF_SGNBIT(arb_midref(x + i)))
+            octant[num] += 8;
+
+        mag_init_set(rad + num, arb_radref(x + i));
+        lane[num] = i;
+        num++;
+    }
+
+    if (num != 0)
+    {
+        N = _arb_exp_taylor_bound(-rmin, wp);
+        N = (N + 1) / 2;
+
+        if (N < 14)
+        {
+            _arb_sin_cos_taylor_rs_vec(sina, cosa, &error2, w, wn, N, 0, 1, num);
+        }
+        else  /* Compute cos(a) from sin(a) using a square root. */
+        {
+            _arb_sin_cos_taylor_rs_vec(sina, cosa, &error2, w, wn, N, 1, 1, num);
+
+            for (j = 0; j < num; j++)
+            {
+                if (flint_mpn_zero_p(sina + j * wn, wn))
+                {
+                    flint_mpn_store(cosa + j * wn, wn, LIMB_ONES);
+                    error[j] = FLINT_MAX(error[j], 1);
+                }
+                else
+                {
+                    mpn_sqr(ta, sina + j * wn, wn);
+                    mpn_neg(ta, ta, 2 * wn);
+                    mpn_sqrtrem(cosa + j * wn, ta, ta, 2 * wn);
+                    error[j] += 1;
+                }
+            }
+        }
+
+        for (j = 0; j < num; j++)
+        {
+            arb_ptr ys = s + lane[j];
+            arb_ptr yc = c + lane[j];
+            int negative = octant[j] >= 8;
+
+            octant[j] &= 7;
+
+            sinnegative = (octant[j] >= 4) ^ negative;
+            cosnegative = (octant[j] >= 2 && octant[j] <= 5);
+
+            error[j] += error2;
+            error[j] += 1UL << (wprounded - wp);
+
+            if (p1[j] == 0)
+            {
+                sinptr = sina + j * wn;
+                cosptr = cosa + j * wn;
+            }
+            else
+            {
+                /* see arb_sin_cos_arf_new; the products are written
+                   back to the entry of w, which is no longer needed */
+                sinc = arb_sin_cos_tab1[2 * p1[j]] + ARB_SIN_COS_TAB1_LIMBS - wn;
+                cosc = arb_sin_cos_tab1[2 * p1[j] + 1] + ARB_SIN_COS_TAB1_LIMBS - wn;
+
+                mpn_mul_n(ta, sina + j * wn, cosc, wn);
+                mpn_mul_n(tb, cosa + j * wn, sinc, wn);
+                mpn_add_n(w + j * wn, ta + wn, tb + wn, wn);
+
+                mpn_mul_n(ta, cosa + j * wn, cosc, wn);
+                mpn_mul_n(tb, sina + j * wn, sinc, wn);
+                mpn_sub_n(cosa + j * wn, ta + wn, tb + wn, wn);
+
+                sinptr = w + j * wn;
+                cosptr = cosa + j * wn;
+
+                error[j] = 2 * error[j] + 2 * 1 + 3;
+            }
+
+            if (octant[j] == 1 || octant[j] == 2 ||
+                octant[j] == 5 || octant[j] == 6)
+            {
+                mp_ptr tmptr = sinptr;
+                sinptr = cosptr;
+                cosptr = tmptr;
+            }
+
+            mag_set_ui_2exp_si(arb_radref(ys), error[j], -wprounded);
+            mag_set(arb_radref(yc), arb_radref(ys));
+
+            if (_arf_set_mpn_fixed(arb_midref(ys), sinptr, wn, wn,
+                    sinnegative, prec))
+                arf_mag_add_ulp(arb_radref(ys), arb_radref(ys),
+                    arb_midref(ys), prec);
+
+            if (_arf_set_mpn_fixed(arb_midref(yc), cosptr, wn, wn,
+                    cosnegative, prec))
+                arf_mag_add_ulp(arb_radref(yc), arb_radref(yc),
+                    arb_midref(yc), prec);
+
+            /* |sin(m +/- r) - sin(m)| <= min(r, 2) */
+            if (!mag_is_zero(rad + j))
+            {
+                if (mag_cmp_2exp_si(rad + j, 1) > 0)
+                    mag_set_ui_2exp_si(rad + j, 1, 1);
+
+                mag_add(arb_radref(ys), arb_radref(ys), rad + j);
+                mag_add(arb_radref(yc), arb_radref(yc), rad + j);
+            }
+
+            mag_clear(rad + j);
+        }
+    }
+
+    TMP_END;
+}
+
+typedef struct
+{
+    arb_ptr s;
+    arb_ptr c;
+    arb_srcptr x;
+    long prec;
+}
+_arb_vec_sin_cos_arg_t;
+
+static void
+_arb_vec_sin_cos_worker(void * arg_ptr, long a, long b)
+{
+    _arb_vec_sin_cos_arg_t * arg = arg_ptr;
+    long i;
+
+    for (i = a; i < b; i += ARB_VEC_ELEMENTARY_BATCH)
+        _arb_vec_sin_cos_batch(arg->s + i, arg->c + i, arg->x + i,
+            FLINT_MIN(ARB_VEC_ELEMENTARY_BATCH, b - i), arg->prec);
+}
+
+void
+_arb_vec_sin_cos(arb_ptr s, arb_ptr c, arb_srcptr x, long len, long prec)
+{
+    _arb_vec_sin_cos_arg_t arg;
+
+    arg.s = s;
+    arg.c = c;
+    arg.x = x;
+    arg.prec = prec;
+
+    arb_thread_pool_parallel_chunks(_arb_vec_sin_cos_worker, &arg, len,
+        _arb_vec_elementary_num_threads(len, prec));
+}
@@ -27,6 +27,25 @@
 #include "arith.h"
 #include "arb.h"
 
+int
+_arb_zeta_ui_use_euler_product(ulong n, long prec)
+{
+    if (n < 6 || n > 0.7 * prec)
+        return 0;
+
+    if (n % 2 == 0)
+    {
+        return !(((prec < 10000) && (n < 40 + 0.11*prec)) ||
+            ((prec >= 10000) && (arith_bernoulli_number_size(n) * 0.9 < prec)));
+    }
+    else
+    {
+        /* small odd n at extremely high precision use binary splitting */
+        return !(n < prec * 0.0006) &&
+            (prec > 20 && n > 6 && n > 0.4 * pow(prec, 0.8));
+    }
+}
+
 void
 arb_zeta_ui(arb_t x, ulong n, long prec)
 {
@@ -44,43 +63,26 @@ arb_zeta_ui(arb_t x, ulong n, long prec)
     {
         arb_zeta_ui_asymp(x, n, prec);
     }
+    else if (_arb_zeta_ui_use_euler_product(n, prec))
+    {
+        arb_zeta_ui_euler_product(x, n, prec);
+    }
+    else if (n % 2 == 0)
+    {
+        arb_zeta_ui_bernoulli(x, n, prec);
+    }
+    else if (n == 3)
+    {
+        arb_const_apery(x, prec);
+    }
+    else if (n < prec * 0.0006)
+    {
+        /* small odd n, extremely high precision */
+        arb_zeta_ui_borwein_bsplit(x, n, prec);
+    }
     else
     {
-        /* even */
-        if (n % 2 == 0)
-        {
-            if (((prec < 10000) && (n < 40 + 0.11*prec)) ||
-                ((prec >= 10000) && (arith_bernoulli_number_size(n) * 0.9 < prec)))
-            {
-                arb_zeta_ui_bernoulli(x, n, prec);
-            }
-            else
-            {
-                arb_zeta_ui_euler_product(x, n, prec);
-            }
-        }
-        else
-        {
-            if (n == 3)
-            {
-                arb_const_apery(x, prec);
-            }
-            else if (n < prec * 0.0006)
-            {
-                /* small odd n, extremely high precision */
-                arb_zeta_ui_borwein_bsplit(x, n, prec);
-            }
-            else if (prec > 20 && n > 6 && n > 0.4 * pow(prec, 0.8))
-            {
-                /* large n */
-                arb_zeta_ui_euler_product(x, n, prec);
-            }
-            else
-            {
-                /* fallback */
-                arb_zeta_ui_vec_borwein(x, n, 1, 0, prec);
-            }
-        }
+        /* fallback */
+        arb_zeta_ui_vec_borwein(x, n, 1, 0, prec);
     }
 }
-
@@ -24,6 +24,97 @@
 ******************************************************************************/
 
 #include "arb.h"
+#include "bernoulli.h"
+#include "arb_thread_pool.h"
+
+typedef struct
+{
+    arb_ptr x;
+    const long * index;
+    ulong start;
+    ulong step;
+    long prec;
+}
+zeta_ui_arg_t;
+
+static void
+_arb_zeta_ui_vec_worker(void * args, long i)
+{
+    zeta_ui_arg_t * arg = (zeta_ui_arg_t *) args;
+    long j = arg->index[i];
+
+    arb_zeta_ui(arg->x + j, arg->start + j * arg->step, arg->prec);
+}
+
+void
+_arb_zeta_ui_vec_step(arb_ptr x, ulong start, long num, ulong step, long prec)
+{
+    zeta_ui_arg_t arg;
+    long * index;
+    long i, e0, e1, num_index, num_bernoulli, num_threads;
+    ulong n, max_bernoulli;
+
+    if (num <= 0)
+        return;
+
+    /* the entries computed with the Euler product form a contiguous run */
+    for (e0 = 0; e0 < num; e0++)
+        if (_arb_zeta_ui_use_euler_product(start + e0 * step, prec))
+            break;
+
+    for (e1 = e0; e1 < num; e1++)
+        if (!_arb_zeta_ui_use_euler_product(start + e1 * step, prec))
+            break;
+
+    arb_zeta_ui_vec_euler_product(x + e0, start + e0 * step, e1 - e0,
+        step, prec);
+
+    index = flint_malloc(sizeof(long) * num);
+    num_index = 0;
+    num_bernoulli = 0;
+    max_bernoulli = 0;
+
+    for (i = 0; i < num; i++)
+    {
+        if (i >= e0 && i < e1)
+            continue;
+
+        index[num_index++] = i;
+
+        n = start + i * step;
+        if (n % 2 == 0 && n >= 2 && n <= 0.7 * prec)
+        {
+            max_bernoulli = FLINT_MAX(max_bernoulli, n);
+            num_bernoulli++;
+        }
+    }
+
+    /* fill the Bernoulli cache once (in parallel) rather than computing
+       the Bernoulli numbers separately in each thread */
+    if (num_bernoulli > 1)
+        bernoulli_cache_compute(max_bernoulli + 1);
+
+    arg.x = x;
+    arg.index = index;
+    arg.start = start;
+    arg.step = step;
+    arg.prec = prec;
+
+    num_threads = flint_get_num_threads();
+
+    if (num_threads > 1 && num_index > 1)
+    {
+        arb_thread_pool_parallel_do(_arb_zeta_ui_vec_worker, &arg,
+            num_index, num_threads);
+    }
+    else
+    {
+        for (i = 0; i < num_index; i++)
+            _arb_zeta_ui_vec_worker(&arg, i);
+    }
+
+    flint_free(index);
+}
 
 void
 arb_zeta_ui_vec(arb_ptr x, ulong start, long num, long prec)
@@ -19,43 +19,56 @@
 =============================================================================*/
 /******************************************************************************
 
-    Copyright (C) 2012 Fredrik Johansson
+    Copyright (C) 2012, 2015 Fredrik Johansson
 
 ******************************************************************************/
 
 #include "arb.h"
+#include "arb_thread_pool.h"
 
 /* With parameter n, the error is bounded by 3/(3+sqrt(8))^n */
 #define ERROR_A 1.5849625007211561815 /* log2(3) */
 #define ERROR_B 2.5431066063272239453 /* log2(3+sqrt(8)) */
 
+/* minimum amount of work (terms times bits) per thread */
+#define BORWEIN_THREAD_WORK 4e6
+
 void mag_borwein_error(mag_t err, long n);
 
-void
-arb_zeta_ui_vec_borwein(arb_ptr z, ulong start, long num, ulong step, long prec)
+/*
+    The main loop runs over k = n, n - 1, ..., 1. With several threads, the
+    range of k is split into blocks. The coefficients c, d at the start of
+    each block are found by running the (cheap) hypergeometric recurrence
+    first, and then each block accumulates its own integer sums. Since the
+    divisions by k^s do not depend on the partition, the total is exactly
+    the same as in the serial loop.
+*/
+
+typedef struct
 {
-    long j, k, s, n, wp;
-    fmpz_t c, d, t, u;
     fmpz * zeta;
-    mag_t err;
-
-    if (num < 1)
-        return;
+    fmpz_t c;
+    fmpz_t d;
+    long k0;
+    long k1;
+    long n;
+    ulong start;
+    ulong step;
+    long num;
+}
+borwein_block_t;
 
-    wp = prec + FLINT_BIT_COUNT(prec);
-    n = wp / 2.5431066063272239453 + 1;
+static void
+_arb_zeta_ui_vec_borwein_block(fmpz * zeta, fmpz_t c, fmpz_t d,
+    long k0, long k1, long n, ulong start, ulong step, long num)
+{
+    fmpz_t t, u;
+    long j, k;
 
-    fmpz_init(c);
-    fmpz_init(d);
     fmpz_init(t);
     fmpz_init(u);
-    zeta = _fmpz_vec_init(num);
-
-    fmpz_set_ui(c, 1);
-    fmpz_mul_2exp(c, c, 2 * n - 1);
-    fmpz_set(d, c);
 
-    for (k = n; k > 0; k--)
+    for (k = k0; k > k1; k--)
     {
         /* divide by first k^s */
         fmpz_ui_pow_ui(u, k, start);
@@ -78,6 +91,97 @@ arb_zeta_ui_vec_borwein(arb_ptr z, ulong start, long num, ulong step, long prec)
         fmpz_add(d, d, c);
     }
 
+    fmpz_clear(t);
+    fmpz_clear(u);
+}
+
+static void
+_arb_zeta_ui_vec_borwein_worker(void * args, long i)
+{
+    borwein_block_t * b = ((borwein_block_t *) args) + i;
+
+    _arb_zeta_ui_vec_borwein_block(b->zeta, b->c, b->d,
+        b->k0, b->k1, b->n, b->start, b->step, b->num);
+}
+
+void
+arb_zeta_ui_vec_borwein(arb_ptr z, ulong start, long num, ulong step, long prec)
+{
+    long i, k, s, n, wp, num_blocks;
+    fmpz_t c, d;
+    fmpz * zeta;
+    mag_t err;
+
+    if (num < 1)
+        return;
+
+    wp = prec + FLINT_BIT_COUNT(prec);
+    n = wp / 2.5431066063272239453 + 1;
+
+    fmpz_init(c);
+    fmpz_init(d);
+    zeta = _fmpz_vec_init(num);
+
+    fmpz_set_ui(c, 1);
+    fmpz_mul_2exp(c, c, 2 * n - 1);
+    fmpz_set(d, c);
+
+    num_blocks = flint_get_num_threads();
+    if (num_blocks > 1)
+        num_blocks = FLINT_MIN(num_blocks,
+            (double) n * num * wp / BORWEIN_THREAD_WORK);
+
+    if (num_blocks <= 1)
+    {
+        _arb_zeta_ui_vec_borwein_block(zeta, c, d,
+            n, 0, n, start, step, num);
+    }
+    else
+    {
+        borwein_block_t * blocks;
+
+        blocks = flint_malloc(sizeof(borwein_block_t) * num_blocks);
+
+        /* find c, d at the start of each block */
+        k = n;
+        for (i = 0; i < num_blocks; i++)
+        {
+            blocks[i].k0 = n - (n * i) / num_blocks;
+            blocks[i].k1 = n - (n * (i + 1)) / num_blocks;
+            blocks[i].n = n;
+            blocks[i].start = start;
+            blocks[i].step = step;
+            blocks[i].num = num;
+            blocks[i].zeta = (i == 0) ? zeta : _fmpz_vec_init(num);
+            fmpz_init_set(blocks[i].c, c);
+            fmpz_init_set(blocks[i].d, d);
+
+            for ( ; k > blocks[i].k1; k--)
+            {
+                fmpz_mul2_uiui(c, c, k, 2 * k - 1);
+                fmpz_divexact2_uiui(c, c, 2 * (n - k + 1), n + k - 1);
+                fmpz_add(d, d, c);
+            }
+        }
+
+        arb_thread_pool_parallel_do(_arb_zeta_ui_vec_borwein_worker, blocks,
+            num_blocks, num_blocks);
+
+        for (i = 0; i < num_blocks; i++)
+        {
+            if (i != 0)
+            {
+                _fmpz_vec_add(zeta, zeta, blocks[i].zeta, num);
+                _fmpz_vec_clear(blocks[i].zeta, num);
+            }
+
+            fmpz_clear(blocks[i].c);
+            fmpz_clear(blocks[i].d);
+        }
+
+        flint_free(blocks);
+    }
+
     mag_init(err);
     mag_borwein_error(err, n);
 
@@ -103,7 +207,5 @@ arb_zeta_ui_vec_borwein(arb_ptr z, ulong start, long num, ulong step, long prec)
 
     fmpz_clear(c);
     fmpz_clear(d);
-    fmpz_clear(t);
-    fmpz_clear(u);
     _fmpz_vec_clear(zeta, num);
 }
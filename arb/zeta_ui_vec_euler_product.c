@@ -0,0 +1,244 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <math.h>
+#include "arb.h"
+#include "arb_thread_pool.h"
+
+/*
+    Evaluates the Euler products for s = start + i * step simultaneously,
+    with the same truncation rule and error bound as
+    arb_zeta_inv_ui_euler_product. For each prime p, the powers p^(-s) are
+    generated by repeated multiplication with p^(-step), going from
+    the smallest s (which needs the highest precision) upwards.
+    Since the truncation point decreases with s, the entries which are
+    still active always form a prefix. With several threads, thread i
+    handles the entries i, i + T, i + 2T, ..., which again form an
+    arithmetic progression.
+*/
+
+static int
+_euler_product_done(ulong s, ulong p, ulong M, long prec)
+{
+    double powmag = s * log(p) * 1.4426950408889634;
+
+    return (powmag >= prec) &&
+        ((1.-s)*log(M-1.)) - log(s-2.) + 2 <= -(prec+1) * 0.69314718055995;
+}
+
+static long
+_euler_product_wp(ulong s, long prec)
+{
+    return prec + FLINT_BIT_COUNT(prec) + (prec/s) + 4;
+}
+
+static void
+add_error(arb_t z, ulong M, ulong s)
+{
+    mag_t t, u;
+    mag_init(t);
+    mag_init(u);
+    mag_set_ui(t, M);
+    mag_pow_ui_lower(t, t, s - 1);
+    mag_mul_ui_lower(t, t, s - 2);
+    mag_set_ui(u, 4);
+    mag_div(t, u, t);
+    mag_add(arb_radref(z), arb_radref(z), t);
+    mag_clear(t);
+    mag_clear(u);
+}
+
+typedef struct
+{
+    arb_ptr z;
+    long zstep;
+    ulong start;
+    ulong step;
+    long num;
+    const mp_limb_t * primes;
+    long num_primes;
+    long prec;
+}
+euler_product_arg_t;
+
+static void
+_arb_zeta_inv_ui_vec_euler_product(arb_ptr z, long zstep, ulong start,
+    ulong step, long num, const mp_limb_t * primes, long num_primes,
+    long prec)
+{
+    arb_t t, u, v;
+    ulong M, p, s;
+    long i, j, active, wp, powprec;
+
+    if (num <= 0)
+        return;
+
+    arb_init(t);
+    arb_init(u);
+    arb_init(v);
+
+    /* z = 1 - 2^(-s) */
+    for (j = 0; j < num; j++)
+    {
+        s = start + j * step;
+        arb_one(z + j * zstep);
+        arf_set_ui_2exp_si(arb_midref(t), 1, -s);
+        arb_sub(z + j * zstep, z + j * zstep, t, _euler_product_wp(s, prec));
+    }
+
+    active = num;
+    M = 2;
+    p = 2;
+
+    for (i = 0; active > 0; i++)
+    {
+        /* the table ends only if prec / start is unusually large */
+        if (i < num_primes)
+            p = primes[i];
+        else
+            p = n_nextprime(p, 0);
+
+        /* see error analysis */
+        while (active > 0 &&
+            _euler_product_done(start + (active - 1) * step, p, M, prec))
+        {
+            s = start + (active - 1) * step;
+            add_error(z + (active - 1) * zstep, M, s);
+            active--;
+        }
+
+        if (active == 0)
+            break;
+
+        M = p;
+
+        /* u = p^(-start), v = p^(-step) */
+        wp = _euler_product_wp(start, prec);
+        powprec = FLINT_MAX(wp - start * log(p) * 1.4426950408889634, 8);
+        arb_ui_pow_ui(u, p, start, powprec);
+        arb_inv(u, u, powprec);
+
+        if (active > 1)
+        {
+            arb_ui_pow_ui(v, p, step, powprec);
+            arb_inv(v, v, powprec);
+        }
+
+        for (j = 0; j < active; j++)
+        {
+            s = start + j * step;
+            wp = _euler_product_wp(s, prec);
+            powprec = FLINT_MAX(wp - s * log(p) * 1.4426950408889634, 8);
+
+            if (j != 0)
+                arb_mul(u, u, v, powprec);
+
+            arb_set_round(t, z + j * zstep, powprec);
+            arb_mul(t, t, u, powprec);
+            arb_sub(z + j * zstep, z + j * zstep, t, wp);
+        }
+    }
+
+    arb_clear(t);
+    arb_clear(u);
+    arb_clear(v);
+}
+
+static void
+_arb_zeta_ui_vec_euler_product_worker(void * args, long i)
+{
+    euler_product_arg_t * arg = ((euler_product_arg_t *) args) + i;
+    long j;
+
+    _arb_zeta_inv_ui_vec_euler_product(arg->z, arg->zstep, arg->start,
+        arg->step, arg->num, arg->primes, arg->num_primes, arg->prec);
+
+    for (j = 0; j < arg->num; j++)
+        arb_inv(arg->z + j * arg->zstep, arg->z + j * arg->zstep, arg->prec);
+}
+
+void
+arb_zeta_ui_vec_euler_product(arb_ptr z, ulong start, long num, ulong step, long prec)
+{
+    euler_product_arg_t * args;
+    mp_limb_t * primes;
+    long i, num_threads, num_primes, alloc;
+    ulong p, M;
+
+    if (num <= 0)
+        return;
+
+    if (start < 6)
+    {
+        printf("too small s!\n");
+        abort();
+    }
+
+    /* the primes used for the smallest s, shared by all entries */
+    alloc = 64;
+    primes = flint_malloc(sizeof(mp_limb_t) * alloc);
+    num_primes = 0;
+    M = 2;
+    p = 3;
+
+    while (!_euler_product_done(start, p, M, prec))
+    {
+        if (num_primes == alloc)
+        {
+            alloc *= 2;
+            primes = flint_realloc(primes, sizeof(mp_limb_t) * alloc);
+        }
+
+        primes[num_primes++] = p;
+        M = p;
+        p = n_nextprime(p, 0);
+    }
+
+    num_threads = flint_get_num_threads();
+    num_threads = FLINT_MIN(num_threads, num);
+
+    args = flint_malloc(sizeof(euler_product_arg_t) * num_threads);
+
+    for (i = 0; i < num_threads; i++)
+    {
+        args[i].z = z + i;
+        args[i].zstep = num_threads;
+        args[i].start = start + i * step;
+        args[i].step = step * num_threads;
+        args[i].num = (num - i + num_threads - 1) / num_threads;
+        args[i].primes = primes;
+        args[i].num_primes = num_primes;
+        args[i].prec = prec;
+    }
+
+    if (num_threads == 1)
+        _arb_zeta_ui_vec_euler_product_worker(args, 0);
+    else
+        arb_thread_pool_parallel_do(_arb_zeta_ui_vec_euler_product_worker,
+            args, num_threads, num_threads);
+
+    flint_free(args);
+    flint_free(primes);
+}
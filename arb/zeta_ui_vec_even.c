@@ -28,9 +28,6 @@
 void
 arb_zeta_ui_vec_even(arb_ptr x, ulong start, long num, long prec)
 {
-    long i;
-
-    for (i = 0; i < num; i++)
-        arb_zeta_ui(x + i, start + 2 * i, prec);
+    _arb_zeta_ui_vec_step(x, start, num, 2, prec);
 }
 
@@ -28,7 +28,7 @@
 void
 arb_zeta_ui_vec_odd(arb_ptr x, ulong start, long num, long prec)
 {
-    long i, num_borwein;
+    long num_borwein;
     ulong cutoff;
 
     cutoff = 40 + 0.3 * prec;
@@ -42,7 +42,7 @@ arb_zeta_ui_vec_odd(arb_ptr x, ulong start, long num, long prec)
         num_borwein = 0;
 
     arb_zeta_ui_vec_borwein(x, start, num_borwein, 2, prec);
-    for (i = num_borwein; i < num; i++)
-        arb_zeta_ui(x + i, start + 2 * i, prec);
+    _arb_zeta_ui_vec_step(x + num_borwein, start + 2 * num_borwein,
+        num - num_borwein, 2, prec);
 }
 
@@ -0,0 +1,561 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#ifndef ARB_FIXED_H
+#define ARB_FIXED_H
+
+#ifdef ARB_FIXED_INLINES_C
+#define ARB_FIXED_INLINE
+#else
+#define ARB_FIXED_INLINE static __inline__
+#endif
+
+#include "arb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    A ball with a midpoint of exactly n limbs (1 <= n <= 4) stored inline,
+    and machine-word exponents for both the midpoint and the radius.
+
+    The midpoint is (-1)^sgnbit * 0.d[n-1]...d[0] * 2^exp with the top bit
+    of d[n-1] set, or zero (all limbs zero, exp = 0). The radius is a mag_t
+    whose exponent is always small, so that only the mag_fast functions
+    are needed. Balls which overflow or underflow the exponent range,
+    or which would require an infinite radius, are represented by the
+    indeterminate value exp = ARB_FIXED_EXP_NAN.
+*/
+
+#define ARB_FIXED_MAX_LIMBS 4
+
+#define ARB_FIXED_MAX_EXP (MAG_MAX_LAGOM_EXP / 4)
+
+#define ARB_FIXED_EXP_NAN (2 * ARB_FIXED_MAX_EXP + 1)
+
+/* Generic kernels, to be inlined with constant n. */
+
+ARB_FIXED_INLINE void
+_arb_fixed_nan(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad, int n)
+{
+    int i;
+    for (i = 0; i < n; i++)
+        zd[i] = 0;
+    *zexp = ARB_FIXED_EXP_NAN;
+    *zsgn = 0;
+    mag_fast_zero(zrad);
+}
+
+ARB_FIXED_INLINE void
+_arb_fixed_zero(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad, int n)
+{
+    int i;
+    for (i = 0; i < n; i++)
+        zd[i] = 0;
+    *zexp = 0;
+    *zsgn = 0;
+    mag_fast_zero(zrad);
+}
+
+/* Checks that the output exponents are in range. */
+ARB_FIXED_INLINE void
+_arb_fixed_finish(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad, int n)
+{
+    if (*zexp < -ARB_FIXED_MAX_EXP || *zexp > ARB_FIXED_MAX_EXP
+        || MAG_EXP(zrad) > ARB_FIXED_MAX_EXP)
+    {
+        _arb_fixed_nan(zd, zexp, zsgn, zrad, n);
+    }
+    else if (MAG_EXP(zrad) < -ARB_FIXED_MAX_EXP && MAG_MAN(zrad) != 0)
+    {
+        MAG_MAN(zrad) = MAG_ONE_HALF;
+        MAG_EXP(zrad) = -ARB_FIXED_MAX_EXP + 1;
+    }
+}
+
+/* Upper bound for the absolute value of the midpoint. */
+ARB_FIXED_INLINE void
+_arb_fixed_get_mag(mag_t z, mp_srcptr xd, long xexp, int n)
+{
+    mp_limb_t t, u;
+
+    if (xd[n - 1] == 0)
+    {
+        mag_fast_zero(z);
+    }
+    else
+    {
+        t = (xd[n - 1] >> (FLINT_BITS - MAG_BITS)) + LIMB_ONE;
+        u = t >> MAG_BITS;
+        MAG_MAN(z) = (t >> u) + u;
+        MAG_EXP(z) = xexp + u;
+    }
+}
+
+/* Lower bound for the absolute value of the midpoint. */
+ARB_FIXED_INLINE void
+_arb_fixed_get_mag_lower(mag_t z, mp_srcptr xd, long xexp, int n)
+{
+    if (xd[n - 1] == 0)
+    {
+        mag_fast_zero(z);
+    }
+    else
+    {
+        MAG_MAN(z) = xd[n - 1] >> (FLINT_BITS - MAG_BITS);
+        MAG_EXP(z) = xexp;
+    }
+}
+
+/* Upper bound for x + y, assuming small exponents and no infinities. */
+ARB_FIXED_INLINE void
+_arb_fixed_mag_add(mag_t z, const mag_t x, const mag_t y)
+{
+    if (MAG_MAN(x) == 0)
+    {
+        mag_fast_init_set(z, y);
+    }
+    else if (MAG_MAN(y) == 0)
+    {
+        mag_fast_init_set(z, x);
+    }
+    else
+    {
+        long shift = MAG_EXP(x) - MAG_EXP(y);
+
+        if (shift == 0)
+        {
+            MAG_EXP(z) = MAG_EXP(x);
+            MAG_MAN(z) = MAG_MAN(x) + MAG_MAN(y);
+            MAG_FAST_ADJUST_ONE_TOO_LARGE(z); /* may need two adjustments */
+        }
+        else if (shift > 0)
+        {
+            MAG_EXP(z) = MAG_EXP(x);
+
+            if (shift >= MAG_BITS)
+                MAG_MAN(z) = MAG_MAN(x) + LIMB_ONE;
+            else
+                MAG_MAN(z) = MAG_MAN(x) + (MAG_MAN(y) >> shift) + LIMB_ONE;
+        }
+        else
+        {
+            shift = -shift;
+            MAG_EXP(z) = MAG_EXP(y);
+
+            if (shift >= MAG_BITS)
+                MAG_MAN(z) = MAG_MAN(y) + LIMB_ONE;
+            else
+                MAG_MAN(z) = MAG_MAN(y) + (MAG_MAN(x) >> shift) + LIMB_ONE;
+        }
+
+        MAG_FAST_ADJUST_ONE_TOO_LARGE(z);
+    }
+}
+
+ARB_FIXED_INLINE void
+_arb_fixed_add(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad,
+    mp_srcptr xd, long xexp, int xsgn, mag_srcptr xrad,
+    mp_srcptr yd, long yexp, int ysgn, mag_srcptr yrad, int n)
+{
+    mp_limb_t t[ARB_FIXED_MAX_LIMBS + 1], u[ARB_FIXED_MAX_LIMBS + 1];
+    mag_struct r;
+    long shift, e;
+    int i, sgn, sticky, inexact;
+
+    if (xexp == ARB_FIXED_EXP_NAN || yexp == ARB_FIXED_EXP_NAN)
+    {
+        _arb_fixed_nan(zd, zexp, zsgn, zrad, n);
+        return;
+    }
+
+    _arb_fixed_mag_add(&r, xrad, yrad);
+
+    if (xd[n - 1] == 0 || yd[n - 1] == 0)
+    {
+        if (xd[n - 1] == 0)
+        {
+            xd = yd;
+            xexp = yexp;
+            xsgn = ysgn;
+        }
+
+        for (i = 0; i < n; i++)
+            zd[i] = xd[i];
+        *zexp = xexp;
+        *zsgn = xsgn;
+        mag_fast_init_set(zrad, &r);
+        _arb_fixed_finish(zd, zexp, zsgn, zrad, n);
+        return;
+    }
+
+    if (xexp < yexp)
+    {
+        mp_srcptr tp = xd; xd = yd; yd = tp;
+        e = xexp; xexp = yexp; yexp = e;
+        i = xsgn; xsgn = ysgn; ysgn = i;
+    }
+
+    shift = xexp - yexp;
+    e = xexp;
+    sgn = xsgn;
+    sticky = 0;
+    inexact = 0;
+
+    /* t = x and u = y >> shift, with one extra limb at the bottom */
+    t[0] = 0;
+    for (i = 0; i < n; i++)
+        t[i + 1] = xd[i];
+
+    if (shift >= (n + 1) * FLINT_BITS)
+    {
+        for (i = 0; i <= n; i++)
+            u[i] = 0;
+        sticky = 1;
+    }
+    else
+    {
+        long limbs = shift / FLINT_BITS;
+        int bits = shift % FLINT_BITS;
+        long j;
+
+        /* y occupies positions 1..n of the extended vector */
+        for (i = 0; i <= n; i++)
+        {
+            j = i + limbs;
+            if (bits == 0)
+            {
+                u[i] = (j >= 1 && j <= n) ? yd[j - 1] : 0;
+            }
+            else
+            {
+                u[i] = (j >= 1 && j <= n) ? (yd[j - 1] >> bits) : 0;
+                if (j + 1 >= 1 && j + 1 <= n)
+                    u[i] |= yd[j] << (FLINT_BITS - bits);
+            }
+        }
+
+        /* bits of y shifted out at the bottom */
+        for (j = 0; j + 1 < limbs && j < n; j++)
+            sticky |= (yd[j] != 0);
+        if (limbs >= 1 && limbs <= n && bits != 0)
+            sticky |= ((yd[limbs - 1] << (FLINT_BITS - bits)) != 0);
+    }
+
+    if (xsgn == ysgn)
+    {
+        mp_limb_t cy = 0, s;
+
+        for (i = 0; i <= n; i++)
+        {
+            s = t[i] + cy;
+            cy = (s < cy);
+            t[i] = s + u[i];
+            cy += (t[i] < u[i]);
+        }
+
+        if (cy)
+        {
+            inexact = (t[0] & 1);
+            for (i = 0; i < n; i++)
+                t[i] = (t[i] >> 1) | (t[i + 1] << (FLINT_BITS - 1));
+            t[n] = (t[n] >> 1) | LIMB_TOP;
+            e++;
+        }
+    }
+    else
+    {
+        mp_limb_t bw = 0, s, b;
+        int cmp = 0;
+
+        for (i = n; i >= 0; i--)
+        {
+            if (t[i] != u[i])
+            {
+                cmp = (t[i] > u[i]) ? 1 : -1;
+                break;
+            }
+        }
+
+        if (cmp == 0)
+        {
+            _arb_fixed_zero(zd, zexp, zsgn, zrad, n);
+            mag_fast_init_set(zrad, &r);
+            _arb_fixed_finish(zd, zexp, zsgn, zrad, n);
+            return;
+        }
+
+        if (cmp < 0)
+        {
+            for (i = 0; i <= n; i++)
+            {
+                s = t[i]; t[i] = u[i]; u[i] = s;
+            }
+            sgn = ysgn;
+        }
+
+        for (i = 0; i <= n; i++)
+        {
+            s = t[i] - u[i];
+            b = (t[i] < u[i]);
+            t[i] = s - bw;
+            bw = b | (s < bw);
+        }
+
+        while (t[n] == 0)
+        {
+            for (i = n; i >= 1; i--)
+                t[i] = t[i - 1];
+            t[0] = 0;
+            e -= FLINT_BITS;
+        }
+
+        if (!(t[n] & LIMB_TOP))
+        {
+            unsigned int c;
+            count_leading_zeros(c, t[n]);
+            for (i = n; i >= 1; i--)
+                t[i] = (t[i] << c) | (t[i - 1] >> (FLINT_BITS - c));
+            t[0] <<= c;
+            e -= c;
+        }
+    }
+
+    for (i = 0; i < n; i++)
+        zd[i] = t[i + 1];
+    *zexp = e;
+    *zsgn = sgn;
+
+    /* the error is less than one ulp from truncation, plus
+       less than one ulp from the bits of y lost in the shift */
+    if (t[0] != 0 || inexact || sticky)
+        mag_fast_add_2exp_si(zrad, &r, e - n * FLINT_BITS + sticky);
+    else
+        mag_fast_init_set(zrad, &r);
+
+    _arb_fixed_finish(zd, zexp, zsgn, zrad, n);
+}
+
+ARB_FIXED_INLINE void
+_arb_fixed_mul(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad,
+    mp_srcptr xd, long xexp, int xsgn, mag_srcptr xrad,
+    mp_srcptr yd, long yexp, int ysgn, mag_srcptr yrad, int n)
+{
+    mp_limb_t p[2 * ARB_FIXED_MAX_LIMBS];
+    mp_limb_t hi, lo, cy;
+    mag_struct r, xm, ym;
+    long e;
+    int i, j, inexact;
+
+    if (xexp == ARB_FIXED_EXP_NAN || yexp == ARB_FIXED_EXP_NAN)
+    {
+        _arb_fixed_nan(zd, zexp, zsgn, zrad, n);
+        return;
+    }
+
+    /* r = |x| yrad + |y| xrad + xrad yrad */
+    _arb_fixed_get_mag(&xm, xd, xexp, n);
+    _arb_fixed_get_mag(&ym, yd, yexp, n);
+    mag_fast_mul(&r, &xm, yrad);
+    mag_fast_addmul(&r, &ym, xrad);
+    mag_fast_addmul(&r, xrad, yrad);
+
+    if (xd[n - 1] == 0 || yd[n - 1] == 0)
+    {
+        _arb_fixed_zero(zd, zexp, zsgn, zrad, n);
+        mag_fast_init_set(zrad, &r);
+        _arb_fixed_finish(zd, zexp, zsgn, zrad, n);
+        return;
+    }
+
+    for (i = 0; i < 2 * n; i++)
+        p[i] = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        cy = 0;
+        for (j = 0; j < n; j++)
+        {
+            umul_ppmm(hi, lo, xd[i], yd[j]);
+            add_ssaaaa(hi, lo, hi, lo, 0, p[i + j]);
+            add_ssaaaa(hi, lo, hi, lo, 0, cy);
+            p[i + j] = lo;
+            cy = hi;
+        }
+        p[i + n] = cy;
+    }
+
+    e = xexp + yexp;
+
+    if (!(p[2 * n - 1] & LIMB_TOP))
+    {
+        for (i = 2 * n - 1; i >= 1; i--)
+            p[i] = (p[i] << 1) | (p[i - 1] >> (FLINT_BITS - 1));
+        p[0] <<= 1;
+        e--;
+    }
+
+    inexact = 0;
+    for (i = 0; i < n; i++)
+        inexact |= (p[i] != 0);
+
+    for (i = 0; i < n; i++)
+        zd[i] = p[i + n];
+    *zexp = e;
+    *zsgn = xsgn ^ ysgn;
+
+    if (inexact)
+        mag_fast_add_2exp_si(zrad, &r, e - n * FLINT_BITS);
+    else
+        mag_fast_init_set(zrad, &r);
+
+    _arb_fixed_finish(zd, zexp, zsgn, zrad, n);
+}
+
+void _arb_fixed_div(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad,
+    mp_srcptr xd, long xexp, int xsgn, mag_srcptr xrad,
+    mp_srcptr yd, long yexp, int ysgn, mag_srcptr yrad, int n);
+
+void _arb_fixed_sqrt(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad,
+    mp_srcptr xd, long xexp, int xsgn, mag_srcptr xrad, int n);
+
+void _arb_fixed_set_arb(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad,
+    const arb_t x, int n);
+
+void _arb_fixed_get_arb(arb_t z, mp_srcptr xd, long xexp, int xsgn,
+    mag_srcptr xrad, int n);
+
+/* Type definitions and wrappers for each number of limbs. */
+
+#define ARB_FIXED_ARGS(x) (x)->d, (x)->exp, (x)->sgnbit, &(x)->rad
+#define ARB_FIXED_OUT(x) (x)->d, &(x)->exp, &(x)->sgnbit, &(x)->rad
+
+#define ARB_FIXED_DEF(N) \
+ \
+typedef struct \
+{ \
+    mp_limb_t d[N]; \
+    long exp; \
+    int sgnbit; \
+    mag_struct rad; \
+} \
+arb_fixed ## N ## _struct; \
+ \
+typedef arb_fixed ## N ## _struct arb_fixed ## N ## _t[1]; \
+typedef arb_fixed ## N ## _struct * arb_fixed ## N ## _ptr; \
+typedef const arb_fixed ## N ## _struct * arb_fixed ## N ## _srcptr; \
+ \
+ARB_FIXED_INLINE void \
+arb_fixed ## N ## _zero(arb_fixed ## N ## _t z) \
+{ \
+    _arb_fixed_zero(ARB_FIXED_OUT(z), N); \
+} \
+ \
+ARB_FIXED_INLINE int \
+arb_fixed ## N ## _is_nan(const arb_fixed ## N ## _t x) \
+{ \
+    return x->exp == ARB_FIXED_EXP_NAN; \
+} \
+ \
+ARB_FIXED_INLINE void \
+arb_fixed ## N ## _neg(arb_fixed ## N ## _t z, const arb_fixed ## N ## _t x) \
+{ \
+    *z = *x; \
+    z->sgnbit ^= (x->d[N - 1] != 0); \
+} \
+ \
+ARB_FIXED_INLINE void \
+arb_fixed ## N ## _set_arb(arb_fixed ## N ## _t z, const arb_t x) \
+{ \
+    _arb_fixed_set_arb(ARB_FIXED_OUT(z), x, N); \
+} \
+ \
+ARB_FIXED_INLINE void \
+arb_fixed ## N ## _get_arb(arb_t z, const arb_fixed ## N ## _t x) \
+{ \
+    _arb_fixed_get_arb(z, ARB_FIXED_ARGS(x), N); \
+} \
+ \
+ARB_FIXED_INLINE void \
+arb_fixed ## N ## _add(arb_fixed ## N ## _t z, \
+    const arb_fixed ## N ## _t x, const arb_fixed ## N ## _t y) \
+{ \
+    _arb_fixed_add(ARB_FIXED_OUT(z), ARB_FIXED_ARGS(x), \
+        ARB_FIXED_ARGS(y), N); \
+} \
+ \
+ARB_FIXED_INLINE void \
+arb_fixed ## N ## _sub(arb_fixed ## N ## _t z, \
+    const arb_fixed ## N ## _t x, const arb_fixed ## N ## _t y) \
+{ \
+    _arb_fixed_add(ARB_FIXED_OUT(z), ARB_FIXED_ARGS(x), \
+        y->d, y->exp, y->sgnbit ^ (y->d[N - 1] != 0), &y->rad, N); \
+} \
+ \
+ARB_FIXED_INLINE void \
+arb_fixed ## N ## _mul(arb_fixed ## N ## _t z, \
+    const arb_fixed ## N ## _t x, const arb_fixed ## N ## _t y) \
+{ \
+    _arb_fixed_mul(ARB_FIXED_OUT(z), ARB_FIXED_ARGS(x), \
+        ARB_FIXED_ARGS(y), N); \
+} \
+ \
+ARB_FIXED_INLINE void \
+arb_fixed ## N ## _addmul(arb_fixed ## N ## _t z, \
+    const arb_fixed ## N ## _t x, const arb_fixed ## N ## _t y) \
+{ \
+    arb_fixed ## N ## _t t; \
+    _arb_fixed_mul(ARB_FIXED_OUT(t), ARB_FIXED_ARGS(x), \
+        ARB_FIXED_ARGS(y), N); \
+    _arb_fixed_add(ARB_FIXED_OUT(z), ARB_FIXED_ARGS(z), \
+        ARB_FIXED_ARGS(t), N); \
+} \
+ \
+ARB_FIXED_INLINE void \
+arb_fixed ## N ## _div(arb_fixed ## N ## _t z, \
+    const arb_fixed ## N ## _t x, const arb_fixed ## N ## _t y) \
+{ \
+    _arb_fixed_div(ARB_FIXED_OUT(z), ARB_FIXED_ARGS(x), \
+        ARB_FIXED_ARGS(y), N); \
+} \
+ \
+ARB_FIXED_INLINE void \
+arb_fixed ## N ## _sqrt(arb_fixed ## N ## _t z, const arb_fixed ## N ## _t x) \
+{ \
+    _arb_fixed_sqrt(ARB_FIXED_OUT(z), ARB_FIXED_ARGS(x), N); \
+} \
+
+ARB_FIXED_DEF(1)
+ARB_FIXED_DEF(2)
+ARB_FIXED_DEF(3)
+ARB_FIXED_DEF(4)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
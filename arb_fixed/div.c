@@ -0,0 +1,127 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_fixed.h"
+
+void
+_arb_fixed_div(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad,
+    mp_srcptr xd, long xexp, int xsgn, mag_srcptr xrad,
+    mp_srcptr yd, long yexp, int ysgn, mag_srcptr yrad, int n)
+{
+    mp_limb_t num[2 * ARB_FIXED_MAX_LIMBS];
+    mp_limb_t q[ARB_FIXED_MAX_LIMBS + 1];
+    mp_limb_t r[ARB_FIXED_MAX_LIMBS];
+    mag_t zr, xm, ym, yl, yw;
+    long e;
+    int i, inexact;
+
+    if (xexp == ARB_FIXED_EXP_NAN || yexp == ARB_FIXED_EXP_NAN
+        || yd[n - 1] == 0)
+    {
+        _arb_fixed_nan(zd, zexp, zsgn, zrad, n);
+        return;
+    }
+
+    mag_init(zr);
+    mag_init(xm);
+    mag_init(ym);
+    mag_init(yl);
+    mag_init(yw);
+
+    /* (|x|*yrad + |y|*xrad)/(y*(|y|-yrad)) */
+    _arb_fixed_get_mag(xm, xd, xexp, n);
+    _arb_fixed_get_mag(ym, yd, yexp, n);
+    mag_fast_mul(zr, xm, yrad);
+    mag_fast_addmul(zr, ym, xrad);
+
+    if (!mag_is_zero(zr))
+    {
+        _arb_fixed_get_mag_lower(yl, yd, yexp, n);
+        mag_sub_lower(yw, yl, yrad);
+
+        if (mag_is_zero(yw))
+        {
+            _arb_fixed_nan(zd, zexp, zsgn, zrad, n);
+            goto cleanup;
+        }
+
+        mag_mul_lower(yl, yl, yw);
+        mag_div(zr, zr, yl);
+    }
+
+    if (xd[n - 1] == 0)
+    {
+        _arb_fixed_zero(zd, zexp, zsgn, zrad, n);
+        mag_fast_init_set(zrad, zr);
+        _arb_fixed_finish(zd, zexp, zsgn, zrad, n);
+        goto cleanup;
+    }
+
+    /* q = floor(x * B^n / y) has n + 1 limbs, with top limb 0 or 1 */
+    for (i = 0; i < n; i++)
+    {
+        num[i] = 0;
+        num[i + n] = xd[i];
+    }
+
+    mpn_tdiv_qr(q, r, 0, num, 2 * n, yd, n);
+
+    inexact = 0;
+    for (i = 0; i < n; i++)
+        inexact |= (r[i] != 0);
+
+    e = xexp - yexp;
+
+    if (q[n] != 0)
+    {
+        inexact |= (q[0] & 1);
+        for (i = 0; i < n; i++)
+            zd[i] = (q[i] >> 1) | (q[i + 1] << (FLINT_BITS - 1));
+        e++;
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+            zd[i] = q[i];
+    }
+
+    *zexp = e;
+    *zsgn = xsgn ^ ysgn;
+
+    if (inexact)
+        mag_fast_add_2exp_si(zrad, zr, e - n * FLINT_BITS);
+    else
+        mag_fast_init_set(zrad, zr);
+
+    _arb_fixed_finish(zd, zexp, zsgn, zrad, n);
+
+cleanup:
+    mag_clear(zr);
+    mag_clear(xm);
+    mag_clear(ym);
+    mag_clear(yl);
+    mag_clear(yw);
+}
+
@@ -0,0 +1,58 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_fixed.h"
+
+void
+_arb_fixed_get_arb(arb_t z, mp_srcptr xd, long xexp, int xsgn,
+    mag_srcptr xrad, int n)
+{
+    if (xexp == ARB_FIXED_EXP_NAN)
+    {
+        arb_indeterminate(z);
+        return;
+    }
+
+    if (xd[n - 1] == 0)
+    {
+        arf_zero(arb_midref(z));
+    }
+    else
+    {
+        arf_set_mpn(arb_midref(z), xd, n, xsgn);
+        fmpz_set_si(ARF_EXPREF(arb_midref(z)), xexp);
+    }
+
+    if (MAG_MAN(xrad) == 0)
+    {
+        mag_zero(arb_radref(z));
+    }
+    else
+    {
+        fmpz_set_si(MAG_EXPREF(arb_radref(z)), MAG_EXP(xrad));
+        MAG_MAN(arb_radref(z)) = MAG_MAN(xrad);
+    }
+}
+
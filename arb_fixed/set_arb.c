@@ -0,0 +1,92 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_fixed.h"
+
+void
+_arb_fixed_set_arb(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad,
+    const arb_t x, int n)
+{
+    const arf_struct * mid = arb_midref(x);
+    const mag_struct * rad = arb_radref(x);
+    mp_srcptr xp;
+    mp_size_t xn;
+    int i, inexact;
+
+    /* the radius */
+    if (mag_is_inf(rad) || COEFF_IS_MPZ(MAG_EXP(rad))
+        || (MAG_MAN(rad) != 0 && MAG_EXP(rad) > ARB_FIXED_MAX_EXP))
+    {
+        _arb_fixed_nan(zd, zexp, zsgn, zrad, n);
+        return;
+    }
+
+    mag_fast_init_set(zrad, rad);
+
+    /* the midpoint */
+    if (arf_is_zero(mid))
+    {
+        for (i = 0; i < n; i++)
+            zd[i] = 0;
+        *zexp = 0;
+        *zsgn = 0;
+    }
+    else if (arf_is_special(mid) || COEFF_IS_MPZ(ARF_EXP(mid))
+        || ARF_EXP(mid) < -ARB_FIXED_MAX_EXP
+        || ARF_EXP(mid) > ARB_FIXED_MAX_EXP)
+    {
+        _arb_fixed_nan(zd, zexp, zsgn, zrad, n);
+        return;
+    }
+    else
+    {
+        ARF_GET_MPN_READONLY(xp, xn, mid);
+
+        inexact = 0;
+
+        if (xn <= n)
+        {
+            for (i = 0; i < n - xn; i++)
+                zd[i] = 0;
+            for (i = 0; i < xn; i++)
+                zd[n - xn + i] = xp[i];
+        }
+        else
+        {
+            for (i = 0; i < n; i++)
+                zd[i] = xp[xn - n + i];
+            inexact = 1;  /* the lowest limb is nonzero */
+        }
+
+        *zexp = ARF_EXP(mid);
+        *zsgn = ARF_SGNBIT(mid);
+
+        if (inexact)
+            mag_fast_add_2exp_si(zrad, zrad, *zexp - n * FLINT_BITS);
+    }
+
+    _arb_fixed_finish(zd, zexp, zsgn, zrad, n);
+}
+
@@ -0,0 +1,121 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_fixed.h"
+
+void
+_arb_fixed_sqrt(mp_ptr zd, long * zexp, int * zsgn, mag_ptr zrad,
+    mp_srcptr xd, long xexp, int xsgn, mag_srcptr xrad, int n)
+{
+    mp_limb_t num[2 * ARB_FIXED_MAX_LIMBS];
+    mag_t rx, zr;
+    long e;
+    int i, inexact;
+
+    if (xexp == ARB_FIXED_EXP_NAN || (xsgn && xd[n - 1] != 0))
+    {
+        _arb_fixed_nan(zd, zexp, zsgn, zrad, n);
+        return;
+    }
+
+    if (xd[n - 1] == 0)
+    {
+        if (MAG_MAN(xrad) == 0)
+            _arb_fixed_zero(zd, zexp, zsgn, zrad, n);
+        else
+            _arb_fixed_nan(zd, zexp, zsgn, zrad, n);
+        return;
+    }
+
+    mag_init(rx);
+    mag_init(zr);
+
+    /* rx = upper bound for r / x */
+    if (MAG_MAN(xrad) != 0)
+    {
+        _arb_fixed_get_mag_lower(rx, xd, xexp, n);
+
+        /* the ball may contain negative numbers */
+        if (mag_cmp(xrad, rx) >= 0)
+        {
+            _arb_fixed_nan(zd, zexp, zsgn, zrad, n);
+            mag_clear(rx);
+            mag_clear(zr);
+            return;
+        }
+
+        mag_div(rx, xrad, rx);
+    }
+
+    /* sqrt(m 2^e) = sqrt(m 2^(-s)) 2^((e+s)/2) where s = e mod 2 */
+    for (i = 0; i < n; i++)
+    {
+        num[i] = 0;
+        num[i + n] = xd[i];
+    }
+
+    if (xexp & 1)
+    {
+        for (i = 0; i < 2 * n - 1; i++)
+            num[i] = (num[i] >> 1) | (num[i + 1] << (FLINT_BITS - 1));
+        num[2 * n - 1] >>= 1;
+        e = (xexp + 1) / 2;
+    }
+    else
+    {
+        e = xexp / 2;
+    }
+
+    inexact = (mpn_sqrtrem(zd, NULL, num, 2 * n) != 0);
+
+    *zexp = e;
+    *zsgn = 0;
+
+    if (MAG_MAN(xrad) != 0)
+    {
+        /* zr = upper bound for sqrt(x) */
+        _arb_fixed_get_mag(zr, zd, e, n);
+        if (inexact)
+            mag_fast_add_2exp_si(zr, zr, e - n * FLINT_BITS);
+
+        /* propagated error:   sqrt(x) - sqrt(x-r)
+                             = sqrt(x) * [1 - sqrt(1 - r/x)]
+                            <= sqrt(x) * 0.5 * (rx + rx^2)  */
+        mag_fast_addmul(rx, rx, rx);
+        mag_fast_mul(zr, zr, rx);
+        mag_fast_mul_2exp_si(zr, zr, -1);
+    }
+
+    if (inexact)
+        mag_fast_add_2exp_si(zrad, zr, e - n * FLINT_BITS);
+    else
+        mag_fast_init_set(zrad, zr);
+
+    _arb_fixed_finish(zd, zexp, zsgn, zrad, n);
+
+    mag_clear(rx);
+    mag_clear(zr);
+}
+
@@ -0,0 +1,124 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_fixed.h"
+
+/* z = z + x y computed with the n-limb type */
+#define COMPUTE(N) \
+    do { \
+        arb_fixed ## N ## _t a, b, c; \
+        arb_fixed ## N ## _set_arb(a, x); \
+        arb_fixed ## N ## _set_arb(b, y); \
+        arb_fixed ## N ## _set_arb(c, z); \
+        arb_fixed ## N ## _addmul(c, a, b); \
+        arb_fixed ## N ## _get_arb(z, c); \
+    } while (0)
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("addmul....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100000; iter++)
+    {
+        arb_t x, y, z, w, z0;
+        long n, prec;
+
+        arb_init(x);
+        arb_init(y);
+        arb_init(z);
+        arb_init(w);
+        arb_init(z0);
+
+        n = 1 + n_randint(state, 4);
+
+        if (n_randint(state, 2))
+        {
+            arb_randtest(x, state, 1 + n_randint(state, 300), 8);
+            arb_randtest(y, state, 1 + n_randint(state, 300), 8);
+        }
+        else
+        {
+            arb_randtest_exact(x, state, 1 + n_randint(state, FLINT_BITS * n), 8);
+            arb_randtest_exact(y, state, 1 + n_randint(state, FLINT_BITS * n), 8);
+        }
+        arb_randtest(z, state, 1 + n_randint(state, 300), 8);
+        arb_set(z0, z);
+
+        switch (n)
+        {
+            case 1: COMPUTE(1); break;
+            case 2: COMPUTE(2); break;
+            case 3: COMPUTE(3); break;
+            default: COMPUTE(4);
+        }
+
+        prec = FLINT_BITS * n + 100;
+        arb_set(w, z0);
+        arb_addmul(w, x, y, prec);
+
+        if (!arb_overlaps(z, w))
+        {
+            printf("FAIL: overlap\n\n");
+            printf("n = %ld\n\n", n);
+            printf("x = "); arb_printd(x, 50); printf("\n\n");
+            printf("y = "); arb_printd(y, 50); printf("\n\n");
+            printf("z = "); arb_printd(z, 50); printf("\n\n");
+            printf("w = "); arb_printd(w, 50); printf("\n\n");
+            abort();
+        }
+
+        /* the result should be accurate to within a couple of ulps */
+        if (arb_is_exact(x) && arb_is_exact(y) && arb_is_zero(z0)
+            && arf_bits(arb_midref(x)) <= FLINT_BITS * n
+            && arf_bits(arb_midref(y)) <= FLINT_BITS * n
+            && arb_is_finite(z) && !arf_is_zero(arb_midref(z))
+            && arb_rel_accuracy_bits(z) < FLINT_BITS * n - 4)
+        {
+            printf("FAIL: accuracy\n\n");
+            printf("n = %ld\n\n", n);
+            printf("x = "); arb_printd(x, 50); printf("\n\n");
+            printf("y = "); arb_printd(y, 50); printf("\n\n");
+            printf("z = "); arb_printd(z, 50); printf("\n\n");
+            abort();
+        }
+
+        arb_clear(x);
+        arb_clear(y);
+        arb_clear(z);
+        arb_clear(w);
+        arb_clear(z0);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_fixed.h"
+
+/* z = x / y computed with the n-limb type; with alias = 1 or 2,
+   the operation is done in place of the first or second operand */
+static void
+fixed_div(arb_t z, const arb_t x, const arb_t y, long n, int alias)
+{
+    if (n == 1)
+    {
+        arb_fixed1_t a, b, c;
+        arb_fixed1_set_arb(a, x);
+        arb_fixed1_set_arb(b, y);
+
+        if (alias == 1)
+        {
+            arb_fixed1_div(a, a, b);
+            *c = *a;
+        }
+        else if (alias == 2)
+        {
+            arb_fixed1_div(b, a, b);
+            *c = *b;
+        }
+        else
+        {
+            arb_fixed1_div(c, a, b);
+        }
+
+        arb_fixed1_get_arb(z, c);
+    }
+    else if (n == 2)
+    {
+        arb_fixed2_t a, b, c;
+        arb_fixed2_set_arb(a, x);
+        arb_fixed2_set_arb(b, y);
+
+        if (alias == 1)
+        {
+            arb_fixed2_div(a, a, b);
+            *c = *a;
+        }
+        else if (alias == 2)
+        {
+            arb_fixed2_div(b, a, b);
+            *c = *b;
+        }
+        else
+        {
+            arb_fixed2_div(c, a, b);
+        }
+
+        arb_fixed2_get_arb(z, c);
+    }
+    else if (n == 3)
+    {
+        arb_fixed3_t a, b, c;
+        arb_fixed3_set_arb(a, x);
+        arb_fixed3_set_arb(b, y);
+
+        if (alias == 1)
+        {
+            arb_fixed3_div(a, a, b);
+            *c = *a;
+        }
+        else if (alias == 2)
+        {
+            arb_fixed3_div(b, a, b);
+            *c = *b;
+        }
+        else
+        {
+            arb_fixed3_div(c, a, b);
+        }
+
+        arb_fixed3_get_arb(z, c);
+    }
+    else
+    {
+        arb_fixed4_t a, b, c;
+        arb_fixed4_set_arb(a, x);
+        arb_fixed4_set_arb(b, y);
+
+        if (alias == 1)
+        {
+            arb_fixed4_div(a, a, b);
+            *c = *a;
+        }
+        else if (alias == 2)
+        {
+            arb_fixed4_div(b, a, b);
+            *c = *b;
+        }
+        else
+        {
+            arb_fixed4_div(c, a, b);
+        }
+
+        arb_fixed4_get_arb(z, c);
+    }
+}
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("div....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100000; iter++)
+    {
+        arb_t a, b, c, d;
+        fmpq_t x, y, z;
+        long n;
+        int alias;
+
+        arb_init(a);
+        arb_init(b);
+        arb_init(c);
+        arb_init(d);
+
+        fmpq_init(x);
+        fmpq_init(y);
+        fmpq_init(z);
+
+        n = 1 + n_randint(state, ARB_FIXED_MAX_LIMBS);
+        alias = 1 + n_randint(state, 2);
+
+        if (n_randint(state, 2))
+        {
+            arb_randtest(a, state, 1 + n_randint(state, 300), 8);
+            arb_randtest(b, state, 1 + n_randint(state, 300), 8);
+        }
+        else
+        {
+            arb_randtest_exact(a, state, 1 + n_randint(state, FLINT_BITS * n), 8);
+            arb_randtest_exact(b, state, 1 + n_randint(state, FLINT_BITS * n), 8);
+        }
+
+        if (arb_contains_zero(b))
+            arb_one(b);
+
+        arb_get_rand_fmpq(x, state, a, 1 + n_randint(state, 200));
+        arb_get_rand_fmpq(y, state, b, 1 + n_randint(state, 200));
+
+        fixed_div(c, a, b, n, 0);
+        fmpq_div(z, x, y);
+
+        if (!arb_contains_fmpq(c, z))
+        {
+            printf("FAIL: containment\n\n");
+            printf("n = %ld\n\n", n);
+            printf("a = "); arb_printd(a, 50); printf("\n\n");
+            printf("x = "); fmpq_print(x); printf("\n\n");
+            printf("b = "); arb_printd(b, 50); printf("\n\n");
+            printf("y = "); fmpq_print(y); printf("\n\n");
+            printf("c = "); arb_printd(c, 50); printf("\n\n");
+            printf("z = "); fmpq_print(z); printf("\n\n");
+            abort();
+        }
+
+        /* the result should be accurate to within a couple of ulps */
+        if (arb_is_exact(a) && arb_is_exact(b)
+            && arf_bits(arb_midref(a)) <= FLINT_BITS * n
+            && arf_bits(arb_midref(b)) <= FLINT_BITS * n
+            && arb_is_finite(c) && !arf_is_zero(arb_midref(c))
+            && arb_rel_accuracy_bits(c) < FLINT_BITS * n - 4)
+        {
+            printf("FAIL: accuracy\n\n");
+            printf("n = %ld\n\n", n);
+            printf("a = "); arb_printd(a, 50); printf("\n\n");
+            printf("b = "); arb_printd(b, 50); printf("\n\n");
+            printf("c = "); arb_printd(c, 50); printf("\n\n");
+            abort();
+        }
+
+        fixed_div(d, a, b, n, alias);
+
+        if (!arb_equal(c, d))
+        {
+            printf("FAIL: aliasing\n\n");
+            printf("n = %ld, alias = %d\n\n", n, alias);
+            printf("a = "); arb_printd(a, 50); printf("\n\n");
+            printf("b = "); arb_printd(b, 50); printf("\n\n");
+            printf("c = "); arb_printd(c, 50); printf("\n\n");
+            printf("d = "); arb_printd(d, 50); printf("\n\n");
+            abort();
+        }
+
+        arb_clear(a);
+        arb_clear(b);
+        arb_clear(c);
+        arb_clear(d);
+
+        fmpq_clear(x);
+        fmpq_clear(y);
+        fmpq_clear(z);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,97 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_fixed.h"
+
+#define ROUNDTRIP(N) \
+    do { \
+        arb_fixed ## N ## _t a; \
+        arb_fixed ## N ## _set_arb(a, x); \
+        arb_fixed ## N ## _get_arb(z, a); \
+    } while (0)
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("set_arb....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100000; iter++)
+    {
+        arb_t x, z;
+        long n;
+
+        arb_init(x);
+        arb_init(z);
+
+        n = 1 + n_randint(state, 4);
+
+        if (n_randint(state, 10) == 0)
+            arb_randtest_special(x, state, 1 + n_randint(state, 400), 100);
+        else
+            arb_randtest(x, state, 1 + n_randint(state, 400), 10);
+
+        switch (n)
+        {
+            case 1: ROUNDTRIP(1); break;
+            case 2: ROUNDTRIP(2); break;
+            case 3: ROUNDTRIP(3); break;
+            default: ROUNDTRIP(4);
+        }
+
+        if (!arb_contains(z, x))
+        {
+            printf("FAIL: containment\n\n");
+            printf("n = %ld\n\n", n);
+            printf("x = "); arb_print(x); printf("\n\n");
+            printf("z = "); arb_print(z); printf("\n\n");
+            abort();
+        }
+
+        if (arb_is_finite(x) && arf_bits(arb_midref(x)) <= FLINT_BITS * n
+            && fmpz_bits(ARF_EXPREF(arb_midref(x))) < 20
+            && fmpz_bits(MAG_EXPREF(arb_radref(x))) < 20
+            && !arb_equal(z, x))
+        {
+            printf("FAIL: exact roundtrip\n\n");
+            printf("n = %ld\n\n", n);
+            printf("x = "); arb_print(x); printf("\n\n");
+            printf("z = "); arb_print(z); printf("\n\n");
+            abort();
+        }
+
+        arb_clear(x);
+        arb_clear(z);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
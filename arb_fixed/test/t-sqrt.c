@@ -0,0 +1,108 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_fixed.h"
+
+#define COMPUTE(N) \
+    do { \
+        arb_fixed ## N ## _t a, b; \
+        arb_fixed ## N ## _set_arb(a, x); \
+        arb_fixed ## N ## _sqrt(b, a); \
+        arb_fixed ## N ## _get_arb(z, b); \
+        arb_fixed ## N ## _sqrt(a, a); \
+        arb_fixed ## N ## _get_arb(v, a); \
+    } while (0)
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("sqrt....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100000; iter++)
+    {
+        arb_t x, z, v, w;
+        long n, prec;
+
+        arb_init(x);
+        arb_init(z);
+        arb_init(v);
+        arb_init(w);
+
+        n = 1 + n_randint(state, 4);
+
+        if (n_randint(state, 2))
+            arb_randtest(x, state, 1 + n_randint(state, 300), 8);
+        else
+            arb_randtest_exact(x, state, 1 + n_randint(state, FLINT_BITS * n), 8);
+
+        switch (n)
+        {
+            case 1: COMPUTE(1); break;
+            case 2: COMPUTE(2); break;
+            case 3: COMPUTE(3); break;
+            default: COMPUTE(4);
+        }
+
+        prec = FLINT_BITS * n + 100;
+        arb_sqrt(w, x, prec);
+
+        if (!arb_overlaps(z, w) || !arb_equal(z, v))
+        {
+            printf("FAIL: overlap or aliasing\n\n");
+            printf("n = %ld\n\n", n);
+            printf("x = "); arb_printd(x, 50); printf("\n\n");
+            printf("z = "); arb_printd(z, 50); printf("\n\n");
+            printf("v = "); arb_printd(v, 50); printf("\n\n");
+            printf("w = "); arb_printd(w, 50); printf("\n\n");
+            abort();
+        }
+
+        if (arb_is_exact(x) && arf_bits(arb_midref(x)) <= FLINT_BITS * n
+            && arb_is_finite(z) && !arf_is_zero(arb_midref(z))
+            && arb_rel_accuracy_bits(z) < FLINT_BITS * n - 4)
+        {
+            printf("FAIL: accuracy\n\n");
+            printf("n = %ld\n\n", n);
+            printf("x = "); arb_printd(x, 50); printf("\n\n");
+            printf("z = "); arb_printd(z, 50); printf("\n\n");
+            abort();
+        }
+
+        arb_clear(x);
+        arb_clear(z);
+        arb_clear(v);
+        arb_clear(w);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -137,6 +137,31 @@ void arb_mat_mul_classical(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, lo
 
 void arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long prec);
 
+void arb_mat_mul_block(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long prec);
+
+/* Tuning parameters for threaded multiplication; the crossover
+   points can be measured with arb_mat/profile/p-mul_threaded.c */
+
+/* number of rows and columns of the output in one tile */
+#define ARB_MAT_MUL_TILE_SIDE 16
+
+/* target size in bytes of the data used by one tile between two
+   passes over the inner dimension (about the size of the L2 cache) */
+#define ARB_MAT_MUL_TILE_BYTES 262144
+
+/* minimum work per thread, in limb multiplications (roughly) */
+#define ARB_MAT_MUL_THREAD_WORK 100000
+
+/* smallest dimension for which arb_mat_mul uses arb_mat_mul_block */
+#define ARB_MAT_MUL_BLOCK_CUTOFF(prec) \
+    ((prec) <= 2 * FLINT_BITS ? 60 : ((prec) <= 16 * FLINT_BITS ? 30 : 15))
+
+long _arb_mat_mul_num_threads(long ar, long br, long bc, long prec);
+
+void _arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long prec, long num_threads);
+
+void _arb_mat_mul_block(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long prec, long num_threads);
+
 void arb_mat_pow_ui(arb_mat_t B, const arb_mat_t A, ulong exp, long prec);
 
 /* Scalar arithmetic */
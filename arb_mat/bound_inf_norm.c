@@ -29,8 +29,8 @@ void
 arb_mat_bound_inf_norm(mag_t b, const arb_mat_t A)
 {
     long i, j, r, c;
-
-    mag_t s, t;
+    mag_ptr s;
+    mag_t t;
 
     r = arb_mat_nrows(A);
     c = arb_mat_ncols(A);
@@ -40,23 +40,21 @@ arb_mat_bound_inf_norm(mag_t b, const arb_mat_t A)
     if (r == 0 || c == 0)
         return;
 
-    mag_init(s);
+    s = _mag_vec_init(r);
     mag_init(t);
 
     for (i = 0; i < r; i++)
     {
-        mag_zero(s);
-
         for (j = 0; j < c; j++)
         {
             arb_get_mag(t, arb_mat_entry(A, i, j));
-            mag_add(s, s, t);
+            mag_add(s + i, s + i, t);
         }
-
-        mag_max(b, b, s);
     }
 
-    mag_clear(s);
+    _mag_vec_max(b, s, r);
+
+    _mag_vec_clear(s, r);
     mag_clear(t);
 }
 
@@ -25,20 +25,47 @@
 
 #include "arb_mat.h"
 
+/* The work is estimated as the number of terms in the dot products
+   times the cost of one term (the number of limbs, plus overhead). */
+long
+_arb_mat_mul_num_threads(long ar, long br, long bc, long prec)
+{
+    double work;
+    long num_threads;
+
+    num_threads = flint_get_num_threads();
+
+    if (num_threads <= 1)
+        return 1;
+
+    work = (double) ar * (double) br * (double) bc;
+    work *= (double) ((prec + FLINT_BITS - 1) / FLINT_BITS + 2);
+    work /= ARB_MAT_MUL_THREAD_WORK;
+
+    if (work < num_threads)
+        num_threads = FLINT_MAX(1, (long) work);
+
+    return num_threads;
+}
+
 void
 arb_mat_mul(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long prec)
 {
-    if (flint_get_num_threads() > 1 &&
-        ((double) arb_mat_nrows(A) *
-         (double) arb_mat_nrows(B) *
-         (double) arb_mat_ncols(B) *
-         (double) prec > 100000))
-    {
-        arb_mat_mul_threaded(C, A, B, prec);
-    }
+    long ar, br, bc, num_threads;
+
+    ar = arb_mat_nrows(A);
+    br = arb_mat_nrows(B);
+    bc = arb_mat_ncols(B);
+
+    num_threads = _arb_mat_mul_num_threads(ar, br, bc, prec);
+
+    /* the block algorithm distributes its inner products over the
+       threads itself */
+    if (FLINT_MIN(FLINT_MIN(ar, br), bc) >= ARB_MAT_MUL_BLOCK_CUTOFF(prec))
+        _arb_mat_mul_block(C, A, B, prec, num_threads);
+    else if (num_threads > 1)
+        _arb_mat_mul_threaded(C, A, B, prec, num_threads);
     else
-    {
         arb_mat_mul_classical(C, A, B, prec);
-    }
 }
 
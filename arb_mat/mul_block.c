@@ -0,0 +1,652 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <math.h>
+#include <limits.h>
+#include "arb_mat.h"
+#include "arb_thread_pool.h"
+
+/*
+    The inner dimension is split into blocks such that, within a block,
+    the midpoints in each row of A and in each column of B span at most
+    ALPHA*prec + BETA bits (as in arb_poly/mullow_block.c). The midpoints
+    of a block are then converted exactly to integer matrices, with one
+    exponent per row of A and per column of B, and multiplied using
+    fmpz_mat_mul. The propagated error is bounded separately using
+    matrix products of scaled doubles, with the radii scaled
+    independently of the midpoints.
+
+    With several threads, all products are split by rows of A. The
+    blocks are chosen for the whole matrix before splitting, and the
+    split products are exact (or computed row by row in the same order),
+    so the result does not depend on the number of threads.
+*/
+#define ALPHA 3.0
+#define BETA 512
+
+/* Maximum number of terms in one double dot product. */
+#define DOUBLE_BLOCK_MAX_LENGTH 999
+
+/* Computing a dot product of length DOUBLE_BLOCK_MAX_LENGTH involving
+   only nonnegative numbers, and then multiplying by this factor, gives
+   an upper bound for the exact dot product (provided that no overflow
+   or underflow occurs). */
+#define DOUBLE_ROUNDING_FACTOR (1.0 + 1e-9)
+
+/* Maximum height of the nonzero radii (or midpoint magnitudes) in
+   one row or column of a double block. */
+#define DOUBLE_MAX_HEIGHT 300
+
+/* Nonzero scaled entries smaller than 2^DOUBLE_MIN_EXP are rounded up to
+   this value, so that products of two entries never underflow. With
+   the height limit above, this does not happen. */
+#define DOUBLE_MIN_EXP (-400)
+
+static int
+_arb_mat_is_lagom(int * exact, const arb_mat_t A)
+{
+    long i, j;
+
+    for (i = 0; i < arb_mat_nrows(A); i++)
+    {
+        for (j = 0; j < arb_mat_ncols(A); j++)
+        {
+            arb_srcptr x = arb_mat_entry(A, i, j);
+
+            if (!ARF_IS_LAGOM(arb_midref(x)) || !MAG_IS_LAGOM(arb_radref(x)))
+                return 0;
+
+            if (!mag_is_zero(arb_radref(x)))
+                *exact = 0;
+        }
+    }
+
+    return 1;
+}
+
+/* Checks whether appending x[i] to the block of entry i keeps the
+   height below maxheight for all i; top[i] = LONG_MIN denotes an
+   empty block. */
+static int
+_arb_mat_block_fits(const long * top, const long * bot,
+    arb_srcptr x, long len, long maxheight)
+{
+    long i, e, b;
+
+    for (i = 0; i < len; i++)
+    {
+        arf_srcptr m = arb_midref(x + i);
+
+        if (arf_is_zero(m) || top[i] == LONG_MIN)
+            continue;
+
+        e = ARF_EXP(m);
+        b = e - arf_bits(m);
+
+        if (FLINT_MAX(top[i], e) - FLINT_MIN(bot[i], b) >= maxheight)
+            return 0;
+    }
+
+    return 1;
+}
+
+static void
+_arb_mat_block_extend(long * top, long * bot, arb_srcptr x, long len)
+{
+    long i, e, b;
+
+    for (i = 0; i < len; i++)
+    {
+        arf_srcptr m = arb_midref(x + i);
+
+        if (arf_is_zero(m))
+            continue;
+
+        e = ARF_EXP(m);
+        b = e - arf_bits(m);
+
+        if (top[i] == LONG_MIN)
+        {
+            top[i] = e;
+            bot[i] = b;
+        }
+        else
+        {
+            top[i] = FLINT_MAX(top[i], e);
+            bot[i] = FLINT_MIN(bot[i], b);
+        }
+    }
+}
+
+/* z = x / 2^bot, which must be an integer */
+static void
+_arf_get_fmpz_fixed_lagom(fmpz_t z, fmpz_t t, const arf_t x, long bot)
+{
+    if (arf_is_zero(x))
+    {
+        fmpz_zero(z);
+    }
+    else
+    {
+        arf_get_fmpz_2exp(z, t, x);
+        fmpz_mul_2exp(z, z, fmpz_get_si(t) - bot);
+    }
+}
+
+/* An upper bound for x / 2^top, where x <= 2^top. */
+static __inline__ double
+_mag_get_d_scaled(const mag_t x, long top)
+{
+    long e;
+
+    if (mag_is_zero(x))
+        return 0.0;
+
+    e = MAG_EXP(x) - top;
+
+    if (e < DOUBLE_MIN_EXP)
+        return ldexp(1.0, DOUBLE_MIN_EXP);
+
+    return ldexp((double) MAG_MAN(x), e - MAG_BITS);
+}
+
+typedef struct
+{
+    fmpz_mat_struct * C;
+    const fmpz_mat_struct * A;
+    const fmpz_mat_struct * B;
+    long rows;
+}
+fmpz_mat_mul_arg_t;
+
+static void
+_fmpz_mat_mul_rows(void * arg_ptr, long t)
+{
+    fmpz_mat_mul_arg_t * arg = arg_ptr;
+    fmpz_mat_struct A1, C1;
+    long i0;
+
+    i0 = t * arg->rows;
+
+    /* shallow windows of rows i0, ..., i0 + rows - 1 */
+    A1.entries = NULL;
+    A1.r = FLINT_MIN(arg->rows, arg->A->r - i0);
+    A1.c = arg->A->c;
+    A1.rows = arg->A->rows + i0;
+
+    C1.entries = NULL;
+    C1.r = A1.r;
+    C1.c = arg->C->c;
+    C1.rows = arg->C->rows + i0;
+
+    fmpz_mat_mul(&C1, &A1, arg->B);
+}
+
+static void
+_fmpz_mat_mul_threaded(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
+    long num_threads)
+{
+    fmpz_mat_mul_arg_t arg;
+
+    num_threads = FLINT_MIN(num_threads, A->r);
+
+    if (num_threads <= 1)
+    {
+        fmpz_mat_mul(C, A, B);
+        return;
+    }
+
+    arg.C = C;
+    arg.A = A;
+    arg.B = B;
+    arg.rows = (A->r + num_threads - 1) / num_threads;
+
+    arb_thread_pool_parallel_do(_fmpz_mat_mul_rows, &arg,
+        (A->r + arg.rows - 1) / arg.rows, num_threads);
+}
+
+/* C += mid(A) mid(B), using columns k0, ..., k1 - 1 of A (stored as
+   its transpose AT) and rows k0, ..., k1 - 1 of B. */
+static void
+_arb_mat_addmul_block_mid(arb_mat_t C, arb_srcptr AT, const arb_mat_t B,
+    long k0, long k1, const long * abot, const long * bbot, long prec,
+    long num_threads)
+{
+    long ar, bc, w, i, j, k;
+    fmpz_mat_t AZ, BZ, CZ;
+    fmpz_t e;
+
+    ar = arb_mat_nrows(C);
+    bc = arb_mat_ncols(C);
+    w = k1 - k0;
+
+    fmpz_mat_init(AZ, ar, w);
+    fmpz_mat_init(BZ, w, bc);
+    fmpz_mat_init(CZ, ar, bc);
+    fmpz_init(e);
+
+    for (i = 0; i < ar; i++)
+        for (k = 0; k < w; k++)
+            _arf_get_fmpz_fixed_lagom(fmpz_mat_entry(AZ, i, k), e,
+                arb_midref(AT + (k0 + k) * ar + i), abot[i]);
+
+    for (k = 0; k < w; k++)
+        for (j = 0; j < bc; j++)
+            _arf_get_fmpz_fixed_lagom(fmpz_mat_entry(BZ, k, j), e,
+                arb_midref(arb_mat_entry(B, k0 + k, j)), bbot[j]);
+
+    _fmpz_mat_mul_threaded(CZ, AZ, BZ, num_threads);
+
+    for (i = 0; i < ar; i++)
+    {
+        for (j = 0; j < bc; j++)
+        {
+            if (!fmpz_is_zero(fmpz_mat_entry(CZ, i, j)))
+            {
+                fmpz_set_si(e, abot[i] + bbot[j]);
+                arb_add_fmpz_2exp(arb_mat_entry(C, i, j),
+                    arb_mat_entry(C, i, j), fmpz_mat_entry(CZ, i, j), e, prec);
+            }
+        }
+    }
+
+    fmpz_mat_clear(AZ);
+    fmpz_mat_clear(BZ);
+    fmpz_mat_clear(CZ);
+    fmpz_clear(e);
+}
+
+typedef struct
+{
+    double * S;
+    const double * Ad;
+    const double * Bd;
+    long ar;
+    long bc;
+    long len;
+    long rows;
+}
+double_mat_mul_arg_t;
+
+/* S = Ad Bd for rows i0, ..., i0 + rows - 1 */
+static void
+_double_mat_mul_rows(void * arg_ptr, long t)
+{
+    double_mat_mul_arg_t * arg = arg_ptr;
+    double * S = arg->S;
+    const double * Ad = arg->Ad;
+    const double * Bd = arg->Bd;
+    long i, j, kk, i0, i1, bc, len;
+
+    bc = arg->bc;
+    len = arg->len;
+    i0 = t * arg->rows;
+    i1 = FLINT_MIN(i0 + arg->rows, arg->ar);
+
+    for (i = i0 * bc; i < i1 * bc; i++)
+        S[i] = 0.0;
+
+    for (i = i0; i < i1; i++)
+    {
+        for (kk = 0; kk < len; kk++)
+        {
+            double a = Ad[i * len + kk];
+
+            if (a == 0.0)
+                continue;
+
+            for (j = 0; j < bc; j++)
+                S[i * bc + j] += a * Bd[kk * bc + j];
+        }
+    }
+}
+
+/* S = Ad Bd, where Ad is ar x len and Bd is len x bc */
+static void
+_double_mat_mul(double * S, const double * Ad, const double * Bd,
+    long ar, long bc, long len, long num_threads)
+{
+    double_mat_mul_arg_t arg;
+
+    arg.S = S;
+    arg.Ad = Ad;
+    arg.Bd = Bd;
+    arg.ar = ar;
+    arg.bc = bc;
+    arg.len = len;
+    arg.rows = (ar + num_threads - 1) / num_threads;
+
+    if (num_threads <= 1)
+        _double_mat_mul_rows(&arg, 0);
+    else
+        arb_thread_pool_parallel_do(_double_mat_mul_rows, &arg,
+            (ar + arg.rows - 1) / arg.rows, num_threads);
+}
+
+/* Same as _arb_mat_block_fits, for magnitudes. */
+static int
+_mag_vec_block_fits(const long * top, const long * bot,
+    mag_srcptr x, long len, long maxheight)
+{
+    long i, e;
+
+    for (i = 0; i < len; i++)
+    {
+        if (mag_is_zero(x + i) || top[i] == LONG_MIN)
+            continue;
+
+        e = MAG_EXP(x + i);
+
+        if (FLINT_MAX(top[i], e) - FLINT_MIN(bot[i], e) > maxheight)
+            return 0;
+    }
+
+    return 1;
+}
+
+static void
+_mag_vec_block_extend(long * top, long * bot, mag_srcptr x, long len)
+{
+    long i, e;
+
+    for (i = 0; i < len; i++)
+    {
+        if (mag_is_zero(x + i))
+            continue;
+
+        e = MAG_EXP(x + i);
+
+        if (top[i] == LONG_MIN)
+        {
+            top[i] = bot[i] = e;
+        }
+        else
+        {
+            top[i] = FLINT_MAX(top[i], e);
+            bot[i] = FLINT_MIN(bot[i], e);
+        }
+    }
+}
+
+/* Sets D to the len x n matrix X with column i scaled by 2^-top[i],
+   or to its transpose if trans is set. */
+static void
+_mag_mat_get_d_scaled(double * D, mag_srcptr X, long * top,
+    long len, long n, int trans)
+{
+    long i, k;
+
+    for (i = 0; i < n; i++)
+        if (top[i] == LONG_MIN)
+            top[i] = 0;
+
+    for (k = 0; k < len; k++)
+        for (i = 0; i < n; i++)
+            D[trans ? i * len + k : k * n + i] =
+                _mag_get_d_scaled(X + k * n + i, top[i]);
+}
+
+/* rad(C) += (|mid(A)| + rad(A)) rad(B) + rad(A) |mid(B)|, using the
+   same columns of A and rows of B as above. The two products are
+   computed using doubles, with the rows of each left factor and the
+   columns of each right factor scaled by their own powers of two.
+   The inner dimension is split into chunks in which each scaled row
+   and column spans at most DOUBLE_MAX_HEIGHT bits, so that no entry
+   is rounded up to 2^DOUBLE_MIN_EXP, and which are short enough that
+   the rounding error can be bounded. */
+static void
+_arb_mat_addmul_block_rad(arb_mat_t C, arb_srcptr AT, const arb_mat_t B,
+    long k0, long k1, long num_threads)
+{
+    long ar, bc, n, w, c0, c1, i, j, k;
+    long * stop, * sbot, * artop, * arbot, * brtop, * brbot, * bmtop, * bmbot;
+    mag_ptr As, Ar, Br, Bm;
+    double * Ad, * Bd, * Sd, * Rd;
+    arb_srcptr x;
+    mag_t t;
+    fmpz_t e;
+
+    ar = arb_mat_nrows(C);
+    bc = arb_mat_ncols(C);
+    w = k1 - k0;
+    num_threads = FLINT_MAX(1, FLINT_MIN(num_threads, ar));
+
+    /* As = |mid(A)| + rad(A), Ar = rad(A) (transposed);
+       Br = rad(B), Bm = |mid(B)| */
+    As = _mag_vec_init(w * ar);
+    Bm = _mag_vec_init(w * bc);
+    Ar = flint_malloc(sizeof(mag_struct) * w * ar);
+    Br = flint_malloc(sizeof(mag_struct) * w * bc);
+
+    for (k = 0; k < w; k++)
+    {
+        for (i = 0; i < ar; i++)
+        {
+            x = AT + (k0 + k) * ar + i;
+            arf_get_mag(As + k * ar + i, arb_midref(x));
+            mag_add(As + k * ar + i, As + k * ar + i, arb_radref(x));
+            Ar[k * ar + i] = *arb_radref(x);
+        }
+
+        for (j = 0; j < bc; j++)
+        {
+            x = arb_mat_entry(B, k0 + k, j);
+            arf_get_mag(Bm + k * bc + j, arb_midref(x));
+            Br[k * bc + j] = *arb_radref(x);
+        }
+    }
+
+    stop = flint_malloc(sizeof(long) * 4 * (ar + bc));
+    sbot = stop + ar;
+    artop = sbot + ar;
+    arbot = artop + ar;
+    brtop = arbot + ar;
+    brbot = brtop + bc;
+    bmtop = brbot + bc;
+    bmbot = bmtop + bc;
+
+    n = FLINT_MIN(w, DOUBLE_BLOCK_MAX_LENGTH);
+    Ad = flint_malloc(sizeof(double) * ar * n);
+    Bd = flint_malloc(sizeof(double) * n * bc);
+    Sd = flint_malloc(sizeof(double) * ar * bc);
+    Rd = flint_malloc(sizeof(double) * ar * bc);
+
+    mag_init(t);
+    fmpz_init(e);
+
+    for (c0 = 0; c0 < w; c0 = c1)
+    {
+        for (i = 0; i < ar; i++)
+            stop[i] = artop[i] = LONG_MIN;
+        for (j = 0; j < bc; j++)
+            brtop[j] = bmtop[j] = LONG_MIN;
+
+        c1 = c0;
+
+        do
+        {
+            _mag_vec_block_extend(stop, sbot, As + c1 * ar, ar);
+            _mag_vec_block_extend(artop, arbot, Ar + c1 * ar, ar);
+            _mag_vec_block_extend(brtop, brbot, Br + c1 * bc, bc);
+            _mag_vec_block_extend(bmtop, bmbot, Bm + c1 * bc, bc);
+            c1++;
+        }
+        while (c1 < w && c1 - c0 < DOUBLE_BLOCK_MAX_LENGTH &&
+            _mag_vec_block_fits(stop, sbot, As + c1 * ar, ar,
+                DOUBLE_MAX_HEIGHT) &&
+            _mag_vec_block_fits(artop, arbot, Ar + c1 * ar, ar,
+                DOUBLE_MAX_HEIGHT) &&
+            _mag_vec_block_fits(brtop, brbot, Br + c1 * bc, bc,
+                DOUBLE_MAX_HEIGHT) &&
+            _mag_vec_block_fits(bmtop, bmbot, Bm + c1 * bc, bc,
+                DOUBLE_MAX_HEIGHT));
+
+        /* Sd = (|mid(A)| + rad(A)) rad(B) */
+        _mag_mat_get_d_scaled(Bd, Br + c0 * bc, brtop, c1 - c0, bc, 0);
+        _mag_mat_get_d_scaled(Ad, As + c0 * ar, stop, c1 - c0, ar, 1);
+        _double_mat_mul(Sd, Ad, Bd, ar, bc, c1 - c0, num_threads);
+
+        /* Rd = rad(A) |mid(B)| */
+        _mag_mat_get_d_scaled(Bd, Bm + c0 * bc, bmtop, c1 - c0, bc, 0);
+        _mag_mat_get_d_scaled(Ad, Ar + c0 * ar, artop, c1 - c0, ar, 1);
+        _double_mat_mul(Rd, Ad, Bd, ar, bc, c1 - c0, num_threads);
+
+        for (i = 0; i < ar; i++)
+        {
+            for (j = 0; j < bc; j++)
+            {
+                if (Sd[i * bc + j] != 0.0)
+                {
+                    fmpz_set_si(e, stop[i] + brtop[j]);
+                    mag_set_d_2exp_fmpz(t,
+                        Sd[i * bc + j] * DOUBLE_ROUNDING_FACTOR, e);
+                    mag_add(arb_radref(arb_mat_entry(C, i, j)),
+                        arb_radref(arb_mat_entry(C, i, j)), t);
+                }
+
+                if (Rd[i * bc + j] != 0.0)
+                {
+                    fmpz_set_si(e, artop[i] + bmtop[j]);
+                    mag_set_d_2exp_fmpz(t,
+                        Rd[i * bc + j] * DOUBLE_ROUNDING_FACTOR, e);
+                    mag_add(arb_radref(arb_mat_entry(C, i, j)),
+                        arb_radref(arb_mat_entry(C, i, j)), t);
+                }
+            }
+        }
+    }
+
+    mag_clear(t);
+    fmpz_clear(e);
+
+    _mag_vec_clear(As, w * ar);
+    _mag_vec_clear(Bm, w * bc);
+    flint_free(Ar);
+    flint_free(Br);
+    flint_free(stop);
+    flint_free(Ad);
+    flint_free(Bd);
+    flint_free(Sd);
+    flint_free(Rd);
+}
+
+void
+_arb_mat_mul_block(arb_mat_t C, const arb_mat_t A, const arb_mat_t B,
+    long prec, long num_threads)
+{
+    long ar, ac, br, bc, i, j, k0, k1, maxheight;
+    long * atop, * abot, * btop, * bbot;
+    arb_ptr AT;
+    int exact;
+
+    ar = arb_mat_nrows(A);
+    ac = arb_mat_ncols(A);
+    br = arb_mat_nrows(B);
+    bc = arb_mat_ncols(B);
+
+    if (ac != br || ar != arb_mat_nrows(C) || bc != arb_mat_ncols(C))
+    {
+        printf("arb_mat_mul_block: incompatible dimensions\n");
+        abort();
+    }
+
+    if (br == 0)
+    {
+        arb_mat_zero(C);
+        return;
+    }
+
+    if (ar == 0 || bc == 0)
+        return;
+
+    if (A == C || B == C)
+    {
+        arb_mat_t T;
+        arb_mat_init(T, ar, bc);
+        _arb_mat_mul_block(T, A, B, prec, num_threads);
+        arb_mat_swap(T, C);
+        arb_mat_clear(T);
+        return;
+    }
+
+    exact = 1;
+
+    if (!_arb_mat_is_lagom(&exact, A) || !_arb_mat_is_lagom(&exact, B))
+    {
+        arb_mat_mul_classical(C, A, B, prec);
+        return;
+    }
+
+    maxheight = ALPHA * prec + BETA;
+
+    /* shallow transpose of A, so that the columns are contiguous */
+    AT = flint_malloc(sizeof(arb_struct) * ar * br);
+
+    for (i = 0; i < ar; i++)
+        for (j = 0; j < br; j++)
+            AT[j * ar + i] = *arb_mat_entry(A, i, j);
+
+    atop = flint_malloc(sizeof(long) * 2 * (ar + bc));
+    abot = atop + ar;
+    btop = abot + ar;
+    bbot = btop + bc;
+
+    arb_mat_zero(C);
+
+    for (k0 = 0; k0 < br; k0 = k1)
+    {
+        for (i = 0; i < ar; i++)
+            atop[i] = LONG_MIN;
+        for (j = 0; j < bc; j++)
+            btop[j] = LONG_MIN;
+
+        k1 = k0;
+
+        do
+        {
+            _arb_mat_block_extend(atop, abot, AT + k1 * ar, ar);
+            _arb_mat_block_extend(btop, bbot, B->rows[k1], bc);
+            k1++;
+        }
+        while (k1 < br &&
+            _arb_mat_block_fits(atop, abot, AT + k1 * ar, ar, maxheight) &&
+            _arb_mat_block_fits(btop, bbot, B->rows[k1], bc, maxheight));
+
+        _arb_mat_addmul_block_mid(C, AT, B, k0, k1, abot, bbot, prec,
+            num_threads);
+
+        if (!exact)
+            _arb_mat_addmul_block_rad(C, AT, B, k0, k1, num_threads);
+    }
+
+    flint_free(AT);
+    flint_free(atop);
+}
+
+void
+arb_mat_mul_block(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long prec)
+{
+    _arb_mat_mul_block(C, A, B, prec, 1);
+}
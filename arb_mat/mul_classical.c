@@ -28,7 +28,8 @@
 void
 arb_mat_mul_classical(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long prec)
 {
-    long ar, ac, br, bc, i, j, k;
+    long ar, ac, br, bc, i, j;
+    arb_ptr tmp;
 
     ar = arb_mat_nrows(A);
     ac = arb_mat_ncols(A);
@@ -57,21 +58,21 @@ arb_mat_mul_classical(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long pr
         return;
     }
 
+    /* shallow transpose of B, so that the columns are contiguous */
+    tmp = flint_malloc(sizeof(arb_struct) * br * bc);
+
+    for (i = 0; i < br; i++)
+        for (j = 0; j < bc; j++)
+            tmp[j * br + i] = *arb_mat_entry(B, i, j);
+
     for (i = 0; i < ar; i++)
     {
         for (j = 0; j < bc; j++)
         {
-            arb_mul(arb_mat_entry(C, i, j),
-                      arb_mat_entry(A, i, 0),
-                      arb_mat_entry(B, 0, j), prec);
-
-            for (k = 1; k < br; k++)
-            {
-                arb_addmul(arb_mat_entry(C, i, j),
-                             arb_mat_entry(A, i, k),
-                             arb_mat_entry(B, k, j), prec);
-            }
+            arb_dot(arb_mat_entry(C, i, j), NULL, 0,
+                A->rows[i], 1, tmp + j * br, 1, br, prec);
         }
     }
-}
 
+    flint_free(tmp);
+}
@@ -24,51 +24,69 @@
 ******************************************************************************/
 
 #include "arb_mat.h"
-#include "pthread.h"
+#include "arb_thread_pool.h"
+
+/*
+    C is divided into tiles of at most ARB_MAT_MUL_TILE_SIDE rows and
+    columns, each tile being one task; tiles are made smaller if there
+    are fewer than a few per thread, so that the pool can balance the
+    load. Within a tile, the inner dimension is traversed in blocks of
+    kb terms, chosen so that the parts of the rows of A and of the
+    columns of B (stored as a shallow transpose BT) used by a full tile
+    fit in about ARB_MAT_MUL_TILE_BYTES. Each block is added to the
+    entries of the tile by one call to arb_dot. The block length only
+    depends on the inner dimension and the precision, so the result
+    does not depend on the number of threads; when the inner dimension
+    fits in one block, it is the same as with arb_mat_mul_classical.
+*/
 
 typedef struct
 {
     arb_ptr * C;
     const arb_ptr * A;
-    const arb_ptr * B;
-    long ar0;
-    long ar1;
-    long bc0;
-    long bc1;
+    arb_srcptr BT;
+    long ar;
     long br;
+    long bc;
+    long tr;
+    long tc;
+    long kb;
     long prec;
 }
 arb_mat_mul_arg_t;
 
-void *
-_arb_mat_mul_thread(void * arg_ptr)
+static void
+_arb_mat_mul_tile(void * arg_ptr, long t)
 {
-    arb_mat_mul_arg_t arg = *((arb_mat_mul_arg_t *) arg_ptr);
-    long i, j, k;
+    arb_mat_mul_arg_t * arg = arg_ptr;
+    long i, j, k, i0, i1, j0, j1, len, ntc;
 
-    for (i = arg.ar0; i < arg.ar1; i++)
+    ntc = (arg->bc + arg->tc - 1) / arg->tc;
+
+    i0 = (t / ntc) * arg->tr;
+    j0 = (t % ntc) * arg->tc;
+    i1 = FLINT_MIN(i0 + arg->tr, arg->ar);
+    j1 = FLINT_MIN(j0 + arg->tc, arg->bc);
+
+    for (k = 0; k < arg->br; k += arg->kb)
     {
-        for (j = arg.bc0; j < arg.bc1; j++)
-        {
-            arb_mul(arg.C[i] + j, arg.A[i] + 0, arg.B[0] + j, arg.prec);
-
-            for (k = 1; k < arg.br; k++)
-            {
-                arb_addmul(arg.C[i] + j, arg.A[i] + k, arg.B[k] + j, arg.prec);
-            }
-        }
-    }
+        len = FLINT_MIN(arg->kb, arg->br - k);
 
-    flint_cleanup();
-    return NULL;
+        for (i = i0; i < i1; i++)
+            for (j = j0; j < j1; j++)
+                arb_dot(arg->C[i] + j, (k == 0) ? NULL : arg->C[i] + j, 0,
+                    arg->A[i] + k, 1, arg->BT + j * arg->br + k, 1,
+                    len, arg->prec);
+    }
 }
 
 void
-arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long prec)
+_arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B,
+    long prec, long num_threads)
 {
-    long ar, ac, br, bc, i, num_threads;
-    pthread_t * threads;
-    arb_mat_mul_arg_t * args;
+    long ar, ac, br, bc, i, j, t, entry, ntiles;
+    arb_ptr tmp;
+    arb_mat_mul_arg_t arg;
 
     ar = arb_mat_nrows(A);
     ac = arb_mat_ncols(A);
@@ -77,7 +95,7 @@ arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long pre
 
     if (ac != br || ar != arb_mat_nrows(C) || bc != arb_mat_ncols(C))
     {
-        printf("arb_mat_mul_threaded: incompatible dimensions\n");
+        printf("arb_mat_mul: incompatible dimensions\n");
         abort();
     }
 
@@ -87,52 +105,60 @@ arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long pre
         return;
     }
 
+    if (ar == 0 || bc == 0)
+        return;
+
     if (A == C || B == C)
     {
         arb_mat_t T;
         arb_mat_init(T, ar, bc);
-        arb_mat_mul_threaded(T, A, B, prec);
+        _arb_mat_mul_threaded(T, A, B, prec, num_threads);
         arb_mat_swap(T, C);
         arb_mat_clear(T);
         return;
     }
 
-    num_threads = flint_get_num_threads();
-    threads = flint_malloc(sizeof(pthread_t) * num_threads);
-    args = flint_malloc(sizeof(arb_mat_mul_arg_t) * num_threads);
+    /* approximate size of an entry, including limbs stored on the heap */
+    entry = sizeof(arb_struct);
+    if (prec > ARF_NOPTR_LIMBS * FLINT_BITS)
+        entry += ((prec + FLINT_BITS - 1) / FLINT_BITS) * sizeof(mp_limb_t);
 
-    for (i = 0; i < num_threads; i++)
-    {
-        args[i].C = C->rows;
-        args[i].A = A->rows;
-        args[i].B = B->rows;
-
-        if (ar >= bc)
-        {
-            args[i].ar0 = (ar * i) / num_threads;
-            args[i].ar1 = (ar * (i + 1)) / num_threads;
-            args[i].bc0 = 0;
-            args[i].bc1 = bc;
-        }
-        else
-        {
-            args[i].ar0 = 0;
-            args[i].ar1 = ar;
-            args[i].bc0 = (bc * i) / num_threads;
-            args[i].bc1 = (bc * (i + 1)) / num_threads;
-        }
-
-        args[i].br = br;
-        args[i].prec = prec;
-        pthread_create(&threads[i], NULL, _arb_mat_mul_thread, &args[i]);
-    }
+    /* at high precision the arithmetic dominates, and longer blocks
+       add fewer rounding errors */
+    arg.kb = ARB_MAT_MUL_TILE_BYTES / (2 * ARB_MAT_MUL_TILE_SIDE * entry);
+    arg.kb = FLINT_MAX(arg.kb, 64);
 
-    for (i = 0; i < num_threads; i++)
-    {
-        pthread_join(threads[i], NULL);
-    }
+    t = ARB_MAT_MUL_TILE_SIDE;
+    while (t > 1 && ((ar + t - 1) / t) * ((bc + t - 1) / t) < 4 * num_threads)
+        t = (t + 1) / 2;
 
-    flint_free(threads);
-    flint_free(args);
+    arg.tr = FLINT_MIN(t, ar);
+    arg.tc = FLINT_MIN(t, bc);
+    ntiles = ((ar + arg.tr - 1) / arg.tr) * ((bc + arg.tc - 1) / arg.tc);
+
+    /* shallow transpose of B, shared by all threads */
+    tmp = flint_malloc(sizeof(arb_struct) * br * bc);
+
+    for (i = 0; i < br; i++)
+        for (j = 0; j < bc; j++)
+            tmp[j * br + i] = *arb_mat_entry(B, i, j);
+
+    arg.C = C->rows;
+    arg.A = A->rows;
+    arg.BT = tmp;
+    arg.ar = ar;
+    arg.br = br;
+    arg.bc = bc;
+    arg.prec = prec;
+
+    arb_thread_pool_parallel_do(_arb_mat_mul_tile, &arg, ntiles, num_threads);
+
+    flint_free(tmp);
+}
+
+void
+arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, long prec)
+{
+    _arb_mat_mul_threaded(C, A, B, prec, flint_get_num_threads());
 }
 
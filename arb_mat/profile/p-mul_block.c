@@ -0,0 +1,82 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_mat.h"
+#include "profiler.h"
+
+/*
+    Compares arb_mat_mul_classical with arb_mat_mul_block for square
+    matrices of various sizes and precisions. This can be used to tune
+    ARB_MAT_MUL_BLOCK_CUTOFF.
+*/
+
+int main()
+{
+    long n, prec, i, reps;
+    arb_mat_t A, B, C;
+    flint_rand_t state;
+    timeit_t t0, t1;
+
+    flint_randinit(state);
+
+    for (prec = 64; prec <= 4096; prec *= 4)
+    {
+        for (n = 4; n <= 256; n *= 2)
+        {
+            arb_mat_init(A, n, n);
+            arb_mat_init(B, n, n);
+            arb_mat_init(C, n, n);
+
+            arb_mat_randtest(A, state, prec, 4);
+            arb_mat_randtest(B, state, prec, 4);
+
+            reps = FLINT_MAX(1, 10000000 / (n * n * n * prec));
+
+            timeit_start(t0);
+            for (i = 0; i < reps; i++)
+                arb_mat_mul_classical(C, A, B, prec);
+            timeit_stop(t0);
+
+            timeit_start(t1);
+            for (i = 0; i < reps; i++)
+                arb_mat_mul_block(C, A, B, prec);
+            timeit_stop(t1);
+
+            printf("prec = %4ld  n = %4ld  reps = %6ld  "
+                "classical: %6ld ms  block: %6ld ms  speedup: %.2f\n",
+                prec, n, reps, (long) t0->cpu, (long) t1->cpu,
+                (double) t0->cpu / FLINT_MAX(t1->cpu, 1));
+
+            arb_mat_clear(A);
+            arb_mat_clear(B);
+            arb_mat_clear(C);
+        }
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    return EXIT_SUCCESS;
+}
+
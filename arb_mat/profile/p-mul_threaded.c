@@ -0,0 +1,147 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_mat.h"
+#include "profiler.h"
+
+/*
+    Compares arb_mat_mul_classical with _arb_mat_mul_threaded using
+    various numbers of threads, for square matrices of various sizes
+    and precisions, and prints the number of threads chosen by
+    _arb_mat_mul_num_threads. This can be used to tune
+    ARB_MAT_MUL_THREAD_WORK: the heuristic should pick more than one
+    thread roughly where the threaded version starts to win.
+
+    Then, for sizes above ARB_MAT_MUL_BLOCK_CUTOFF(prec), compares the
+    threaded classical multiplication with the threaded block
+    multiplication, for the same numbers of threads.
+
+    The maximum number of threads can be given as an argument.
+*/
+
+int main(int argc, char * argv[])
+{
+    long n, prec, i, reps, threads, max_threads, best, best_time;
+    arb_mat_t A, B, C;
+    flint_rand_t state;
+    timeit_t t0, t1;
+
+    max_threads = (argc > 1) ? atol(argv[1]) : 8;
+    max_threads = FLINT_MAX(max_threads, 1);
+
+    flint_randinit(state);
+    flint_set_num_threads(max_threads);
+
+    for (prec = 64; prec <= 512; prec *= 2)
+    {
+        for (n = 4; n <= 256; n *= 2)
+        {
+            arb_mat_init(A, n, n);
+            arb_mat_init(B, n, n);
+            arb_mat_init(C, n, n);
+
+            arb_mat_randtest(A, state, prec, 4);
+            arb_mat_randtest(B, state, prec, 4);
+
+            reps = FLINT_MAX(1, 10000000 / (n * n * n * prec));
+
+            timeit_start(t0);
+            for (i = 0; i < reps; i++)
+                arb_mat_mul_classical(C, A, B, prec);
+            timeit_stop(t0);
+
+            printf("prec = %4ld  n = %4ld  reps = %6ld  classical: %6ld ms",
+                prec, n, reps, (long) t0->wall);
+
+            best = 1;
+            best_time = t0->wall;
+
+            for (threads = 2; threads <= max_threads; threads *= 2)
+            {
+                timeit_start(t1);
+                for (i = 0; i < reps; i++)
+                    _arb_mat_mul_threaded(C, A, B, prec, threads);
+                timeit_stop(t1);
+
+                printf("  %ld: %6ld ms", threads, (long) t1->wall);
+
+                if (t1->wall < best_time)
+                {
+                    best = threads;
+                    best_time = t1->wall;
+                }
+            }
+
+            printf("  best: %ld  chosen: %ld\n", best,
+                _arb_mat_mul_num_threads(n, n, n, prec));
+
+            arb_mat_clear(A);
+            arb_mat_clear(B);
+            arb_mat_clear(C);
+        }
+    }
+
+    for (prec = 64; prec <= 512; prec *= 2)
+    {
+        for (n = 64; n <= 1024; n *= 2)
+        {
+            if (n < ARB_MAT_MUL_BLOCK_CUTOFF(prec))
+                continue;
+
+            arb_mat_init(A, n, n);
+            arb_mat_init(B, n, n);
+            arb_mat_init(C, n, n);
+
+            arb_mat_randtest(A, state, prec, 4);
+            arb_mat_randtest(B, state, prec, 4);
+
+            printf("prec = %4ld  n = %4ld  chosen: %ld\n", prec, n,
+                _arb_mat_mul_num_threads(n, n, n, prec));
+
+            for (threads = 1; threads <= max_threads; threads *= 2)
+            {
+                timeit_start(t0);
+                _arb_mat_mul_threaded(C, A, B, prec, threads);
+                timeit_stop(t0);
+
+                timeit_start(t1);
+                _arb_mat_mul_block(C, A, B, prec, threads);
+                timeit_stop(t1);
+
+                printf("    threads = %ld  threaded: %8ld ms  block: %8ld ms\n",
+                    threads, (long) t0->wall, (long) t1->wall);
+            }
+
+            arb_mat_clear(A);
+            arb_mat_clear(B);
+            arb_mat_clear(C);
+        }
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    return EXIT_SUCCESS;
+}
+
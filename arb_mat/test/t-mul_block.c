@@ -0,0 +1,244 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2012 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_mat.h"
+
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("mul_block....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000; iter++)
+    {
+        long m, n, k, qbits1, qbits2, rbits1, rbits2, rbits3;
+        fmpq_mat_t A, B, C;
+        arb_mat_t a, b, c, d;
+
+        qbits1 = 2 + n_randint(state, 200);
+        qbits2 = 2 + n_randint(state, 200);
+        rbits1 = 2 + n_randint(state, 200);
+        rbits2 = 2 + n_randint(state, 200);
+        rbits3 = 2 + n_randint(state, 200);
+
+        m = n_randint(state, 10);
+        n = n_randint(state, 10);
+        k = n_randint(state, 10);
+
+        fmpq_mat_init(A, m, n);
+        fmpq_mat_init(B, n, k);
+        fmpq_mat_init(C, m, k);
+
+        arb_mat_init(a, m, n);
+        arb_mat_init(b, n, k);
+        arb_mat_init(c, m, k);
+        arb_mat_init(d, m, k);
+
+        fmpq_mat_randtest(A, state, qbits1);
+        fmpq_mat_randtest(B, state, qbits2);
+        fmpq_mat_mul(C, A, B);
+
+        arb_mat_set_fmpq_mat(a, A, rbits1);
+        arb_mat_set_fmpq_mat(b, B, rbits2);
+        arb_mat_mul_block(c, a, b, rbits3);
+
+        if (!arb_mat_contains_fmpq_mat(c, C))
+        {
+            printf("FAIL\n\n");
+            printf("m = %ld, n = %ld, k = %ld, bits3 = %ld\n", m, n, k, rbits3);
+
+            printf("A = "); fmpq_mat_print(A); printf("\n\n");
+            printf("B = "); fmpq_mat_print(B); printf("\n\n");
+            printf("C = "); fmpq_mat_print(C); printf("\n\n");
+
+            printf("a = "); arb_mat_printd(a, 15); printf("\n\n");
+            printf("b = "); arb_mat_printd(b, 15); printf("\n\n");
+            printf("c = "); arb_mat_printd(c, 15); printf("\n\n");
+
+            abort();
+        }
+
+        /* test aliasing with a */
+        if (arb_mat_nrows(a) == arb_mat_nrows(c) &&
+            arb_mat_ncols(a) == arb_mat_ncols(c))
+        {
+            arb_mat_set(d, a);
+            arb_mat_mul_block(d, d, b, rbits3);
+            if (!arb_mat_equal(d, c))
+            {
+                printf("FAIL (aliasing 1)\n\n");
+                abort();
+            }
+        }
+
+        /* test aliasing with b */
+        if (arb_mat_nrows(b) == arb_mat_nrows(c) &&
+            arb_mat_ncols(b) == arb_mat_ncols(c))
+        {
+            arb_mat_set(d, b);
+            arb_mat_mul_block(d, a, d, rbits3);
+            if (!arb_mat_equal(d, c))
+            {
+                printf("FAIL (aliasing 2)\n\n");
+                abort();
+            }
+        }
+
+        fmpq_mat_clear(A);
+        fmpq_mat_clear(B);
+        fmpq_mat_clear(C);
+
+        arb_mat_clear(a);
+        arb_mat_clear(b);
+        arb_mat_clear(c);
+        arb_mat_clear(d);
+    }
+
+    /* compare with classical multiplication for random balls */
+    for (iter = 0; iter < 10000; iter++)
+    {
+        long m, n, k, prec;
+        arb_mat_t a, b, c, d;
+
+        prec = 2 + n_randint(state, 300);
+
+        m = n_randint(state, 12);
+        n = n_randint(state, 12);
+        k = n_randint(state, 12);
+
+        arb_mat_init(a, m, n);
+        arb_mat_init(b, n, k);
+        arb_mat_init(c, m, k);
+        arb_mat_init(d, m, k);
+
+        arb_mat_randtest(a, state, 2 + n_randint(state, 200), 1 + n_randint(state, 12));
+        arb_mat_randtest(b, state, 2 + n_randint(state, 200), 1 + n_randint(state, 12));
+
+        arb_mat_mul_block(c, a, b, prec);
+        arb_mat_mul_classical(d, a, b, prec);
+
+        if (!arb_mat_overlaps(c, d))
+        {
+            printf("FAIL (classical)\n\n");
+            printf("a = "); arb_mat_printd(a, 15); printf("\n\n");
+            printf("b = "); arb_mat_printd(b, 15); printf("\n\n");
+            printf("c = "); arb_mat_printd(c, 15); printf("\n\n");
+            printf("d = "); arb_mat_printd(d, 15); printf("\n\n");
+            abort();
+        }
+
+        /* the result must not depend on the number of threads */
+        _arb_mat_mul_block(d, a, b, prec, 1 + n_randint(state, 4));
+
+        if (!arb_mat_equal(c, d))
+        {
+            printf("FAIL (threads)\n\n");
+            printf("a = "); arb_mat_printd(a, 15); printf("\n\n");
+            printf("b = "); arb_mat_printd(b, 15); printf("\n\n");
+            printf("c = "); arb_mat_printd(c, 15); printf("\n\n");
+            printf("d = "); arb_mat_printd(d, 15); printf("\n\n");
+            abort();
+        }
+
+        arb_mat_clear(a);
+        arb_mat_clear(b);
+        arb_mat_clear(c);
+        arb_mat_clear(d);
+    }
+
+    /* at high precision, the radii must be as accurate as those
+       computed by classical multiplication */
+    for (iter = 0; iter < 200; iter++)
+    {
+        long m, n, k, i, j, prec, mag_bits;
+        arb_mat_t a, b, c, d;
+        mag_t t;
+
+        prec = 500 + n_randint(state, 3500);
+        mag_bits = 1 + n_randint(state, 10);
+
+        m = 1 + n_randint(state, 20);
+        n = 1 + n_randint(state, 20);
+        k = 1 + n_randint(state, 20);
+
+        arb_mat_init(a, m, n);
+        arb_mat_init(b, n, k);
+        arb_mat_init(c, m, k);
+        arb_mat_init(d, m, k);
+        mag_init(t);
+
+        for (i = 0; i < m; i++)
+            for (j = 0; j < n; j++)
+                arb_randtest_precise(arb_mat_entry(a, i, j), state,
+                    prec, mag_bits);
+
+        for (i = 0; i < n; i++)
+            for (j = 0; j < k; j++)
+                arb_randtest_precise(arb_mat_entry(b, i, j), state,
+                    prec, mag_bits);
+
+        arb_mat_mul_block(c, a, b, prec);
+        arb_mat_mul_classical(d, a, b, prec);
+
+        for (i = 0; i < m; i++)
+        {
+            for (j = 0; j < k; j++)
+            {
+                /* rad(c) <= 16 (rad(d) + 2^-prec |d|) */
+                arb_get_mag(t, arb_mat_entry(d, i, j));
+                mag_mul_2exp_si(t, t, -prec);
+                mag_add(t, t, arb_radref(arb_mat_entry(d, i, j)));
+                mag_mul_2exp_si(t, t, 4);
+
+                if (!arb_overlaps(arb_mat_entry(c, i, j),
+                        arb_mat_entry(d, i, j)) ||
+                    mag_cmp(arb_radref(arb_mat_entry(c, i, j)), t) > 0)
+                {
+                    printf("FAIL (accuracy)\n\n");
+                    printf("prec = %ld, i = %ld, j = %ld\n\n", prec, i, j);
+                    printf("c = "); arb_printd(arb_mat_entry(c, i, j), 30); printf("\n\n");
+                    printf("d = "); arb_printd(arb_mat_entry(d, i, j), 30); printf("\n\n");
+                    abort();
+                }
+            }
+        }
+
+        arb_mat_clear(a);
+        arb_mat_clear(b);
+        arb_mat_clear(c);
+        arb_mat_clear(d);
+        mag_clear(t);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
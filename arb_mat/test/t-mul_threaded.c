@@ -70,6 +70,7 @@ int main()
         arb_mat_set_fmpq_mat(a, A, rbits1);
         arb_mat_set_fmpq_mat(b, B, rbits2);
         arb_mat_mul_threaded(c, a, b, rbits3);
+        arb_mat_mul_classical(d, a, b, rbits3);
 
         if (!arb_mat_contains_fmpq_mat(c, C))
         {
@@ -88,6 +89,15 @@ int main()
             abort();
         }
 
+        /* the inner dimension fits in a single block */
+        if (!arb_mat_equal(c, d))
+        {
+            printf("FAIL (classical)\n\n");
+            printf("c = "); arb_mat_printd(c, 15); printf("\n\n");
+            printf("d = "); arb_mat_printd(d, 15); printf("\n\n");
+            abort();
+        }
+
         /* test aliasing with a */
         if (arb_mat_nrows(a) == arb_mat_nrows(c) &&
             arb_mat_ncols(a) == arb_mat_ncols(c))
@@ -124,6 +134,56 @@ int main()
         arb_mat_clear(d);
     }
 
+    /* long inner dimension, traversed in several blocks */
+    for (iter = 0; iter < 300; iter++)
+    {
+        long m, n, k, prec;
+        arb_mat_t a, b, c, d;
+
+        prec = 2 + n_randint(state, 600);
+
+        m = 1 + n_randint(state, 6);
+        n = 100 + n_randint(state, 1000);
+        k = 1 + n_randint(state, 6);
+
+        arb_mat_init(a, m, n);
+        arb_mat_init(b, n, k);
+        arb_mat_init(c, m, k);
+        arb_mat_init(d, m, k);
+
+        arb_mat_randtest(a, state, 2 + n_randint(state, 200), 10);
+        arb_mat_randtest(b, state, 2 + n_randint(state, 200), 10);
+
+        _arb_mat_mul_threaded(c, a, b, prec, 1);
+        arb_mat_mul_classical(d, a, b, prec);
+
+        if (!arb_mat_overlaps(c, d))
+        {
+            printf("FAIL (blocks)\n\n");
+            printf("m = %ld, n = %ld, k = %ld, prec = %ld\n\n", m, n, k, prec);
+            printf("c = "); arb_mat_printd(c, 15); printf("\n\n");
+            printf("d = "); arb_mat_printd(d, 15); printf("\n\n");
+            abort();
+        }
+
+        /* the result must not depend on the number of threads */
+        _arb_mat_mul_threaded(d, a, b, prec, 2 + n_randint(state, 4));
+
+        if (!arb_mat_equal(c, d))
+        {
+            printf("FAIL (threads)\n\n");
+            printf("m = %ld, n = %ld, k = %ld, prec = %ld\n\n", m, n, k, prec);
+            printf("c = "); arb_mat_printd(c, 15); printf("\n\n");
+            printf("d = "); arb_mat_printd(d, 15); printf("\n\n");
+            abort();
+        }
+
+        arb_mat_clear(a);
+        arb_mat_clear(b);
+        arb_mat_clear(c);
+        arb_mat_clear(d);
+    }
+
     flint_randclear(state);
     flint_cleanup();
     printf("PASS\n");
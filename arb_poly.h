@@ -230,10 +230,27 @@ void arb_poly_mullow_classical(arb_poly_t res, const arb_poly_t poly1,
                                             const arb_poly_t poly2,
                                                 long n, long prec);
 
+/* Parameters of the cost model used to split the midpoints into blocks
+   in _arb_poly_mullow_block; these can be fitted with the program in
+   arb_poly/tune. */
+#ifndef ARB_POLY_MULLOW_BLOCK_ALPHA
+#define ARB_POLY_MULLOW_BLOCK_ALPHA 1.0
+#endif
+
+#ifndef ARB_POLY_MULLOW_BLOCK_BETA
+#define ARB_POLY_MULLOW_BLOCK_BETA 64.0
+#endif
+
+void _arb_poly_mullow_block_params(arb_ptr z, arb_srcptr x, long xlen,
+    arb_srcptr y, long ylen, long n, long prec, double alpha, double beta);
+
 void _arb_poly_mullow_block(arb_ptr C,
     arb_srcptr A, long lenA,
     arb_srcptr B, long lenB, long n, long prec);
 
+void _arb_poly_mullow_block_rad(arb_ptr z, mag_srcptr x, long xlen,
+    mag_srcptr y, long ylen, long lo, long n, const fmpz_t scale);
+
 void arb_poly_mullow_block(arb_poly_t res, const arb_poly_t poly1,
               const arb_poly_t poly2, long len, long prec);
 
@@ -244,6 +261,28 @@ void _arb_poly_mullow(arb_ptr C,
 void arb_poly_mullow(arb_poly_t res, const arb_poly_t poly1,
               const arb_poly_t poly2, long len, long prec);
 
+void _arb_poly_mulmid_classical(arb_ptr res,
+    arb_srcptr poly1, long len1,
+    arb_srcptr poly2, long len2, long lo, long hi, long prec);
+
+void _arb_poly_mulmid_block(arb_ptr res,
+    arb_srcptr poly1, long len1,
+    arb_srcptr poly2, long len2, long lo, long hi, long prec);
+
+void _arb_poly_mulmid(arb_ptr res,
+    arb_srcptr poly1, long len1,
+    arb_srcptr poly2, long len2, long lo, long hi, long prec);
+
+void arb_poly_mulmid(arb_poly_t res, const arb_poly_t poly1,
+    const arb_poly_t poly2, long lo, long hi, long prec);
+
+void _arb_poly_mulhigh(arb_ptr res,
+    arb_srcptr poly1, long len1,
+    arb_srcptr poly2, long len2, long lo, long prec);
+
+void arb_poly_mulhigh(arb_poly_t res, const arb_poly_t poly1,
+    const arb_poly_t poly2, long lo, long prec);
+
 void _arb_poly_mul(arb_ptr C,
     arb_srcptr A, long lenA,
     arb_srcptr B, long lenB, long prec);
@@ -605,6 +644,12 @@ void arb_poly_zeta_series(arb_poly_t res, const arb_poly_t f, const arb_t a, int
 void _arb_poly_riemann_siegel_theta_series(arb_ptr res, arb_srcptr h, long hlen, long len, long prec);
 void arb_poly_riemann_siegel_theta_series(arb_poly_t res, const arb_poly_t h, long n, long prec);
 
+#define ARB_POLY_RIEMANN_SIEGEL_MIN_T 1000
+#define ARB_POLY_RIEMANN_SIEGEL_MAX_K 4
+
+long _arb_poly_riemann_siegel_rs_terms(const arb_t t, long prec);
+int _arb_poly_riemann_siegel_z_rs(arb_t res, const arb_t t, long K, long prec);
+
 void _arb_poly_riemann_siegel_z_series(arb_ptr res, arb_srcptr h, long hlen, long len, long prec);
 void arb_poly_riemann_siegel_z_series(arb_poly_t res, const arb_poly_t h, long n, long prec);
 
@@ -46,16 +46,14 @@ _arb_poly_evaluate2_horner(arb_t y, arb_t z, arb_srcptr poly,
     }
     else if (len == 2)
     {
-        arb_mul(y, x, poly + 1, prec);
-        arb_add(y, y, poly + 0, prec);
+        arb_dot(y, poly + 0, 0, x, 1, poly + 1, 1, 1, prec);
         arb_set_round(z, poly + 1, prec);
     }
     else
     {
-        arb_t t, u, v;
+        arb_t u, v;
         long i;
 
-        arb_init(t);
         arb_init(u);
         arb_init(v);
 
@@ -64,16 +62,13 @@ _arb_poly_evaluate2_horner(arb_t y, arb_t z, arb_srcptr poly,
 
         for (i = len - 2; i >= 0; i--)
         {
-            arb_mul(t, v, x, prec);
-            arb_add(v, u, t, prec);
-            arb_mul(t, u, x, prec);
-            arb_add(u, t, poly + i, prec);
+            arb_dot(v, u, 0, v, 1, x, 1, 1, prec);
+            arb_dot(u, poly + i, 0, u, 1, x, 1, 1, prec);
         }
 
         arb_swap(y, u);
         arb_swap(z, v);
 
-        arb_clear(t);
         arb_clear(u);
         arb_clear(v);
     }
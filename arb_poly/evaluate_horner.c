@@ -40,27 +40,22 @@ _arb_poly_evaluate_horner(arb_t y, arb_srcptr f, long len,
     }
     else if (len == 2)
     {
-        arb_mul(y, x, f + 1, prec);
-        arb_add(y, y, f + 0, prec);
+        arb_dot(y, f + 0, 0, x, 1, f + 1, 1, 1, prec);
     }
     else
     {
         long i = len - 1;
-        arb_t t, u;
+        arb_t u;
 
-        arb_init(t);
         arb_init(u);
         arb_set(u, f + i);
 
+        /* u = f[i] + u x, rounded once */
         for (i = len - 2; i >= 0; i--)
-        {
-            arb_mul(t, u, x, prec);
-            arb_add(u, f + i, t, prec);
-        }
+            arb_dot(u, f + i, 0, u, 1, x, 1, 1, prec);
 
         arb_swap(y, u);
 
-        arb_clear(t);
         arb_clear(u);
     }
 }
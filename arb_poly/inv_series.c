@@ -19,7 +19,7 @@
 =============================================================================*/
 /******************************************************************************
 
-    Copyright (C) 2012, 2013 Fredrik Johansson
+    Copyright (C) 2012, 2013, 2015 Fredrik Johansson
 
 ******************************************************************************/
 
@@ -60,8 +60,9 @@ _arb_poly_inv_series(arb_ptr Qinv,
         Qnlen = FLINT_MIN(Qlen, n);
         Wlen = FLINT_MIN(Qnlen + m - 1, n);
         W2len = Wlen - m;
-        MULLOW(W, Q, Qnlen, Qinv, m, Wlen, prec);
-        MULLOW(Qinv + m, Qinv, m, W + m, W2len, n - m, prec);
+        /* the low m coefficients of Q Qinv are 1 + O(x^m) */
+        _arb_poly_mulmid(W, Q, Qnlen, Qinv, m, m, Wlen, prec);
+        MULLOW(Qinv + m, Qinv, m, W, W2len, n - m, prec);
         _arb_vec_neg(Qinv + m, Qinv + m, n - m);
 
         NEWTON_END_LOOP
@@ -19,12 +19,13 @@
 =============================================================================*/
 /******************************************************************************
 
-    Copyright (C) 2014 Fredrik Johansson
+    Copyright (C) 2014, 2015 Fredrik Johansson
 
 ******************************************************************************/
 
 #include <math.h>
 #include "arb_poly.h"
+#include "arb_thread_pool.h"
 
 void
 _arb_poly_get_scale(fmpz_t scale, arb_srcptr x, long xlen,
@@ -63,11 +64,13 @@ _arb_poly_get_scale(fmpz_t scale, arb_srcptr x, long xlen,
     }
 }
 
-/* Break vector into same-exponent blocks where the largest block
-   has a height of at most ALPHA*prec + BETA bits. These are just
+/* Break radius vectors into same-exponent blocks where the largest block
+   has a height of at most ALPHA*MAG_BITS + BETA bits. These are just
    tuning parameters. Note that ALPHA * MAG_BITS + BETA
    should be smaller than DOUBLE_BLOCK_MAX_HEIGHT if we want to use
-   doubles for error bounding. */
+   doubles for error bounding. The midpoints are split using a cost
+   model (see below), with ALPHA*prec + BETA as an upper bound for the
+   height of a block. */
 #define ALPHA 3.0
 #define BETA 512
 
@@ -97,6 +100,374 @@ _arb_poly_get_scale(fmpz_t scale, arb_srcptr x, long xlen,
 #define DOUBLE_BLOCK_SHIFT (DOUBLE_BLOCK_MAX_HEIGHT / 2)
 
 
+/* Minimum length of the pieces when splitting an integer polynomial
+   product, a double convolution or a vector operation between threads.
+   These are just tuning parameters. */
+#define THREAD_MIN_LEN 256
+#define THREAD_MIN_DOUBLE_WORK 1000000
+#define THREAD_MIN_VEC_LEN 1024
+
+/*
+    With several threads, a product of integer polynomials is split into
+    products of blocks of both operands: with blocks of length L, the
+    block pair (i, j) contributes to the coefficients starting at
+    (i + j) L, so only the pairs in the lower triangle i + j < n / L
+    are needed. The partial products are then added. Since this is
+    exact, the output does not depend on the number of threads.
+    The double convolutions and the final additions are split over
+    ranges of output coefficients, which are independent.
+
+    Splitting only one operand would make every piece about as expensive
+    as the whole product (the pieces are unbalanced), limiting the speedup
+    to about 2. With balanced L x L blocks, each block costs about L/n of
+    the whole product, and there are about (n/L)^2 / 2 of them, so with
+    T threads the speedup approaches sqrt(2T).
+*/
+
+typedef struct
+{
+    fmpz * res;
+    const fmpz * x;
+    const fmpz * y;
+    long xlen;
+    long ylen;
+    long n;
+    long offset;
+}
+fmpz_mullow_arg_t;
+
+static void
+_fmpz_poly_mullow_worker(void * args, long i)
+{
+    fmpz_mullow_arg_t * arg = ((fmpz_mullow_arg_t *) args) + i;
+
+    if (arg->n <= 0)
+        return;
+
+    if (arg->xlen >= arg->ylen)
+        _fmpz_poly_mullow(arg->res, arg->x, arg->xlen,
+            arg->y, arg->ylen, arg->n);
+    else
+        _fmpz_poly_mullow(arg->res, arg->y, arg->ylen,
+            arg->x, arg->xlen, arg->n);
+}
+
+typedef struct
+{
+    fmpz * res;
+    const fmpz_mullow_arg_t * pieces;
+    long num_pieces;
+    long k0;
+    long k1;
+}
+fmpz_sum_arg_t;
+
+static void
+_fmpz_poly_mullow_sum_worker(void * args, long i)
+{
+    fmpz_sum_arg_t * arg = ((fmpz_sum_arg_t *) args) + i;
+    const fmpz_mullow_arg_t * p;
+    long j, k, lo, hi;
+
+    _fmpz_vec_zero(arg->res + arg->k0, arg->k1 - arg->k0);
+
+    for (j = 0; j < arg->num_pieces; j++)
+    {
+        p = arg->pieces + j;
+        lo = FLINT_MAX(arg->k0, p->offset);
+        hi = FLINT_MIN(arg->k1, p->offset + p->n);
+
+        for (k = lo; k < hi; k++)
+            fmpz_add(arg->res + k, arg->res + k, p->res + k - p->offset);
+    }
+}
+
+/* Number of block products for blocks of length L. */
+static long
+_fmpz_poly_mullow_num_blocks(long xlen, long ylen, long n, long L)
+{
+    long i, nx, ny, num;
+
+    nx = (xlen + L - 1) / L;
+    ny = (ylen + L - 1) / L;
+    num = 0;
+
+    for (i = 0; i < nx; i++)
+        num += FLINT_MIN(ny, (n - i * L + L - 1) / L);
+
+    return num;
+}
+
+/* res = x * y mod t^n, requires 0 < n <= xlen + ylen - 1 */
+static void
+_fmpz_poly_mullow_threaded(fmpz * res, const fmpz * x, long xlen,
+    const fmpz * y, long ylen, long n)
+{
+    fmpz_mullow_arg_t * pieces;
+    fmpz_sum_arg_t * sums;
+    long i, j, a, b, L, best_L, num, num_pieces, num_threads;
+    double cost, best_cost;
+
+    xlen = FLINT_MIN(xlen, n);
+    ylen = FLINT_MIN(ylen, n);
+
+    num_threads = flint_get_num_threads();
+
+    if (num_threads <= 1 || FLINT_MIN(xlen, ylen) < THREAD_MIN_LEN)
+    {
+        if (xlen >= ylen)
+            _fmpz_poly_mullow(res, x, xlen, y, ylen, n);
+        else
+            _fmpz_poly_mullow(res, y, ylen, x, xlen, n);
+        return;
+    }
+
+    /* Choose the block length minimizing the estimated time, taking
+       the cost of a block product to be proportional to its length
+       and running ceil(num / num_threads) rounds of them. Using the
+       whole product as a single block is the serial case. */
+    best_L = FLINT_MAX(xlen, ylen);
+    best_cost = 2.0 * best_L;
+
+    for (i = 2; i <= 4 * num_threads; i++)
+    {
+        L = (FLINT_MAX(xlen, ylen) + i - 1) / i;
+
+        if (L < THREAD_MIN_LEN)
+            break;
+
+        num = _fmpz_poly_mullow_num_blocks(xlen, ylen, n, L);
+        cost = (double) ((num + num_threads - 1) / num_threads) *
+            (FLINT_MIN(L, xlen) + FLINT_MIN(L, ylen));
+
+        if (cost < best_cost)
+        {
+            best_cost = cost;
+            best_L = L;
+        }
+    }
+
+    L = best_L;
+    num_pieces = _fmpz_poly_mullow_num_blocks(xlen, ylen, n, L);
+
+    if (num_pieces <= 1)
+    {
+        if (xlen >= ylen)
+            _fmpz_poly_mullow(res, x, xlen, y, ylen, n);
+        else
+            _fmpz_poly_mullow(res, y, ylen, x, xlen, n);
+        return;
+    }
+
+    pieces = flint_malloc(sizeof(fmpz_mullow_arg_t) * num_pieces);
+    sums = flint_malloc(sizeof(fmpz_sum_arg_t) * num_threads);
+
+    num = 0;
+    for (a = 0; a < xlen; a += L)
+    {
+        for (b = 0; b < ylen && a + b < n; b += L)
+        {
+            pieces[num].x = x + a;
+            pieces[num].xlen = FLINT_MIN(L, xlen - a);
+            pieces[num].y = y + b;
+            pieces[num].ylen = FLINT_MIN(L, ylen - b);
+            pieces[num].n = FLINT_MIN(pieces[num].xlen +
+                pieces[num].ylen - 1, n - a - b);
+            pieces[num].offset = a + b;
+            pieces[num].res = _fmpz_vec_init(pieces[num].n);
+            num++;
+        }
+    }
+
+    arb_thread_pool_parallel_do(_fmpz_poly_mullow_worker, pieces,
+        num_pieces, num_threads);
+
+    for (i = 0; i < num_threads; i++)
+    {
+        sums[i].res = res;
+        sums[i].pieces = pieces;
+        sums[i].num_pieces = num_pieces;
+        sums[i].k0 = (n * i) / num_threads;
+        sums[i].k1 = (n * (i + 1)) / num_threads;
+    }
+
+    arb_thread_pool_parallel_do(_fmpz_poly_mullow_sum_worker, sums,
+        num_threads, num_threads);
+
+    for (j = 0; j < num_pieces; j++)
+        _fmpz_vec_clear(pieces[j].res, pieces[j].n);
+
+    flint_free(pieces);
+    flint_free(sums);
+}
+
+/* Sets {res + k0, n - k0} to the coefficients k0 <= k < n of x * y,
+   skipping the leading terms of x and y that do not contribute to them.
+   The entries of res below k0 are undefined (but may be computed:
+   this is a truncated product of the trimmed operands, not a true
+   middle product, and it only gets shorter when k0 exceeds the
+   length of one of the operands). Requires 0 <= k0 < n
+   and n <= xlen + ylen - 1. A square stays a square. */
+static void
+_fmpz_poly_mullow_trim(fmpz * res, const fmpz * x, long xlen,
+    const fmpz * y, long ylen, long k0, long n, int squaring)
+{
+    long xs, ys;
+
+    xs = FLINT_MAX(0, k0 - (ylen - 1));
+    ys = FLINT_MAX(0, k0 - (xlen - 1));
+
+    x += xs;
+    y += ys;
+    res += xs + ys;
+    n -= xs + ys;
+    xlen = FLINT_MIN(xlen - xs, n);
+    ylen = FLINT_MIN(ylen - ys, n);
+
+    /* splitting a square between threads turns it into
+       an ordinary product */
+    if (squaring && (flint_get_num_threads() == 1 || xlen < 2 * THREAD_MIN_LEN))
+        _fmpz_poly_sqrlow(res, x, xlen, n);
+    else
+        _fmpz_poly_mullow_threaded(res, x, xlen, y, ylen, n);
+}
+
+typedef struct
+{
+    mag_ptr t;
+    const double * xdbl;
+    const double * ydbl;
+    const fmpz * zexp;
+    long xl;
+    long yl;
+    long k0;
+    long k1;
+}
+dbl_conv_arg_t;
+
+static void
+_mag_vec_dbl_conv_worker(void * args, long j)
+{
+    dbl_conv_arg_t * arg = ((dbl_conv_arg_t *) args) + j;
+    const double * xdbl = arg->xdbl;
+    const double * ydbl = arg->ydbl;
+    long k, ii, xl = arg->xl, yl = arg->yl;
+
+    for (k = arg->k0; k < arg->k1; k++)
+    {
+        /* Classical multiplication (may round down!) */
+        double ss = 0.0;
+
+        for (ii = FLINT_MAX(0, k - yl + 1);
+            ii <= FLINT_MIN(xl - 1, k); ii++)
+        {
+            ss += xdbl[ii] * ydbl[k - ii];
+        }
+
+        /* Compensate for rounding error */
+        ss *= DOUBLE_ROUNDING_FACTOR;
+
+        mag_set_d_2exp_fmpz(arg->t + k, ss, arg->zexp);
+    }
+}
+
+/* t[k] = bound for the coefficient of x^k in the product, times 2^zexp,
+   for k0 <= k < bn */
+static void
+_mag_vec_dbl_conv(mag_ptr t, const double * xdbl, long xl,
+    const double * ydbl, long yl, long k0, long bn, const fmpz_t zexp)
+{
+    dbl_conv_arg_t * args;
+    long i, num_threads, num_ranges;
+
+    num_threads = flint_get_num_threads();
+
+    /* the work per output coefficient is not uniform,
+       so use more ranges than threads */
+    if (num_threads > 1 && bn - k0 >= THREAD_MIN_VEC_LEN &&
+        (double) xl * yl >= THREAD_MIN_DOUBLE_WORK)
+        num_ranges = 4 * num_threads;
+    else
+        num_ranges = 1;
+
+    args = flint_malloc(sizeof(dbl_conv_arg_t) * num_ranges);
+
+    for (i = 0; i < num_ranges; i++)
+    {
+        args[i].t = t;
+        args[i].xdbl = xdbl;
+        args[i].ydbl = ydbl;
+        args[i].zexp = zexp;
+        args[i].xl = xl;
+        args[i].yl = yl;
+        args[i].k0 = k0 + ((bn - k0) * i) / num_ranges;
+        args[i].k1 = k0 + ((bn - k0) * (i + 1)) / num_ranges;
+    }
+
+    if (num_ranges == 1)
+        _mag_vec_dbl_conv_worker(args, 0);
+    else
+        arb_thread_pool_parallel_do(_mag_vec_dbl_conv_worker, args,
+            num_ranges, num_threads);
+
+    flint_free(args);
+}
+
+typedef struct
+{
+    arb_ptr z;
+    const fmpz * zz;
+    const fmpz * zexp;
+    long k0;
+    long k1;
+    long prec;
+}
+add_fmpz_2exp_arg_t;
+
+static void
+_arb_vec_add_fmpz_2exp_worker(void * args, long j)
+{
+    add_fmpz_2exp_arg_t * arg = ((add_fmpz_2exp_arg_t *) args) + j;
+    long k;
+
+    for (k = arg->k0; k < arg->k1; k++)
+        arb_add_fmpz_2exp(arg->z + k, arg->z + k, arg->zz + k,
+            arg->zexp, arg->prec);
+}
+
+/* z[k] += zz[k] * 2^zexp */
+static void
+_arb_vec_add_fmpz_vec_2exp(arb_ptr z, const fmpz * zz, long bn,
+    const fmpz_t zexp, long prec)
+{
+    add_fmpz_2exp_arg_t * args;
+    long i, num_threads;
+
+    num_threads = flint_get_num_threads();
+    num_threads = FLINT_MIN(num_threads, bn / THREAD_MIN_VEC_LEN);
+    num_threads = FLINT_MAX(num_threads, 1);
+
+    args = flint_malloc(sizeof(add_fmpz_2exp_arg_t) * num_threads);
+
+    for (i = 0; i < num_threads; i++)
+    {
+        args[i].z = z;
+        args[i].zz = zz;
+        args[i].zexp = zexp;
+        args[i].k0 = (bn * i) / num_threads;
+        args[i].k1 = (bn * (i + 1)) / num_threads;
+        args[i].prec = prec;
+    }
+
+    if (num_threads == 1)
+        _arb_vec_add_fmpz_2exp_worker(args, 0);
+    else
+        arb_thread_pool_parallel_do(_arb_vec_add_fmpz_2exp_worker, args,
+            num_threads, num_threads);
+
+    flint_free(args);
+}
+
 static __inline__ void
 _mag_vec_get_fmpz_2exp_blocks(fmpz * coeffs,
     double * dblcoeffs, fmpz * exps, long * blocks, const fmpz_t scale,
@@ -227,14 +598,41 @@ _mag_vec_get_fmpz_2exp_blocks(fmpz * coeffs,
     fmpz_clear(block_bot);
 }
 
-static __inline__ void
+/*
+    Break the midpoints into same-exponent blocks using a simple cost model.
+    Storing a block of length l and height h (in bits) as integers costs
+    l * h bits, of which some are wasted on zero padding compared to
+    storing each coefficient with its own number of bits. The block is
+    multiplied by the other operand, of length m, using Kronecker
+    substitution, where every coefficient of both operands is padded to
+    the height of the product; a wasted bit in the block therefore costs
+    about (l + m) / l bits in the multiplication. Each block of x also
+    costs a pass over all of y (a multiplication involving all the bits
+    of y, and additions into the output), which is given as the penalty.
+    We extend the current block as long as its weighted waste does not
+    exceed the penalty, and its height does not exceed ALPHA*prec + BETA
+    (which bounds the cost of a single outlying exponent). With a slowly
+    drifting exponent, this gives blocks of roughly the optimal length.
+
+    Returns the total number of bits in the blocks and sets num_blocks.
+    If coeffs is NULL, only computes the partition without writing
+    anything else (this is used to compare scaling factors).
+*/
+static double
 _arb_vec_get_fmpz_2exp_blocks(fmpz * coeffs, fmpz * exps,
-    long * blocks, const fmpz_t scale, arb_srcptr x, long len, long prec)
+    long * blocks, long * num_blocks, const fmpz_t scale,
+    arb_srcptr x, long len, long other_len, double penalty, long prec)
 {
     fmpz_t top, bot, t, b, v, block_top, block_bot;
-    long i, j, s, block, bits, maxheight;
+    long i, j, s, l, block, start, bits;
+    double own, total, h, maxheight;
     int in_zero;
 
+    if (prec == ARF_PREC_EXACT)
+        maxheight = HUGE_VAL;
+    else
+        maxheight = ALPHA * prec + BETA;
+
     fmpz_init(top);
     fmpz_init(bot);
     fmpz_init(t);
@@ -243,15 +641,15 @@ _arb_vec_get_fmpz_2exp_blocks(fmpz * coeffs, fmpz * exps,
     fmpz_init(block_top);
     fmpz_init(block_bot);
 
-    blocks[0] = 0;
+    if (coeffs != NULL)
+        blocks[0] = 0;
+
     block = 0;
+    start = 0;
+    own = 0.0;
+    total = 0.0;
     in_zero = 1;
 
-    if (prec == ARF_PREC_EXACT)
-        maxheight = ARF_PREC_EXACT;
-    else
-        maxheight = ALPHA * prec + BETA;
-
     for (i = 0; i < len; i++)
     {
         bits = arf_bits(arb_midref(x + i));
@@ -270,6 +668,7 @@ _arb_vec_get_fmpz_2exp_blocks(fmpz * coeffs, fmpz * exps,
         {
             fmpz_swap(block_top, top);
             fmpz_swap(block_bot, bot);
+            own = bits;
         }
         else
         {
@@ -277,53 +676,74 @@ _arb_vec_get_fmpz_2exp_blocks(fmpz * coeffs, fmpz * exps,
             fmpz_min(b, bot, block_bot);
             fmpz_sub(v, t, b);
 
+            l = i - start + 1;
+            h = fmpz_get_d(v);
+
             /* extend current block */
-            if (fmpz_cmp_ui(v, maxheight) < 0)
+            if (h <= maxheight &&
+                (l * h - (own + bits)) * ((double) (l + other_len) / l)
+                    <= penalty)
             {
                 fmpz_swap(block_top, t);
                 fmpz_swap(block_bot, b);
+                own += bits;
             }
             else  /* start new block */
             {
+                fmpz_sub(v, block_top, block_bot);
+                total += (i - start) * fmpz_get_d(v);
+
                 /* write exponent for previous block */
-                fmpz_set(exps + block, block_bot);
+                if (coeffs != NULL)
+                    fmpz_set(exps + block, block_bot);
 
                 block++;
-                blocks[block] = i;
+                start = i;
+
+                if (coeffs != NULL)
+                    blocks[block] = i;
 
                 fmpz_swap(block_top, top);
                 fmpz_swap(block_bot, bot);
+                own = bits;
             }
         }
 
         in_zero = 0;
     }
 
-    /* write exponent for last block */
-    fmpz_set(exps + block, block_bot);
+    fmpz_sub(v, block_top, block_bot);
+    total += (len - start) * fmpz_get_d(v);
+    *num_blocks = block + 1;
 
-    /* end marker */
-    blocks[block + 1] = len;
-
-    /* write the block data */
-    for (i = 0; blocks[i] != len; i++)
+    if (coeffs != NULL)
     {
-        for (j = blocks[i]; j < blocks[i + 1]; j++)
+        /* write exponent for last block */
+        fmpz_set(exps + block, block_bot);
+
+        /* end marker */
+        blocks[block + 1] = len;
+
+        /* write the block data */
+        for (i = 0; blocks[i] != len; i++)
         {
-            if (arf_is_special(arb_midref(x + j)))
+            for (j = blocks[i]; j < blocks[i + 1]; j++)
             {
-                fmpz_zero(coeffs + j);
-            }
-            else
-            {
-                /* TODO: make this a single operation */
-                arf_get_fmpz_2exp(coeffs + j, bot, arb_midref(x + j));
-
-                fmpz_mul_ui(t, scale, j);
-                fmpz_sub(t, bot, t);
-                s = _fmpz_sub_small(t, exps + i);
-                if (s < 0) abort(); /* Bug catcher */
-                fmpz_mul_2exp(coeffs + j, coeffs + j, s);
+                if (arf_is_special(arb_midref(x + j)))
+                {
+                    fmpz_zero(coeffs + j);
+                }
+                else
+                {
+                    /* TODO: make this a single operation */
+                    arf_get_fmpz_2exp(coeffs + j, bot, arb_midref(x + j));
+
+                    fmpz_mul_ui(t, scale, j);
+                    fmpz_sub(t, bot, t);
+                    s = _fmpz_sub_small(t, exps + i);
+                    if (s < 0) abort(); /* Bug catcher */
+                    fmpz_mul_2exp(coeffs + j, coeffs + j, s);
+                }
             }
         }
     }
@@ -335,21 +755,146 @@ _arb_vec_get_fmpz_2exp_blocks(fmpz * coeffs, fmpz * exps,
     fmpz_clear(v);
     fmpz_clear(block_top);
     fmpz_clear(block_bot);
+
+    return total;
+}
+
+/* Number of bits in the midpoints, ignoring exponents. */
+static double
+_arb_vec_mid_bits(arb_srcptr x, long len)
+{
+    double s = 0.0;
+    long i;
+
+    for (i = 0; i < len; i++)
+        s += arf_bits(arb_midref(x + i));
+
+    return s;
+}
+
+/* Adds the centered sums of (i - mean i)^2 and (i - mean i)(e_i - mean e)
+   over the nonzero midpoints with exponents e_i. */
+static void
+_arb_vec_exp_slope_sums(double * sxx, double * sxy, arb_srcptr x, long len)
+{
+    double mi, me, d, e0;
+    long i, m;
+
+    mi = me = e0 = 0.0;
+    m = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        if (!arf_is_special(arb_midref(x + i)))
+        {
+            d = fmpz_get_d(ARF_EXPREF(arb_midref(x + i)));
+
+            if (m == 0)
+                e0 = d;
+
+            mi += i;
+            me += d - e0;
+            m++;
+        }
+    }
+
+    if (m < 2)
+        return;
+
+    mi /= m;
+    me /= m;
+
+    for (i = 0; i < len; i++)
+    {
+        if (!arf_is_special(arb_midref(x + i)))
+        {
+            d = fmpz_get_d(ARF_EXPREF(arb_midref(x + i))) - e0;
+            *sxx += (i - mi) * (i - mi);
+            *sxy += (i - mi) * (d - me);
+        }
+    }
 }
 
+/* Chooses the scaling factor with the lowest estimated cost among
+   the one given by _arb_poly_get_scale (which only looks at the
+   endpoints) and a least-squares fit of all the exponents, which is
+   better when the exponents are not close to linear. */
+static void
+_arb_poly_get_scale_cost(fmpz_t scale, arb_srcptr x, long xlen,
+    arb_srcptr y, long ylen, double xpenalty, double ypenalty,
+    double addcost, int squaring, long prec)
+{
+    fmpz_t alt;
+    double sxx, sxy, xbits, ybits, cost, altcost;
+    long xnum, ynum;
+
+    _arb_poly_get_scale(scale, x, xlen, y, ylen);
+
+    sxx = sxy = 0.0;
+    _arb_vec_exp_slope_sums(&sxx, &sxy, x, xlen);
+    if (!squaring)
+        _arb_vec_exp_slope_sums(&sxx, &sxy, y, ylen);
+
+    if (sxx == 0.0)
+        return;
+
+    fmpz_init(alt);
+    fmpz_set_d(alt, floor(sxy / sxx + 0.5));
+
+    if (!fmpz_equal(alt, scale))
+    {
+        xbits = _arb_vec_get_fmpz_2exp_blocks(NULL, NULL, NULL, &xnum,
+            scale, x, xlen, ylen, xpenalty, prec);
+        if (squaring)
+        {
+            ybits = xbits;
+            ynum = xnum;
+        }
+        else
+        {
+            ybits = _arb_vec_get_fmpz_2exp_blocks(NULL, NULL, NULL, &ynum,
+                scale, y, ylen, xlen, ypenalty, prec);
+        }
+
+        cost = ynum * xbits + xnum * ybits + addcost * (ynum * xlen + xnum * ylen);
+
+        xbits = _arb_vec_get_fmpz_2exp_blocks(NULL, NULL, NULL, &xnum,
+            alt, x, xlen, ylen, xpenalty, prec);
+        if (squaring)
+        {
+            ybits = xbits;
+            ynum = xnum;
+        }
+        else
+        {
+            ybits = _arb_vec_get_fmpz_2exp_blocks(NULL, NULL, NULL, &ynum,
+                alt, y, ylen, xlen, ypenalty, prec);
+        }
+
+        altcost = ynum * xbits + xnum * ybits + addcost * (ynum * xlen + xnum * ylen);
+
+        if (altcost < cost)
+            fmpz_swap(scale, alt);
+    }
+
+    fmpz_clear(alt);
+}
+
+/* Adds error bounds for the coefficients lo <= k < n of the product to
+   {z, n - lo}. */
 static __inline__ void
 _arb_poly_addmullow_rad(arb_ptr z, fmpz * zz,
     const fmpz * xz, const double * xdbl, const fmpz * xexps,
     const long * xblocks, long xlen,
     const fmpz * yz, const double * ydbl, const fmpz * yexps,
-    const long * yblocks, long ylen, long n)
+    const long * yblocks, long ylen, long lo, long n)
 {
-    long i, j, k, ii, xp, yp, xl, yl, bn;
+    long i, j, k, k0, xp, yp, xl, yl, bn;
     fmpz_t zexp;
-    mag_t t;
+    mag_ptr t;
 
     fmpz_init(zexp);
-    mag_init(t);
+    t = _mag_vec_init(n);
 
     for (i = 0; (xp = xblocks[i]) != xlen; i++)
     {
@@ -364,6 +909,12 @@ _arb_poly_addmullow_rad(arb_ptr z, fmpz * zz,
             xl = FLINT_MIN(xl, bn);
             yl = FLINT_MIN(yl, bn);
 
+            /* entirely below the wanted coefficients */
+            if (xp + yp + bn <= lo)
+                continue;
+
+            k0 = FLINT_MAX(0, lo - xp - yp);
+
             fmpz_add_inline(zexp, xexps + i, yexps + j);
 
             if (xl > 1 && yl > 1 &&
@@ -371,53 +922,32 @@ _arb_poly_addmullow_rad(arb_ptr z, fmpz * zz,
             {
                 fmpz_add_ui(zexp, zexp, 2 * DOUBLE_BLOCK_SHIFT);
 
-                for (k = 0; k < bn; k++)
-                {
-                    /* Classical multiplication (may round down!) */
-                    double ss = 0.0;
-
-                    for (ii = FLINT_MAX(0, k - yl + 1);
-                        ii <= FLINT_MIN(xl - 1, k); ii++)
-                    {
-                        ss += xdbl[xp + ii] * ydbl[yp + k - ii];
-                    }
-
-                    /* Compensate for rounding error */
-                    ss *= DOUBLE_ROUNDING_FACTOR;
-
-                    mag_set_d_2exp_fmpz(t, ss, zexp);
-                    mag_add(arb_radref(z + xp + yp + k),
-                            arb_radref(z + xp + yp + k), t);
-                }
+                _mag_vec_dbl_conv(t, xdbl + xp, xl, ydbl + yp, yl, k0, bn, zexp);
             }
             else
             {
-                if (xl >= yl)
-                    _fmpz_poly_mullow(zz, xz + xp, xl, yz + yp, yl, bn);
-                else
-                    _fmpz_poly_mullow(zz, yz + yp, yl, xz + xp, xl, bn);
+                _fmpz_poly_mullow_trim(zz, xz + xp, xl, yz + yp, yl, k0, bn, 0);
 
-                for (k = 0; k < bn; k++)
-                {
-                    mag_set_fmpz_2exp_fmpz(t, zz + k, zexp);
-                    mag_add(arb_radref(z + xp + yp + k),
-                            arb_radref(z + xp + yp + k), t);
-                }
+                for (k = k0; k < bn; k++)
+                    mag_set_fmpz_2exp_fmpz(t + k, zz + k, zexp);
             }
+
+            _arb_vec_add_error_mag_vec(z + xp + yp + k0 - lo, t + k0, bn - k0);
         }
     }
 
     fmpz_clear(zexp);
-    mag_clear(t);
+    _mag_vec_clear(t, n);
 }
 
+/* Adds the coefficients lo <= k < n of the product to {z, n - lo}. */
 static __inline__ void
 _arb_poly_addmullow_block(arb_ptr z, fmpz * zz,
     const fmpz * xz, const fmpz * xexps, const long * xblocks, long xlen,
     const fmpz * yz, const fmpz * yexps, const long * yblocks, long ylen,
-    long n, long prec, int squaring)
+    long lo, long n, long prec, int squaring)
 {
-    long i, j, k, xp, yp, xl, yl, bn;
+    long i, j, k0, xp, yp, xl, yl, bn;
     fmpz_t zexp;
 
     fmpz_init(zexp);
@@ -433,11 +963,15 @@ _arb_poly_addmullow_block(arb_ptr z, fmpz * zz,
             bn = FLINT_MIN(2 * xl - 1, n - 2 * xp);
             xl = FLINT_MIN(xl, bn);
 
-            _fmpz_poly_sqrlow(zz, xz + xp, xl, bn);
-            _fmpz_add2_fast(zexp, xexps + i, xexps + i, 0);
+            if (2 * xp + bn <= lo)
+                continue;
+
+            k0 = FLINT_MAX(0, lo - 2 * xp);
 
-            for (k = 0; k < bn; k++)
-                arb_add_fmpz_2exp(z + 2 * xp + k, z + 2 * xp + k, zz + k, zexp, prec);
+            _fmpz_poly_mullow_trim(zz, xz + xp, xl, xz + xp, xl, k0, bn, 1);
+            _fmpz_add2_fast(zexp, xexps + i, xexps + i, 0);
+            _arb_vec_add_fmpz_vec_2exp(z + 2 * xp + k0 - lo, zz + k0,
+                bn - k0, zexp, prec);
         }
     }
 
@@ -454,15 +988,15 @@ _arb_poly_addmullow_block(arb_ptr z, fmpz * zz,
             xl = FLINT_MIN(xl, bn);
             yl = FLINT_MIN(yl, bn);
 
-            if (xl >= yl)
-                _fmpz_poly_mullow(zz, xz + xp, xl, yz + yp, yl, bn);
-            else
-                _fmpz_poly_mullow(zz, yz + yp, yl, xz + xp, xl, bn);
+            if (xp + yp + bn <= lo)
+                continue;
 
-           _fmpz_add2_fast(zexp, xexps + i, yexps + j, squaring);
+            k0 = FLINT_MAX(0, lo - xp - yp);
 
-            for (k = 0; k < bn; k++)
-                arb_add_fmpz_2exp(z + xp + yp + k, z + xp + yp + k, zz + k, zexp, prec);
+            _fmpz_poly_mullow_trim(zz, xz + xp, xl, yz + yp, yl, k0, bn, 0);
+            _fmpz_add2_fast(zexp, xexps + i, yexps + j, squaring);
+            _arb_vec_add_fmpz_vec_2exp(z + xp + yp + k0 - lo, zz + k0,
+                bn - k0, zexp, prec);
         }
     }
 
@@ -470,10 +1004,83 @@ _arb_poly_addmullow_block(arb_ptr z, fmpz * zz,
 }
 
 void
-_arb_poly_mullow_block(arb_ptr z, arb_srcptr x, long xlen,
-                                arb_srcptr y, long ylen, long n, long prec)
+_arb_poly_mullow_block_rad(arb_ptr z, mag_srcptr x, long xlen,
+    mag_srcptr y, long ylen, long lo, long n, const fmpz_t scale)
+{
+    fmpz *xz, *yz, *zz, *xe, *ye;
+    double *xdbl, *ydbl;
+    long *xblocks, *yblocks;
+
+    while (xlen > 0 && mag_is_zero(x + xlen - 1)) xlen--;
+    while (ylen > 0 && mag_is_zero(y + ylen - 1)) ylen--;
+
+    xlen = FLINT_MIN(xlen, n);
+    ylen = FLINT_MIN(ylen, n);
+
+    if (xlen == 0 || ylen == 0)
+        return;
+
+    n = FLINT_MIN(n, xlen + ylen - 1);
+
+    if (n <= lo)
+        return;
+
+    xz = _fmpz_vec_init(xlen);
+    yz = _fmpz_vec_init(ylen);
+    zz = _fmpz_vec_init(n);
+    xe = _fmpz_vec_init(xlen);
+    ye = _fmpz_vec_init(ylen);
+    xdbl = flint_malloc(sizeof(double) * xlen);
+    ydbl = flint_malloc(sizeof(double) * ylen);
+    xblocks = flint_malloc(sizeof(long) * (xlen + 1));
+    yblocks = flint_malloc(sizeof(long) * (ylen + 1));
+
+    _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, NULL, x, xlen);
+    _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, y, ylen);
+    _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xlen,
+        yz, ydbl, ye, yblocks, ylen, lo, n);
+
+    _fmpz_vec_clear(xz, xlen);
+    _fmpz_vec_clear(yz, ylen);
+    _fmpz_vec_clear(zz, n);
+    _fmpz_vec_clear(xe, xlen);
+    _fmpz_vec_clear(ye, ylen);
+    flint_free(xdbl);
+    flint_free(ydbl);
+    flint_free(xblocks);
+    flint_free(yblocks);
+}
+
+/* res[i] = 2^e |mid(x[i])| + rad(x[i]) */
+static void
+_arb_vec_get_mag_mid_rad(mag_ptr res, arb_srcptr x, long len, long e)
 {
-    long xmlen, xrlen, ymlen, yrlen, i;
+    mag_ptr r;
+    long i;
+    TMP_INIT;
+
+    TMP_START;
+    r = TMP_ALLOC(sizeof(mag_struct) * len);
+
+    for (i = 0; i < len; i++)
+    {
+        arf_get_mag(res + i, arb_midref(x + i));
+        mag_mul_2exp_si(res + i, res + i, e);
+        r[i] = *arb_radref(x + i);
+    }
+
+    _mag_vec_add(res, res, r, len);
+    TMP_END;
+}
+
+/* Sets {z, n - lo} to the coefficients lo <= k < n of the product. */
+static void
+_arb_poly_mulmid_block_params(arb_ptr z, arb_srcptr x, long xlen,
+    arb_srcptr y, long ylen, long lo, long n, long prec,
+    double alpha, double beta)
+{
+    long xmlen, xrlen, ymlen, yrlen, xnum, ynum, i;
+    double addcost, xbits, ybits, xpenalty, ypenalty;
     fmpz *xz, *yz, *zz;
     fmpz *xe, *ye;
     long *xblocks, *yblocks;
@@ -506,7 +1113,7 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, long xlen,
     if (!_arb_vec_is_finite(x, xlen) ||
         (!squaring && !_arb_vec_is_finite(y, ylen)))
     {
-        _arb_poly_mullow_classical(z, x, xlen, y, ylen, n, prec);
+        _arb_poly_mulmid_classical(z, x, xlen, y, ylen, lo, n, prec);
         return;
     }
 
@@ -514,10 +1121,10 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, long xlen,
     ylen = FLINT_MAX(ymlen, yrlen);
 
     /* Start with the zero polynomial */
-    _arb_vec_zero(z, n);
+    _arb_vec_zero(z, n - lo);
 
     /* Nothing to do */
-    if (xlen == 0 || ylen == 0)
+    if (xlen == 0 || ylen == 0 || xlen + ylen - 1 <= lo)
         return;
 
     n = FLINT_MIN(n, xlen + ylen - 1);
@@ -532,7 +1139,18 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, long xlen,
     xblocks = flint_malloc(sizeof(long) * (xlen + 1));
     yblocks = flint_malloc(sizeof(long) * (ylen + 1));
 
-    _arb_poly_get_scale(scale, x, xlen, y, ylen);
+    /* Cost model for the midpoint blocks (see above). Each block
+       of x costs a multiplication involving all the bits of y plus
+       additions into the output, estimated as addcost bits per
+       coefficient of y, and vice versa. */
+    addcost = alpha * ((prec == ARF_PREC_EXACT ? 0 : prec) + beta);
+    xbits = _arb_vec_mid_bits(x, xmlen);
+    ybits = squaring ? xbits : _arb_vec_mid_bits(y, ymlen);
+    xpenalty = ybits + addcost * ymlen;
+    ypenalty = xbits + addcost * xmlen;
+
+    _arb_poly_get_scale_cost(scale, x, xmlen, y, ymlen,
+        xpenalty, ypenalty, addcost, squaring, prec);
 
     /* Error propagation */
     /* (xm + xr)*(ym + yr) = (xm*ym) + (xr*ym + xm*yr + xr*yr)
@@ -552,15 +1170,10 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, long xlen,
         {
             _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
 
-            for (i = 0; i < xlen; i++)
-            {
-                arf_get_mag(tmp + i, arb_midref(x + i));
-                mag_mul_2exp_si(tmp + i, tmp + i, 1);
-                mag_add(tmp + i, tmp + i, arb_radref(x + i));
-            }
+            _arb_vec_get_mag_mid_rad(tmp, x, xlen, 1);
 
             _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, xlen);
-            _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, xlen, n);
+            _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, xlen, lo, n);
         }
         else if (yrlen == 0)
         {
@@ -571,7 +1184,7 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, long xlen,
                 arf_get_mag(tmp + i, arb_midref(y + i));
 
             _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, ymlen);
-            _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, ymlen, n);
+            _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, ymlen, lo, n);
         }
         else
         {
@@ -581,18 +1194,17 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, long xlen,
 
             _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, NULL, tmp, xmlen);
             _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, y, NULL, yrlen);
-            _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xmlen, yz, ydbl, ye, yblocks, yrlen, n);
+            _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xmlen, yz, ydbl, ye, yblocks, yrlen, lo, n);
 
             /* xr*(|ym| + yr) */
             if (xrlen != 0)
             {
                 _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
 
-                for (i = 0; i < ylen; i++)
-                    arb_get_mag(tmp + i, y + i);
+                _arb_vec_get_mag_mid_rad(tmp, y, ylen, 0);
 
                 _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, ylen);
-                _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, ylen, n);
+                _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, ylen, lo, n);
             }
         }
 
@@ -604,26 +1216,28 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, long xlen,
     /* multiply midpoints */
     if (xmlen != 0 && ymlen != 0)
     {
-        _arb_vec_get_fmpz_2exp_blocks(xz, xe, xblocks, scale, x, xmlen, prec);
+        _arb_vec_get_fmpz_2exp_blocks(xz, xe, xblocks, &xnum,
+            scale, x, xmlen, ymlen, xpenalty, prec);
 
         if (squaring)
         {
-            _arb_poly_addmullow_block(z, zz, xz, xe, xblocks, xmlen, xz, xe, xblocks, xmlen, n, prec, 1);
+            _arb_poly_addmullow_block(z, zz, xz, xe, xblocks, xmlen, xz, xe, xblocks, xmlen, lo, n, prec, 1);
         }
         else
         {
-            _arb_vec_get_fmpz_2exp_blocks(yz, ye, yblocks, scale, y, ymlen, prec);
-            _arb_poly_addmullow_block(z, zz, xz, xe, xblocks, xmlen, yz, ye, yblocks, ymlen, n, prec, 0);
+            _arb_vec_get_fmpz_2exp_blocks(yz, ye, yblocks, &ynum,
+                scale, y, ymlen, xmlen, ypenalty, prec);
+            _arb_poly_addmullow_block(z, zz, xz, xe, xblocks, xmlen, yz, ye, yblocks, ymlen, lo, n, prec, 0);
         }
     }
 
     /* Unscale. */
     if (!fmpz_is_zero(scale))
     {
-        fmpz_zero(t);
-        for (i = 0; i < n; i++)
+        fmpz_mul_ui(t, scale, lo);
+        for (i = lo; i < n; i++)
         {
-            arb_mul_2exp_fmpz(z + i, z + i, t);
+            arb_mul_2exp_fmpz(z + i - lo, z + i - lo, t);
             fmpz_add(t, t, scale);
         }
     }
@@ -639,6 +1253,30 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, long xlen,
     fmpz_clear(t);
 }
 
+void
+_arb_poly_mullow_block_params(arb_ptr z, arb_srcptr x, long xlen,
+    arb_srcptr y, long ylen, long n, long prec, double alpha, double beta)
+{
+    _arb_poly_mulmid_block_params(z, x, xlen, y, ylen, 0, n, prec,
+        alpha, beta);
+}
+
+void
+_arb_poly_mullow_block(arb_ptr z, arb_srcptr x, long xlen,
+                                arb_srcptr y, long ylen, long n, long prec)
+{
+    _arb_poly_mulmid_block_params(z, x, xlen, y, ylen, 0, n, prec,
+        ARB_POLY_MULLOW_BLOCK_ALPHA, ARB_POLY_MULLOW_BLOCK_BETA);
+}
+
+void
+_arb_poly_mulmid_block(arb_ptr z, arb_srcptr x, long xlen,
+    arb_srcptr y, long ylen, long lo, long hi, long prec)
+{
+    _arb_poly_mulmid_block_params(z, x, xlen, y, ylen, lo, hi, prec,
+        ARB_POLY_MULLOW_BLOCK_ALPHA, ARB_POLY_MULLOW_BLOCK_BETA);
+}
+
 void
 arb_poly_mullow_block(arb_poly_t res, const arb_poly_t poly1,
               const arb_poly_t poly2, long n, long prec)
@@ -677,4 +1315,3 @@ arb_poly_mullow_block(arb_poly_t res, const arb_poly_t poly1,
     _arb_poly_set_length(res, zlen);
     _arb_poly_normalise(res);
 }
-
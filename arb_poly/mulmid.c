@@ -0,0 +1,83 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_poly.h"
+
+#define BLOCK_CUTOFF 16
+
+void
+_arb_poly_mulmid(arb_ptr res,
+    arb_srcptr poly1, long len1,
+    arb_srcptr poly2, long len2, long lo, long hi, long prec)
+{
+    len1 = FLINT_MIN(len1, hi);
+    len2 = FLINT_MIN(len2, hi);
+
+    if (hi - lo < BLOCK_CUTOFF || len1 < BLOCK_CUTOFF || len2 < BLOCK_CUTOFF)
+        _arb_poly_mulmid_classical(res, poly1, len1, poly2, len2, lo, hi, prec);
+    else
+        _arb_poly_mulmid_block(res, poly1, len1, poly2, len2, lo, hi, prec);
+}
+
+void
+arb_poly_mulmid(arb_poly_t res, const arb_poly_t poly1,
+    const arb_poly_t poly2, long lo, long hi, long prec)
+{
+    long len1, len2;
+
+    len1 = poly1->length;
+    len2 = poly2->length;
+
+    if (len1 == 0 || len2 == 0)
+        hi = 0;
+    else
+        hi = FLINT_MIN(hi, len1 + len2 - 1);
+
+    if (hi <= lo)
+    {
+        arb_poly_zero(res);
+        return;
+    }
+
+    if (res == poly1 || res == poly2)
+    {
+        arb_poly_t t;
+        arb_poly_init2(t, hi - lo);
+        _arb_poly_mulmid(t->coeffs, poly1->coeffs, len1,
+                                poly2->coeffs, len2, lo, hi, prec);
+        arb_poly_swap(res, t);
+        arb_poly_clear(t);
+    }
+    else
+    {
+        arb_poly_fit_length(res, hi - lo);
+        _arb_poly_mulmid(res->coeffs, poly1->coeffs, len1,
+                                poly2->coeffs, len2, lo, hi, prec);
+    }
+
+    _arb_poly_set_length(res, hi - lo);
+    _arb_poly_normalise(res);
+}
+
@@ -0,0 +1,65 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_poly.h"
+
+void
+_arb_poly_mulmid_classical(arb_ptr res,
+    arb_srcptr poly1, long len1,
+    arb_srcptr poly2, long len2, long lo, long hi, long prec)
+{
+    long i, start, stop;
+
+    len1 = FLINT_MIN(len1, hi);
+    len2 = FLINT_MIN(len2, hi);
+
+    if (poly1 == poly2 && len1 == len2)
+    {
+        for (i = lo; i < hi; i++)
+        {
+            start = FLINT_MAX(0, i - len1 + 1);
+            stop = FLINT_MIN(len1 - 1, (i + 1) / 2 - 1);
+
+            arb_dot(res + i - lo, NULL, 0, poly1 + start, 1,
+                poly1 + i - start, -1, stop - start + 1, prec);
+            arb_mul_2exp_si(res + i - lo, res + i - lo, 1);
+
+            if (i % 2 == 0 && i / 2 < len1)
+                arb_addmul(res + i - lo, poly1 + i / 2, poly1 + i / 2, prec);
+        }
+    }
+    else
+    {
+        for (i = lo; i < hi; i++)
+        {
+            start = FLINT_MAX(0, i - len2 + 1);
+            stop = FLINT_MIN(len1 - 1, i);
+
+            arb_dot(res + i - lo, NULL, 0, poly1 + start, 1,
+                poly2 + i - start, -1, stop - start + 1, prec);
+        }
+    }
+}
+
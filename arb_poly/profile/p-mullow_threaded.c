@@ -0,0 +1,112 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_poly.h"
+#include "profiler.h"
+
+/*
+    Prints a table of timings (in ms, for reps repetitions) of
+    arb_poly_mullow_block for long power series products with
+    1, 2, 4, ... threads, with the speedup over one thread. The
+    integer products are split into balanced blocks, so the speedup
+    should approach sqrt(2T) for T threads on long products.
+
+    The maximum number of threads can be given as an argument.
+*/
+
+int main(int argc, char * argv[])
+{
+    long n, prec, i, reps, threads, max_threads, t1;
+    arb_poly_t A, B, C;
+    flint_rand_t state;
+    timeit_t t0;
+
+    max_threads = (argc > 1) ? atol(argv[1]) : 8;
+    max_threads = FLINT_MAX(max_threads, 1);
+
+    flint_randinit(state);
+
+    printf("    prec        n   reps");
+    for (threads = 1; threads <= max_threads; threads *= 2)
+        printf("      T = %-3ld", threads);
+    printf("\n");
+
+    for (prec = 64; prec <= 4096; prec *= 4)
+    {
+        for (n = 1000; n <= 64000; n *= 4)
+        {
+            arb_poly_init(A);
+            arb_poly_init(B);
+            arb_poly_init(C);
+
+            arb_poly_one(A);
+            arb_poly_one(B);
+
+            /* exp(x) and 1/(1-x)-like series */
+            for (i = 1; i < n; i++)
+            {
+                arb_poly_fit_length(A, i + 1);
+                arb_poly_fit_length(B, i + 1);
+                arb_div_ui(A->coeffs + i, A->coeffs + i - 1, i, prec);
+                arb_set_ui(B->coeffs + i, 1 + n_randint(state, 1000));
+                arb_div_ui(B->coeffs + i, B->coeffs + i, 1000, prec);
+            }
+            _arb_poly_set_length(A, n);
+            _arb_poly_set_length(B, n);
+
+            reps = FLINT_MAX(1, 100000000 / (n * prec));
+            t1 = 0;
+
+            printf("%8ld %8ld %6ld", prec, n, reps);
+
+            for (threads = 1; threads <= max_threads; threads *= 2)
+            {
+                flint_set_num_threads(threads);
+
+                timeit_start(t0);
+                for (i = 0; i < reps; i++)
+                    arb_poly_mullow_block(C, A, B, n, prec);
+                timeit_stop(t0);
+
+                if (threads == 1)
+                    t1 = FLINT_MAX(t0->wall, 1);
+
+                printf("  %5ld (%.1fx)", (long) t0->wall,
+                    (double) t1 / FLINT_MAX(t0->wall, 1));
+            }
+
+            printf("\n");
+
+            arb_poly_clear(A);
+            arb_poly_clear(B);
+            arb_poly_clear(C);
+        }
+    }
+
+    flint_set_num_threads(1);
+    flint_randclear(state);
+    flint_cleanup();
+    return EXIT_SUCCESS;
+}
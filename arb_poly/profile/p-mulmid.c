@@ -0,0 +1,93 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_poly.h"
+#include "profiler.h"
+
+/*
+    Compares the middle product used in a Newton step (a series of
+    length 2m times a series of length m, keeping the coefficients
+    m <= k < 2m) with the truncated product of length 2m that it
+    replaces. Both use the same integer multiplications, so the
+    difference is the work skipped for the low coefficients.
+*/
+
+int main()
+{
+    long m, prec, i, reps;
+    arb_ptr A, B, C;
+    flint_rand_t state;
+    timeit_t t0, t1;
+
+    flint_randinit(state);
+
+    printf("    prec        m   reps   mullow (ms)   mulmid (ms)   ratio\n");
+
+    for (prec = 64; prec <= 4096; prec *= 4)
+    {
+        for (m = 16; m <= 16384; m *= 4)
+        {
+            A = _arb_vec_init(2 * m);
+            B = _arb_vec_init(m);
+            C = _arb_vec_init(2 * m);
+
+            arb_one(A);
+            arb_one(B);
+
+            for (i = 1; i < 2 * m; i++)
+                arb_div_ui(A + i, A + i - 1, i, prec);
+
+            for (i = 1; i < m; i++)
+            {
+                arb_set_ui(B + i, 1 + n_randint(state, 1000));
+                arb_div_ui(B + i, B + i, 1000, prec);
+            }
+
+            reps = FLINT_MAX(1, 10000000 / (m * prec));
+
+            timeit_start(t0);
+            for (i = 0; i < reps; i++)
+                _arb_poly_mullow(C, A, 2 * m, B, m, 2 * m, prec);
+            timeit_stop(t0);
+
+            timeit_start(t1);
+            for (i = 0; i < reps; i++)
+                _arb_poly_mulmid(C, A, 2 * m, B, m, m, 2 * m, prec);
+            timeit_stop(t1);
+
+            printf("%8ld %8ld %6ld %13ld %13ld %7.2f\n", prec, m, reps,
+                (long) t0->wall, (long) t1->wall,
+                (double) t1->wall / FLINT_MAX(t0->wall, 1));
+
+            _arb_vec_clear(A, 2 * m);
+            _arb_vec_clear(B, m);
+            _arb_vec_clear(C, 2 * m);
+        }
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    return EXIT_SUCCESS;
+}
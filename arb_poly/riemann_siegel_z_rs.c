@@ -0,0 +1,397 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <math.h>
+#include "arb_poly.h"
+#include "arb_thread_pool.h"
+
+/*
+    Riemann-Siegel formula for Z(t), t > 0. With a = sqrt(t/(2 pi)),
+    m = floor(a), p = a - m,
+
+        Z(t) = 2 sum_{n=1}^m n^(-1/2) cos(theta(t) - t log n)
+             + (-1)^(m-1) a^(-1/2) sum_{k=0}^K C_k(p) a^(-k) + R_K(t).
+
+    For t >= 200 and K <= 10, Gabcke (1979) proved |R_K(t)| <= g_K
+    t^(-(2K+3)/4). We use the corrections up to K = 4, whose expressions in
+    terms of derivatives of
+
+        Psi(p) = cos(2 pi (p^2 - p - 1/16)) / cos(2 pi p)
+
+    are given in Edwards, "Riemann's zeta function", section 7.
+*/
+
+/* g_K, rounded up, times 1000 */
+static const int rs_remainder_bound[] = { 127, 53, 11, 31, 17 };
+
+/* C_k = sum D_j * num / den / pi^(2e) where D_j = Psi^(j)(p) / j! */
+static const struct
+{
+    int k, j, e, num, den;
+}
+rs_coeffs[] = {
+    { 0, 0, 0, 1, 1 },
+    { 1, 3, 1, -1, 16 },
+    { 2, 6, 2, 5, 128 },
+    { 2, 2, 1, 1, 32 },
+    { 3, 9, 3, -35, 512 },
+    { 3, 5, 2, -1, 32 },
+    { 3, 1, 1, -1, 64 },
+    { 4, 12, 4, 1925, 8192 },
+    { 4, 8, 3, 77, 1024 },
+    { 4, 4, 2, 19, 1024 },
+    { 4, 0, 1, 1, 128 },
+};
+
+#define RS_NUM_COEFFS (sizeof(rs_coeffs) / sizeof(rs_coeffs[0]))
+
+long
+_arb_poly_riemann_siegel_rs_terms(const arb_t t, long prec)
+{
+    arf_t u;
+    double T, err;
+    long K;
+
+    if (!arb_is_finite(t))
+        return -1;
+
+    arf_init(u);
+    arb_get_abs_lbound_arf(u, t, 53);
+    T = arf_get_d(u, ARF_RND_DOWN);
+    arf_clear(u);
+
+    if (T < ARB_POLY_RIEMANN_SIEGEL_MIN_T || T > 1e18)
+        return -1;
+
+    for (K = 0; K <= ARB_POLY_RIEMANN_SIEGEL_MAX_K; K++)
+    {
+        err = log(rs_remainder_bound[K] * 0.001) * 1.4426950408889634
+            - 0.25 * (2 * K + 3) * log(T) * 1.4426950408889634;
+
+        if (err < -prec - 1)
+            return K;
+    }
+
+    return -1;
+}
+
+/*
+    Sets D[j] = Psi^(j)(1/2 + z) / j! for 0 <= j < jlen, |z| < 1.
+    With x = p - 1/2, Psi = -cos(pi (2 x^2 - 5/8)) / cos(2 pi x) is entire,
+    and |Psi| <= 2^38 on |x| = 2 (the numerator is bounded by
+    exp(8 pi) < 2^37 and the denominator is at least 1/2 there). By the
+    Cauchy estimates the Taylor coefficients satisfy |c_n| <= 2^38 2^(-n),
+    and with r = |z|/2 the tail of D_j is bounded by
+
+        2^38 2^(-j) binomial(N,j) r^(N-j) / (1-r)^(j+1).
+*/
+static void
+_arb_poly_riemann_siegel_psi_derivs(arb_ptr D, const arb_t z, long jlen, long prec)
+{
+    arb_ptr c, num, den;
+    arb_t x;
+    mag_t r, s, b;
+    long j, n, N;
+
+    N = (prec + 40 + jlen * (2 + FLINT_BIT_COUNT(prec))) / 2 + jlen + 1;
+
+    c = _arb_vec_init(N);
+    num = _arb_vec_init(N);
+    den = _arb_vec_init(N);
+    arb_init(x);
+    mag_init(r);
+    mag_init(s);
+    mag_init(b);
+
+    arb_set_si(x, -5);
+    arb_mul_2exp_si(x, x, -3);
+    arb_set(c + 0, x);
+    arb_set_ui(c + 2, 2);
+    _arb_poly_cos_pi_series(num, c, 3, N, prec);
+
+    arb_zero(c + 0);
+    arb_set_ui(c + 1, 2);
+    _arb_poly_cos_pi_series(den, c + 0, 2, N, prec);
+
+    _arb_poly_div_series(c, num, N, den, N, N, prec);
+    _arb_vec_neg(c, c, N);
+
+    arb_get_mag(r, z);
+    mag_mul_2exp_si(r, r, -1);
+
+    for (j = 0; j < jlen; j++)
+    {
+        if (j != 0)
+        {
+            _arb_poly_derivative(c, c, N - j + 1, prec);
+            for (n = 0; n < N - j; n++)
+                arb_div_ui(c + n, c + n, j, prec);
+        }
+
+        _arb_poly_evaluate(D + j, c, N - j, z, prec);
+
+        if (mag_cmp_2exp_si(r, -1) >= 0)
+        {
+            mag_inf(b);
+        }
+        else
+        {
+            mag_pow_ui(b, r, N - j);
+            mag_set_ui(s, N);
+            mag_pow_ui(s, s, j);
+            mag_mul(b, b, s);
+            mag_one(s);
+            mag_sub_lower(s, s, r);
+            mag_pow_ui_lower(s, s, j + 1);
+            mag_div(b, b, s);
+            mag_mul_2exp_si(b, b, 38 - j);
+        }
+
+        arb_add_error_mag(D + j, b);
+    }
+
+    _arb_vec_clear(c, N);
+    _arb_vec_clear(num, N);
+    _arb_vec_clear(den, N);
+    arb_clear(x);
+    mag_clear(r);
+    mag_clear(s);
+    mag_clear(b);
+}
+
+typedef struct
+{
+    arb_struct sum;
+    arb_srcptr theta;
+    arb_srcptr t;
+    ulong n0;
+    ulong n1;
+    long prec;
+}
+rs_sum_arg_t;
+
+static void
+_arb_poly_riemann_siegel_sum_worker(void * args, long i)
+{
+    rs_sum_arg_t * arg = ((rs_sum_arg_t *) args) + i;
+    arb_t logn, u, v;
+    ulong n, prev;
+
+    arb_init(logn);
+    arb_init(u);
+    arb_init(v);
+
+    prev = 0;
+
+    for (n = arg->n0; n < arg->n1; n++)
+    {
+        arb_log_ui_from_prev(logn, n, logn, prev, arg->prec);
+        prev = n;
+
+        /* cos(theta - t log n) / sqrt(n) */
+        arb_mul(u, arg->t, logn, arg->prec);
+        arb_sub(u, arg->theta, u, arg->prec);
+        arb_cos(u, u, arg->prec);
+        arb_rsqrt_ui(v, n, arg->prec);
+        arb_addmul(&arg->sum, u, v, arg->prec);
+    }
+
+    arb_clear(logn);
+    arb_clear(u);
+    arb_clear(v);
+}
+
+/* sets res = sum_{n=1}^m n^(-1/2) cos(theta - t log n) */
+static void
+_arb_poly_riemann_siegel_sum(arb_t res, const arb_t theta, const arb_t t,
+    ulong m, long prec)
+{
+    rs_sum_arg_t * args;
+    long i, num_threads;
+
+    num_threads = flint_get_num_threads();
+
+    if (m < 256 || num_threads <= 1)
+        num_threads = 1;
+    else
+        num_threads = FLINT_MIN(num_threads, m / 64);
+
+    args = flint_malloc(sizeof(rs_sum_arg_t) * num_threads);
+
+    for (i = 0; i < num_threads; i++)
+    {
+        arb_init(&args[i].sum);
+        args[i].theta = theta;
+        args[i].t = t;
+        args[i].n0 = 1 + (m * i) / num_threads;
+        args[i].n1 = 1 + (m * (i + 1)) / num_threads;
+        args[i].prec = prec;
+    }
+
+    if (num_threads == 1)
+        _arb_poly_riemann_siegel_sum_worker(args, 0);
+    else
+        arb_thread_pool_parallel_do(_arb_poly_riemann_siegel_sum_worker,
+            args, num_threads, num_threads);
+
+    arb_zero(res);
+    for (i = 0; i < num_threads; i++)
+    {
+        arb_add(res, res, &args[i].sum, prec);
+        arb_clear(&args[i].sum);
+    }
+
+    flint_free(args);
+}
+
+int
+_arb_poly_riemann_siegel_z_rs(arb_t res, const arb_t t, long K, long prec)
+{
+    arb_t T, a, p, theta, S, C, u, v;
+    arb_ptr D;
+    fmpz_t mz;
+    mag_t err;
+    ulong m;
+    long i, k, wp, tbits;
+    int success;
+
+    if (K < 0 || K > ARB_POLY_RIEMANN_SIEGEL_MAX_K || !arb_is_finite(t))
+        return 0;
+
+    arb_init(T);
+    arb_init(a);
+    arb_init(p);
+    arb_init(theta);
+    arb_init(S);
+    arb_init(C);
+    arb_init(u);
+    arb_init(v);
+    fmpz_init(mz);
+    mag_init(err);
+    D = _arb_vec_init(3 * K + 1);
+
+    success = 0;
+
+    /* Z is even */
+    arb_abs(T, t);
+
+    /* the remainder bounds are only valid for t >= 200 */
+    arb_set_ui(u, 200);
+    if (!arb_ge(T, u))
+        goto cleanup;
+
+    tbits = arf_abs_bound_lt_2exp_si(arb_midref(T));
+
+    /* a = sqrt(t / (2 pi)), m = floor(a) */
+    arb_const_pi(a, prec + tbits + 10);
+    arb_mul_2exp_si(a, a, 1);
+    arb_div(a, T, a, prec + tbits + 10);
+    arb_sqrt(a, a, prec + tbits + 10);
+    arb_floor(p, a, prec + tbits + 10);
+
+    if (!arb_get_unique_fmpz(mz, p) || fmpz_sgn(mz) <= 0
+            || fmpz_bits(mz) > FLINT_BITS - 2)
+        goto cleanup;
+
+    m = fmpz_get_ui(mz);
+
+    /* the terms in the main sum have arguments of size about t log m */
+    wp = prec + tbits + 2 * FLINT_BIT_COUNT(m) + 10;
+
+    arb_const_pi(a, wp);
+    arb_mul_2exp_si(a, a, 1);
+    arb_div(a, T, a, wp);
+    arb_sqrt(a, a, wp);
+    arb_sub_ui(p, a, m, wp);
+
+    _arb_poly_riemann_siegel_theta_series(theta, T, 1, 1, wp);
+    _arb_poly_riemann_siegel_sum(S, theta, T, m, wp);
+    arb_mul_2exp_si(S, S, 1);
+
+    /* correction terms */
+    arb_one(u);
+    arb_mul_2exp_si(u, u, -1);
+    arb_sub(u, p, u, prec + 20);
+    _arb_poly_riemann_siegel_psi_derivs(D, u, 3 * K + 1, prec + 20);
+
+    arb_const_pi(v, prec + 20);
+    arb_mul(v, v, v, prec + 20);
+    arb_inv(v, v, prec + 20);
+
+    /* Horner in 1/a */
+    arb_zero(C);
+    for (k = K; k >= 0; k--)
+    {
+        if (k != K)
+            arb_div(C, C, a, prec + 20);
+
+        for (i = 0; i < (long) RS_NUM_COEFFS; i++)
+        {
+            if (rs_coeffs[i].k != k)
+                continue;
+
+            arb_pow_ui(u, v, rs_coeffs[i].e, prec + 20);
+            arb_mul(u, u, D + rs_coeffs[i].j, prec + 20);
+            arb_mul_si(u, u, rs_coeffs[i].num, prec + 20);
+            arb_div_ui(u, u, rs_coeffs[i].den, prec + 20);
+            arb_add(C, C, u, prec + 20);
+        }
+    }
+
+    arb_rsqrt(u, a, prec + 20);
+    arb_mul(C, C, u, prec + 20);
+    if (m % 2 == 0)
+        arb_neg(C, C);
+
+    /* remainder: g_K t^(-(2K+3)/4) */
+    arb_get_abs_lbound_arf(arb_midref(u), T, MAG_BITS);
+    mag_zero(arb_radref(u));
+    arb_root(u, u, 4, MAG_BITS);
+    arb_pow_ui(u, u, 2 * K + 3, MAG_BITS);
+    arb_set_ui(v, rs_remainder_bound[K]);
+    arb_div_ui(v, v, 1000, MAG_BITS);
+    arb_div(v, v, u, MAG_BITS);
+    arb_get_mag(err, v);
+
+    arb_add(res, S, C, prec);
+    arb_add_error_mag(res, err);
+
+    success = 1;
+
+cleanup:
+    arb_clear(T);
+    arb_clear(a);
+    arb_clear(p);
+    arb_clear(theta);
+    arb_clear(S);
+    arb_clear(C);
+    arb_clear(u);
+    arb_clear(v);
+    fmpz_clear(mz);
+    mag_clear(err);
+    _arb_vec_clear(D, 3 * K + 1);
+
+    return success;
+}
@@ -34,6 +34,14 @@ _arb_poly_riemann_siegel_z_series(arb_ptr res, arb_srcptr h, long hlen, long len
 
     hlen = FLINT_MIN(hlen, len);
 
+    if (len == 1)
+    {
+        long K = _arb_poly_riemann_siegel_rs_terms(h, prec);
+
+        if (K >= 0 && _arb_poly_riemann_siegel_z_rs(res, h, K, prec))
+            return;
+    }
+
     alloc = 5 * len;
     t = _arb_vec_init(alloc);
     u = t + len;
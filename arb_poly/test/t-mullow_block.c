@@ -215,6 +215,103 @@ int main()
         arb_poly_clear(abc2);
     }
 
+    /* a single outlying exponent in a long series must not make the
+       block containing it absurdly tall (this would take a huge amount
+       of time and memory) */
+    for (iter = 0; iter < 3; iter++)
+    {
+        long i, len, prec;
+        arb_poly_t a, b, c, d;
+
+        len = 1000 + n_randint(state, 1000);
+        prec = 64 + n_randint(state, 200);
+
+        arb_poly_init(a);
+        arb_poly_init(b);
+        arb_poly_init(c);
+        arb_poly_init(d);
+
+        arb_poly_fit_length(a, len);
+        arb_poly_fit_length(b, len);
+
+        arb_one(a->coeffs);
+        arb_one(b->coeffs);
+
+        for (i = 1; i < len; i++)
+        {
+            arb_div_ui(a->coeffs + i, a->coeffs + i - 1, i, prec);
+            arb_mul_2exp_si(b->coeffs + i, b->coeffs + i - 1, -1);
+        }
+
+        i = 1 + n_randint(state, len - 1);
+        arb_mul_2exp_si(a->coeffs + i, a->coeffs + i, 1000000);
+
+        _arb_poly_set_length(a, len);
+        _arb_poly_set_length(b, len);
+
+        arb_poly_mullow_block(c, a, b, len, prec);
+        arb_poly_mullow_classical(d, a, b, len, prec);
+
+        if (!arb_poly_overlaps(c, d))
+        {
+            printf("FAIL (outlier)\n\n");
+            printf("len = %ld, prec = %ld, i = %ld\n", len, prec, i);
+            abort();
+        }
+
+        arb_poly_clear(a);
+        arb_poly_clear(b);
+        arb_poly_clear(c);
+        arb_poly_clear(d);
+    }
+
+    /* long products, which are split into blocks between threads;
+       the result must not depend on the number of threads */
+    for (iter = 0; iter < 30; iter++)
+    {
+        long prec, trunc;
+        arb_poly_t a, b, c, d;
+
+        prec = 2 + n_randint(state, 200);
+        trunc = n_randint(state, 3000);
+
+        arb_poly_init(a);
+        arb_poly_init(b);
+        arb_poly_init(c);
+        arb_poly_init(d);
+
+        arb_poly_randtest(a, state, 1 + n_randint(state, 3000), prec, 3);
+        if (n_randint(state, 4) == 0)
+            arb_poly_set(b, a);
+        else
+            arb_poly_randtest(b, state, 1 + n_randint(state, 3000), prec, 3);
+
+        flint_set_num_threads(1);
+        arb_poly_mullow_block(c, a, b, trunc, prec);
+
+        flint_set_num_threads(2 + n_randint(state, 7));
+
+        if (arb_poly_equal(a, b) && n_randint(state, 2))
+            arb_poly_mullow_block(d, a, a, trunc, prec);
+        else
+            arb_poly_mullow_block(d, a, b, trunc, prec);
+
+        if (!arb_poly_equal(c, d))
+        {
+            printf("FAIL (threads)\n\n");
+            printf("threads = %d, prec = %ld, trunc = %ld\n",
+                flint_get_num_threads(), prec, trunc);
+            printf("lengths = %ld, %ld\n", a->length, b->length);
+            abort();
+        }
+
+        arb_poly_clear(a);
+        arb_poly_clear(b);
+        arb_poly_clear(c);
+        arb_poly_clear(d);
+    }
+
+    flint_set_num_threads(1);
     flint_randclear(state);
     flint_cleanup();
     printf("PASS\n");
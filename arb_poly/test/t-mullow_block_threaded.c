@@ -0,0 +1,93 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_poly.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("mullow_block_threaded....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* the integer products are exact, so the result
+       must not depend on the number of threads */
+    for (iter = 0; iter < 100; iter++)
+    {
+        long len1, len2, trunc, prec;
+        int squaring;
+        arb_poly_t a, b, c, d;
+
+        len1 = 1 + n_randint(state, 2000);
+        len2 = 1 + n_randint(state, 2000);
+        trunc = n_randint(state, len1 + len2);
+        prec = 2 + n_randint(state, 400);
+        squaring = (n_randint(state, 4) == 0);
+
+        arb_poly_init(a);
+        arb_poly_init(b);
+        arb_poly_init(c);
+        arb_poly_init(d);
+
+        arb_poly_randtest(a, state, len1, 2 + n_randint(state, 400),
+            1 + n_randint(state, 10));
+        arb_poly_randtest(b, state, len2, 2 + n_randint(state, 400),
+            1 + n_randint(state, 10));
+
+        flint_set_num_threads(1);
+        arb_poly_mullow_block(c, a, squaring ? a : b, trunc, prec);
+
+        flint_set_num_threads(2 + n_randint(state, 7));
+        arb_poly_mullow_block(d, a, squaring ? a : b, trunc, prec);
+
+        if (!arb_poly_equal(c, d))
+        {
+            printf("FAIL\n\n");
+            printf("len1 = %ld, len2 = %ld, trunc = %ld, prec = %ld\n",
+                len1, len2, trunc, prec);
+            printf("squaring = %d, threads = %d\n\n",
+                squaring, flint_get_num_threads());
+            printf("c = "); arb_poly_printd(c, 15); printf("\n\n");
+            printf("d = "); arb_poly_printd(d, 15); printf("\n\n");
+            abort();
+        }
+
+        flint_set_num_threads(1);
+
+        arb_poly_clear(a);
+        arb_poly_clear(b);
+        arb_poly_clear(c);
+        arb_poly_clear(d);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,203 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_poly.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("mulmid....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* compare with fmpq_poly */
+    for (iter = 0; iter < 10000; iter++)
+    {
+        long qbits1, qbits2, rbits1, rbits2, rbits3, lo, hi;
+        fmpq_poly_t A, B, C;
+        arb_poly_t a, b, c, d;
+
+        qbits1 = 2 + n_randint(state, 1000);
+        qbits2 = 2 + n_randint(state, 1000);
+        rbits1 = 2 + n_randint(state, 1000);
+        rbits2 = 2 + n_randint(state, 1000);
+        rbits3 = 2 + n_randint(state, 1000);
+        lo = n_randint(state, 100);
+        hi = lo + n_randint(state, 100);
+
+        fmpq_poly_init(A);
+        fmpq_poly_init(B);
+        fmpq_poly_init(C);
+
+        arb_poly_init(a);
+        arb_poly_init(b);
+        arb_poly_init(c);
+        arb_poly_init(d);
+
+        fmpq_poly_randtest(A, state, 1 + n_randint(state, 100), qbits1);
+        fmpq_poly_randtest(B, state, 1 + n_randint(state, 100), qbits2);
+        fmpq_poly_mullow(C, A, B, hi);
+        fmpq_poly_shift_right(C, C, lo);
+
+        arb_poly_set_fmpq_poly(a, A, rbits1);
+        arb_poly_set_fmpq_poly(b, B, rbits2);
+        arb_poly_mulmid(c, a, b, lo, hi, rbits3);
+
+        if (!arb_poly_contains_fmpq_poly(c, C))
+        {
+            printf("FAIL\n\n");
+            printf("bits3 = %ld\n", rbits3);
+            printf("lo = %ld, hi = %ld\n", lo, hi);
+
+            printf("A = "); fmpq_poly_print(A); printf("\n\n");
+            printf("B = "); fmpq_poly_print(B); printf("\n\n");
+            printf("C = "); fmpq_poly_print(C); printf("\n\n");
+
+            printf("a = "); arb_poly_printd(a, 15); printf("\n\n");
+            printf("b = "); arb_poly_printd(b, 15); printf("\n\n");
+            printf("c = "); arb_poly_printd(c, 15); printf("\n\n");
+
+            abort();
+        }
+
+        arb_poly_set(d, a);
+        arb_poly_mulmid(d, d, b, lo, hi, rbits3);
+        if (!arb_poly_equal(d, c))
+        {
+            printf("FAIL (aliasing 1)\n\n");
+            abort();
+        }
+
+        arb_poly_set(d, b);
+        arb_poly_mulmid(d, a, d, lo, hi, rbits3);
+        if (!arb_poly_equal(d, c))
+        {
+            printf("FAIL (aliasing 2)\n\n");
+            abort();
+        }
+
+        /* test squaring */
+        arb_poly_set(b, a);
+        arb_poly_mulmid(c, a, b, lo, hi, rbits3);
+        arb_poly_mulmid(d, a, a, lo, hi, rbits3);
+        if (!arb_poly_overlaps(c, d))  /* not guaranteed to be identical */
+        {
+            printf("FAIL (squaring)\n\n");
+
+            printf("a = "); arb_poly_printd(a, 15); printf("\n\n");
+            printf("c = "); arb_poly_printd(c, 15); printf("\n\n");
+            printf("d = "); arb_poly_printd(d, 15); printf("\n\n");
+
+            abort();
+        }
+
+        arb_poly_mulmid(a, a, a, lo, hi, rbits3);
+        if (!arb_poly_equal(d, a))
+        {
+            printf("FAIL (aliasing, squaring)\n\n");
+            abort();
+        }
+
+        fmpq_poly_clear(A);
+        fmpq_poly_clear(B);
+        fmpq_poly_clear(C);
+
+        arb_poly_clear(a);
+        arb_poly_clear(b);
+        arb_poly_clear(c);
+        arb_poly_clear(d);
+    }
+
+    /* compare with mullow and mul */
+    for (iter = 0; iter < 3000; iter++)
+    {
+        long rbits1, rbits2, rbits3, lo, hi;
+        arb_poly_t a, b, c, d;
+
+        rbits1 = 2 + n_randint(state, 300);
+        rbits2 = 2 + n_randint(state, 300);
+        rbits3 = 2 + n_randint(state, 300);
+        lo = n_randint(state, 100);
+        hi = lo + n_randint(state, 100);
+
+        arb_poly_init(a);
+        arb_poly_init(b);
+        arb_poly_init(c);
+        arb_poly_init(d);
+
+        arb_poly_randtest(a, state, 1 + n_randint(state, 100), rbits1, 1 + n_randint(state, 100));
+        arb_poly_randtest(b, state, 1 + n_randint(state, 100), rbits2, 1 + n_randint(state, 100));
+
+        arb_poly_mullow(c, a, b, hi, rbits3);
+        arb_poly_shift_right(c, c, lo);
+        arb_poly_mulmid(d, a, b, lo, hi, rbits3);
+
+        if (!arb_poly_overlaps(c, d))
+        {
+            printf("FAIL (mullow)\n\n");
+            printf("bits3 = %ld\n", rbits3);
+            printf("lo = %ld, hi = %ld\n", lo, hi);
+
+            printf("a = "); arb_poly_printd(a, 15); printf("\n\n");
+            printf("b = "); arb_poly_printd(b, 15); printf("\n\n");
+            printf("c = "); arb_poly_printd(c, 15); printf("\n\n");
+            printf("d = "); arb_poly_printd(d, 15); printf("\n\n");
+
+            abort();
+        }
+
+        arb_poly_mul(c, a, b, rbits3);
+        arb_poly_shift_right(c, c, lo);
+        arb_poly_mulhigh(d, a, b, lo, rbits3);
+
+        if (!arb_poly_overlaps(c, d))
+        {
+            printf("FAIL (mulhigh)\n\n");
+            printf("bits3 = %ld\n", rbits3);
+            printf("lo = %ld\n", lo);
+
+            printf("a = "); arb_poly_printd(a, 15); printf("\n\n");
+            printf("b = "); arb_poly_printd(b, 15); printf("\n\n");
+            printf("c = "); arb_poly_printd(c, 15); printf("\n\n");
+            printf("d = "); arb_poly_printd(d, 15); printf("\n\n");
+
+            abort();
+        }
+
+        arb_poly_clear(a);
+        arb_poly_clear(b);
+        arb_poly_clear(c);
+        arb_poly_clear(d);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,115 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_poly.h"
+#include "acb_poly.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("riemann_siegel_z_rs....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 200; iter++)
+    {
+        arb_t t, z, w, theta;
+        acb_t s, a;
+        long K, prec1, prec2;
+
+        arb_init(t);
+        arb_init(z);
+        arb_init(w);
+        arb_init(theta);
+        acb_init(s);
+        acb_init(a);
+
+        prec1 = 2 + n_randint(state, 60);
+        prec2 = prec1 + 20;
+        K = n_randint(state, ARB_POLY_RIEMANN_SIEGEL_MAX_K + 1);
+
+        /* t in [200, 20000] */
+        arb_set_ui(t, 200 + n_randint(state, 19800));
+        arb_randtest(w, state, 1 + n_randint(state, 100), 2);
+        arb_add(t, t, w, 2 + n_randint(state, 100));
+        arb_abs(t, t);
+        if (n_randint(state, 2))
+            arb_neg(t, t);
+
+        if (!_arb_poly_riemann_siegel_z_rs(z, t, K, prec1))
+            arb_indeterminate(z);
+
+        /* reference: exp(i theta(t)) zeta(1/2+it) by Euler-Maclaurin */
+        arb_one(acb_realref(s));
+        arb_mul_2exp_si(acb_realref(s), acb_realref(s), -1);
+        arb_set(acb_imagref(s), t);
+        acb_one(a);
+        acb_hurwitz_zeta(s, s, a, prec2 + 40);
+        _arb_poly_riemann_siegel_theta_series(theta, t, 1, 1, prec2 + 40);
+        arb_sin_cos(acb_imagref(a), acb_realref(a), theta, prec2 + 40);
+        acb_mul(s, s, a, prec2);
+
+        if (!arb_overlaps(z, acb_realref(s)) || !arb_contains_zero(acb_imagref(s)))
+        {
+            printf("FAIL: overlap\n\n");
+            printf("K = %ld\n\n", K);
+            printf("t = "); arb_printd(t, 30); printf("\n\n");
+            printf("z = "); arb_printd(z, 30); printf("\n\n");
+            printf("s = "); acb_printd(s, 30); printf("\n\n");
+            abort();
+        }
+
+        /* automatic choice */
+        K = _arb_poly_riemann_siegel_rs_terms(t, prec1);
+
+        if (K >= 0 && arb_is_exact(t))
+        {
+            if (!_arb_poly_riemann_siegel_z_rs(z, t, K, prec1) ||
+                mag_cmp_2exp_si(arb_radref(z), -prec1 + 5) > 0)
+            {
+                printf("FAIL: accuracy\n\n");
+                printf("K = %ld, prec1 = %ld\n\n", K, prec1);
+                printf("t = "); arb_printd(t, 30); printf("\n\n");
+                printf("z = "); arb_printd(z, 30); printf("\n\n");
+                abort();
+            }
+        }
+
+        arb_clear(t);
+        arb_clear(z);
+        arb_clear(w);
+        arb_clear(theta);
+        acb_clear(s);
+        acb_clear(a);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,199 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <math.h>
+#include "arb_poly.h"
+#include "profiler.h"
+
+/*
+    Fits the parameters ARB_POLY_MULLOW_BLOCK_ALPHA and
+    ARB_POLY_MULLOW_BLOCK_BETA of the cost model used to split the
+    midpoints into blocks in _arb_poly_mullow_block.
+
+    Each candidate pair of parameters is timed on a set of test products
+    (power series with coefficients decaying like 1/k!, geometrically,
+    and with randomly drifting exponents, at several lengths and
+    precisions). The candidates are ranked by the geometric mean of the
+    time relative to the current defaults, and the best values are
+    printed in a form that can be added to CFLAGS.
+*/
+
+#define NUM_ALPHA 7
+#define NUM_BETA 5
+#define NUM_KIND 3
+
+static const double alphas[NUM_ALPHA] = { 0.125, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0 };
+static const double betas[NUM_BETA] = { 0.0, 32.0, 64.0, 128.0, 256.0 };
+
+static void
+test_series(arb_ptr x, long len, int kind, long prec, flint_rand_t state)
+{
+    long i;
+
+    arb_one(x);
+
+    for (i = 1; i < len; i++)
+    {
+        if (kind == 0)
+        {
+            /* 1/k! */
+            arb_div_ui(x + i, x + i - 1, i, prec);
+        }
+        else if (kind == 1)
+        {
+            /* geometric decay */
+            arb_mul_2exp_si(x + i, x + i - 1, -3);
+            arb_mul_ui(x + i, x + i, 5, prec);
+        }
+        else
+        {
+            /* random walk in the exponent */
+            arb_mul_2exp_si(x + i, x + i - 1, (long) n_randint(state, 9) - 6);
+        }
+    }
+
+    /* random signs and leading digits */
+    for (i = 0; i < len; i++)
+    {
+        arb_t t;
+        arb_init(t);
+        arb_set_ui(t, 1 + n_randint(state, 1000));
+        arb_div_ui(t, t, 1000, prec);
+        arb_mul(x + i, x + i, t, prec);
+        if (n_randint(state, 2))
+            arb_neg(x + i, x + i);
+        arb_clear(t);
+    }
+}
+
+static double
+time_product(arb_ptr z, arb_srcptr x, arb_srcptr y, long len,
+    long prec, double alpha, double beta)
+{
+    timeit_t timer;
+    long i, reps;
+
+    reps = 1;
+
+    while (1)
+    {
+        timeit_start(timer);
+        for (i = 0; i < reps; i++)
+            _arb_poly_mullow_block_params(z, x, len, y, len, len, prec,
+                alpha, beta);
+        timeit_stop(timer);
+
+        if (timer->cpu >= 100)
+            return (double) timer->cpu / reps;
+
+        reps *= 2;
+    }
+}
+
+int main()
+{
+    long len, prec, i, j, kind, best_i, best_j, num;
+    double score[NUM_ALPHA][NUM_BETA];
+    double t, t0;
+    arb_ptr x, y, z;
+    flint_rand_t state;
+
+    flint_randinit(state);
+
+    for (i = 0; i < NUM_ALPHA; i++)
+        for (j = 0; j < NUM_BETA; j++)
+            score[i][j] = 0.0;
+
+    num = 0;
+
+    for (len = 100; len <= 10000; len *= 10)
+    {
+        for (prec = 64; prec <= 4096; prec *= 4)
+        {
+            for (kind = 0; kind < NUM_KIND; kind++)
+            {
+                x = _arb_vec_init(len);
+                y = _arb_vec_init(len);
+                z = _arb_vec_init(len);
+
+                test_series(x, len, kind, prec, state);
+                test_series(y, len, kind, prec, state);
+
+                t0 = time_product(z, x, y, len, prec,
+                    ARB_POLY_MULLOW_BLOCK_ALPHA, ARB_POLY_MULLOW_BLOCK_BETA);
+
+                printf("len = %5ld  prec = %4ld  kind = %ld  default: %8.3f ms",
+                    len, prec, kind, t0);
+
+                t = t0;
+
+                for (i = 0; i < NUM_ALPHA; i++)
+                {
+                    for (j = 0; j < NUM_BETA; j++)
+                    {
+                        double u = time_product(z, x, y, len, prec,
+                            alphas[i], betas[j]);
+
+                        score[i][j] += log(u / t0);
+                        t = FLINT_MIN(t, u);
+                    }
+                }
+
+                printf("  best: %8.3f ms\n", t);
+                num++;
+                fflush(stdout);
+
+                _arb_vec_clear(x, len);
+                _arb_vec_clear(y, len);
+                _arb_vec_clear(z, len);
+            }
+        }
+    }
+
+    best_i = best_j = 0;
+
+    for (i = 0; i < NUM_ALPHA; i++)
+    {
+        for (j = 0; j < NUM_BETA; j++)
+        {
+            printf("alpha = %6.3f  beta = %5.1f  relative time: %.3f\n",
+                alphas[i], betas[j], exp(score[i][j] / num));
+
+            if (score[i][j] < score[best_i][best_j])
+            {
+                best_i = i;
+                best_j = j;
+            }
+        }
+    }
+
+    printf("\n-DARB_POLY_MULLOW_BLOCK_ALPHA=%g -DARB_POLY_MULLOW_BLOCK_BETA=%g\n",
+        alphas[best_i], betas[best_j]);
+
+    flint_randclear(state);
+    flint_cleanup();
+    return EXIT_SUCCESS;
+}
+
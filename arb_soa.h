@@ -0,0 +1,103 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#ifndef ARB_SOA_H
+#define ARB_SOA_H
+
+#ifdef ARB_SOA_INLINES_C
+#define ARB_SOA_INLINE
+#else
+#define ARB_SOA_INLINE static __inline__
+#endif
+
+#include "arb_fixed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    A vector of balls in structure-of-arrays form. Entry i has the
+    midpoint (-1)^sgnbit[i] * 0.d * 2^exp[i], where d is the block of
+    limbs mid[i * limbs], ..., mid[i * limbs + limbs - 1] (normalized as
+    for the arb_fixed types), and the radius rad_man[i] * 2^(rad_exp[i]
+    - MAG_BITS), with the same conventions as mag_t (a zero radius has
+    rad_man[i] = rad_exp[i] = 0). Entries that cannot be represented
+    have exp[i] = ARB_FIXED_EXP_NAN.
+*/
+typedef struct
+{
+    mp_ptr mid;
+    long * exp;
+    int * sgnbit;
+    mp_ptr rad_man;
+    long * rad_exp;
+    long len;
+    long limbs;
+}
+arb_soa_struct;
+
+typedef arb_soa_struct arb_soa_t[1];
+
+void arb_soa_init(arb_soa_t v, long len, long prec);
+
+void arb_soa_clear(arb_soa_t v);
+
+ARB_SOA_INLINE long
+arb_soa_length(const arb_soa_t v)
+{
+    return v->len;
+}
+
+ARB_SOA_INLINE long
+arb_soa_limbs(const arb_soa_t v)
+{
+    return v->limbs;
+}
+
+void arb_soa_set_arb_vec(arb_soa_t v, arb_srcptr x);
+
+void arb_soa_get_arb_vec(arb_ptr x, const arb_soa_t v);
+
+void arb_soa_get_mag(mag_t bound, const arb_soa_t v);
+
+/* Radius kernels, acting on arrays of mantissas and small exponents. */
+
+void _arb_soa_rad_add(mp_ptr zman, long * zexp,
+    mp_srcptr xman, const long * xexp,
+    mp_srcptr yman, const long * yexp, long len);
+
+void _arb_soa_rad_mul(mp_ptr zman, long * zexp,
+    mp_srcptr xman, const long * xexp,
+    mp_srcptr yman, const long * yexp, long len);
+
+void _arb_soa_rad_max(mag_t bound, mp_srcptr man, const long * exp, long len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
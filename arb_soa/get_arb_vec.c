@@ -0,0 +1,43 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_soa.h"
+
+void
+arb_soa_get_arb_vec(arb_ptr x, const arb_soa_t v)
+{
+    mag_struct r;
+    long i, n = v->limbs;
+
+    for (i = 0; i < v->len; i++)
+    {
+        MAG_MAN(&r) = v->rad_man[i];
+        MAG_EXP(&r) = v->rad_exp[i];
+
+        _arb_fixed_get_arb(x + i, v->mid + i * n, v->exp[i], v->sgnbit[i],
+            &r, n);
+    }
+}
+
@@ -0,0 +1,56 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_soa.h"
+
+void
+arb_soa_get_mag(mag_t bound, const arb_soa_t v)
+{
+    mag_t t, u, b;
+    long i, n = v->limbs;
+
+    mag_fast_zero(b);
+
+    for (i = 0; i < v->len; i++)
+    {
+        if (v->exp[i] == ARB_FIXED_EXP_NAN)
+        {
+            mag_inf(bound);
+            return;
+        }
+
+        _arb_fixed_get_mag(t, v->mid + i * n, v->exp[i], n);
+        MAG_MAN(u) = v->rad_man[i];
+        MAG_EXP(u) = v->rad_exp[i];
+        _arb_fixed_mag_add(t, t, u);
+
+        if (MAG_MAN(t) != 0 && (MAG_MAN(b) == 0 || MAG_EXP(t) > MAG_EXP(b)
+            || (MAG_EXP(t) == MAG_EXP(b) && MAG_MAN(t) > MAG_MAN(b))))
+            mag_fast_init_set(b, t);
+    }
+
+    mag_set(bound, b);
+}
+
@@ -0,0 +1,53 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_soa.h"
+
+void
+arb_soa_init(arb_soa_t v, long len, long prec)
+{
+    long limbs = FLINT_MAX(1, (prec + FLINT_BITS - 1) / FLINT_BITS);
+
+    v->len = len;
+    v->limbs = limbs;
+
+    if (len == 0)
+    {
+        v->mid = NULL;
+        v->exp = NULL;
+        v->sgnbit = NULL;
+        v->rad_man = NULL;
+        v->rad_exp = NULL;
+    }
+    else
+    {
+        v->mid = flint_calloc(len * limbs, sizeof(mp_limb_t));
+        v->exp = flint_calloc(len, sizeof(long));
+        v->sgnbit = flint_calloc(len, sizeof(int));
+        v->rad_man = flint_calloc(len, sizeof(mp_limb_t));
+        v->rad_exp = flint_calloc(len, sizeof(long));
+    }
+}
+
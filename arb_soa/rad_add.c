@@ -0,0 +1,40 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_soa.h"
+
+/* The loop body is branch-free, so the compiler can vectorize it. */
+void
+_arb_soa_rad_add(mp_ptr zman, long * zexp,
+    mp_srcptr xman, const long * xexp,
+    mp_srcptr yman, const long * yexp, long len)
+{
+    long i;
+
+    for (i = 0; i < len; i++)
+        _mag_fast_add_raw(zman + i, zexp + i,
+            xman[i], xexp[i], yman[i], yexp[i]);
+}
+
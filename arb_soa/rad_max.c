@@ -0,0 +1,56 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_soa.h"
+
+/*
+    Two simple passes (maximum exponent, then maximum mantissa among
+    the entries with that exponent) that can both be vectorized.
+*/
+void
+_arb_soa_rad_max(mag_t bound, mp_srcptr man, const long * exp, long len)
+{
+    long i, e;
+    mp_limb_t m;
+
+    e = -ARB_FIXED_MAX_EXP * 2;
+    for (i = 0; i < len; i++)
+        e = (man[i] != 0 && exp[i] > e) ? exp[i] : e;
+
+    m = 0;
+    for (i = 0; i < len; i++)
+        m = (exp[i] == e && man[i] > m) ? man[i] : m;
+
+    if (m == 0)
+    {
+        mag_zero(bound);
+    }
+    else
+    {
+        fmpz_set_si(MAG_EXPREF(bound), e);
+        MAG_MAN(bound) = m;
+    }
+}
+
@@ -0,0 +1,159 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_soa.h"
+
+/* random radius with a small exponent */
+static void
+_rand_rad(mp_limb_t * man, long * exp, flint_rand_t state)
+{
+    mag_t t;
+    mag_init(t);
+
+    if (n_randint(state, 5) == 0)
+        mag_zero(t);
+    else
+        mag_randtest(t, state, 1 + n_randint(state, 20));
+
+    *man = MAG_MAN(t);
+    *exp = mag_is_zero(t) ? 0 : MAG_EXP(t);
+
+    mag_clear(t);
+}
+
+static void
+_get_arf(arf_t x, mp_limb_t man, long exp)
+{
+    mag_t t;
+    mag_init(t);
+    if (man != 0)
+    {
+        MAG_MAN(t) = man;
+        fmpz_set_si(MAG_EXPREF(t), exp);
+    }
+    arf_set_mag(x, t);
+    mag_clear(t);
+}
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("rad_mul....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000; iter++)
+    {
+        mp_ptr xm, ym, zm;
+        long * xe, * ye, * ze;
+        arf_t a, b, c, d;
+        long i, len;
+
+        len = n_randint(state, 50);
+
+        xm = flint_malloc(sizeof(mp_limb_t) * (len + 1));
+        ym = flint_malloc(sizeof(mp_limb_t) * (len + 1));
+        zm = flint_malloc(sizeof(mp_limb_t) * (len + 1));
+        xe = flint_malloc(sizeof(long) * (len + 1));
+        ye = flint_malloc(sizeof(long) * (len + 1));
+        ze = flint_malloc(sizeof(long) * (len + 1));
+
+        arf_init(a);
+        arf_init(b);
+        arf_init(c);
+        arf_init(d);
+
+        for (i = 0; i < len; i++)
+        {
+            _rand_rad(xm + i, xe + i, state);
+            _rand_rad(ym + i, ye + i, state);
+        }
+
+        _arb_soa_rad_mul(zm, ze, xm, xe, ym, ye, len);
+
+        for (i = 0; i < len; i++)
+        {
+            _get_arf(a, xm[i], xe[i]);
+            _get_arf(b, ym[i], ye[i]);
+            _get_arf(d, zm[i], ze[i]);
+            arf_mul(c, a, b, ARF_PREC_EXACT, ARF_RND_DOWN);
+
+            if (arf_cmp(d, c) < 0 || (zm[i] == 0 && ze[i] != 0) ||
+                (zm[i] != 0 && (zm[i] >> (MAG_BITS - 1)) != 1))
+            {
+                printf("FAIL: upper bound\n\n");
+                printf("a = "); arf_printd(a, 20); printf("\n\n");
+                printf("b = "); arf_printd(b, 20); printf("\n\n");
+                printf("c = "); arf_printd(c, 20); printf("\n\n");
+                printf("d = "); arf_printd(d, 20); printf("\n\n");
+                abort();
+            }
+
+            /* the bound should be reasonably tight */
+            arf_mul_2exp_si(d, d, -1);
+            if (arf_cmp(d, c) > 0)
+            {
+                printf("FAIL: accuracy\n\n");
+                printf("a = "); arf_printd(a, 20); printf("\n\n");
+                printf("b = "); arf_printd(b, 20); printf("\n\n");
+                printf("c = "); arf_printd(c, 20); printf("\n\n");
+                printf("d = "); arf_printd(d, 20); printf("\n\n");
+                abort();
+            }
+        }
+
+        /* aliasing */
+        _arb_soa_rad_mul(xm, xe, xm, xe, ym, ye, len);
+
+        for (i = 0; i < len; i++)
+        {
+            if (xm[i] != zm[i] || xe[i] != ze[i])
+            {
+                printf("FAIL: aliasing\n\n");
+                abort();
+            }
+        }
+
+        flint_free(xm);
+        flint_free(ym);
+        flint_free(zm);
+        flint_free(xe);
+        flint_free(ye);
+        flint_free(ze);
+
+        arf_clear(a);
+        arf_clear(b);
+        arf_clear(c);
+        arf_clear(d);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,135 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_soa.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("set_arb_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000; iter++)
+    {
+        arb_soa_t v;
+        arb_ptr x, y;
+        mag_t b, c;
+        arf_t t, u;
+        long i, len, prec;
+
+        len = n_randint(state, 30);
+        prec = 2 + n_randint(state, 500);
+
+        x = _arb_vec_init(len);
+        y = _arb_vec_init(len);
+        mag_init(b);
+        mag_init(c);
+        arf_init(t);
+        arf_init(u);
+        arb_soa_init(v, len, prec);
+
+        for (i = 0; i < len; i++)
+        {
+            if (n_randint(state, 20) == 0)
+                arb_randtest_special(x + i, state, 1 + n_randint(state, 500), 10);
+            else
+                arb_randtest(x + i, state, 1 + n_randint(state, 500), 10);
+        }
+
+        arb_soa_set_arb_vec(v, x);
+        arb_soa_get_arb_vec(y, v);
+
+        for (i = 0; i < len; i++)
+        {
+            if (!arb_contains(y + i, x + i))
+            {
+                printf("FAIL: containment\n\n");
+                printf("prec = %ld\n\n", prec);
+                printf("x = "); arb_print(x + i); printf("\n\n");
+                printf("y = "); arb_print(y + i); printf("\n\n");
+                abort();
+            }
+
+            if (arb_is_finite(x + i) &&
+                arf_bits(arb_midref(x + i)) <= FLINT_BITS * arb_soa_limbs(v) &&
+                !arb_equal(y + i, x + i))
+            {
+                printf("FAIL: exact roundtrip\n\n");
+                printf("prec = %ld\n\n", prec);
+                printf("x = "); arb_print(x + i); printf("\n\n");
+                printf("y = "); arb_print(y + i); printf("\n\n");
+                abort();
+            }
+        }
+
+        /* the radius bound and the magnitude bound */
+        _arb_soa_rad_max(b, v->rad_man, v->rad_exp, len);
+        arb_soa_get_mag(c, v);
+
+        for (i = 0; i < len; i++)
+        {
+            /* entries that were not representable */
+            if (!arb_is_finite(y + i))
+                continue;
+
+            if (mag_cmp(arb_radref(y + i), b) > 0)
+            {
+                printf("FAIL: rad_max\n\n");
+                printf("y = "); arb_print(y + i); printf("\n\n");
+                printf("b = "); mag_print(b); printf("\n\n");
+                abort();
+            }
+
+            arf_set_mag(t, arb_radref(y + i));
+            arf_abs(u, arb_midref(y + i));
+            arf_add(t, t, u, ARF_PREC_EXACT, ARF_RND_DOWN);
+
+            if (arf_cmpabs_mag(t, c) > 0)
+            {
+                printf("FAIL: get_mag\n\n");
+                printf("y = "); arb_print(y + i); printf("\n\n");
+                printf("c = "); mag_print(c); printf("\n\n");
+                abort();
+            }
+        }
+
+        arb_soa_clear(v);
+        _arb_vec_clear(x, len);
+        _arb_vec_clear(y, len);
+        mag_clear(b);
+        mag_clear(c);
+        arf_clear(t);
+        arf_clear(u);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#ifndef ARB_THREAD_POOL_H
+#define ARB_THREAD_POOL_H
+
+#include "flint.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    A single library-wide pool of persistent worker threads. Workers
+    are started on demand and live until arb_thread_pool_clear() is called
+    (this happens automatically when the thread that started the pool
+    calls flint_cleanup()). Since workers do not exit between jobs,
+    their thread-local caches (Bernoulli numbers, limb caches)
+    are kept from one job to the next.
+*/
+
+typedef void (*arb_thread_pool_func_t)(void * args, long i);
+
+void arb_thread_pool_parallel_do(arb_thread_pool_func_t f, void * args,
+    long n, long num_threads);
+
+typedef void (*arb_thread_pool_chunk_func_t)(void * args, long a, long b);
+
+void arb_thread_pool_parallel_chunks(arb_thread_pool_chunk_func_t f,
+    void * args, long len, long num_threads);
+
+long arb_thread_pool_do_each(arb_thread_pool_func_t f, void * args,
+    long num_threads);
+
+long arb_thread_pool_num_workers(void);
+
+/* parallel binary splitting */
+
+typedef void (*arb_thread_pool_bsplit_init_t)(void * x);
+
+typedef void (*arb_thread_pool_bsplit_clear_t)(void * x);
+
+typedef void (*arb_thread_pool_bsplit_basecase_t)(void * x,
+    long a, long b, int cont, void * args);
+
+typedef void (*arb_thread_pool_bsplit_merge_t)(void * left, void * right,
+    long a, long m, long b, int cont, void * args);
+
+void arb_thread_pool_bsplit(void * res, long a, long b, void * args,
+    size_t size, arb_thread_pool_bsplit_init_t init,
+    arb_thread_pool_bsplit_clear_t clear,
+    arb_thread_pool_bsplit_basecase_t basecase,
+    arb_thread_pool_bsplit_merge_t merge,
+    long cutoff, long num_threads);
+
+void arb_thread_pool_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
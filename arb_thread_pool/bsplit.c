@@ -0,0 +1,153 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_thread_pool.h"
+
+/*
+    The interval [a, b) is split recursively at m = (a + b) / 2 into
+    2^depth leaves, exactly as a serial binary splitting recursion would
+    split it. The leaves are computed in parallel, and then merged
+    level by level, each level in parallel. The results are therefore
+    identical to those of the serial recursion. Leaf 0 is stored
+    directly in res.
+*/
+
+typedef struct
+{
+    char * res;
+    char * buf;
+    size_t size;
+    const long * bounds;
+    long num;
+    long step;
+    void * args;
+    arb_thread_pool_bsplit_basecase_t basecase;
+    arb_thread_pool_bsplit_merge_t merge;
+}
+bsplit_work_t;
+
+static __inline__ void *
+_bsplit_leaf(const bsplit_work_t * w, long i)
+{
+    return (i == 0) ? w->res : w->buf + (i - 1) * w->size;
+}
+
+static void
+_bsplit_bounds(long * bounds, long a, long b, long depth)
+{
+    long m;
+
+    if (depth == 0)
+    {
+        bounds[0] = a;
+        bounds[1] = b;
+    }
+    else
+    {
+        m = (a + b) / 2;
+        _bsplit_bounds(bounds, a, m, depth - 1);
+        _bsplit_bounds(bounds + (1L << (depth - 1)), m, b, depth - 1);
+    }
+}
+
+static void
+_bsplit_basecase_task(void * arg, long i)
+{
+    bsplit_work_t * w = arg;
+
+    w->basecase(_bsplit_leaf(w, i), w->bounds[i], w->bounds[i + 1],
+        1, w->args);
+}
+
+static void
+_bsplit_merge_task(void * arg, long j)
+{
+    bsplit_work_t * w = arg;
+    long i0, i1, i2;
+
+    i0 = 2 * j * w->step;
+    i1 = i0 + w->step;
+    i2 = i1 + w->step;
+
+    w->merge(_bsplit_leaf(w, i0), _bsplit_leaf(w, i1),
+        w->bounds[i0], w->bounds[i1], w->bounds[i2],
+        2 * w->step != w->num, w->args);
+}
+
+void
+arb_thread_pool_bsplit(void * res, long a, long b, void * args,
+    size_t size, arb_thread_pool_bsplit_init_t init,
+    arb_thread_pool_bsplit_clear_t clear,
+    arb_thread_pool_bsplit_basecase_t basecase,
+    arb_thread_pool_bsplit_merge_t merge,
+    long cutoff, long num_threads)
+{
+    bsplit_work_t w;
+    long * bounds;
+    long i, depth;
+
+    cutoff = FLINT_MAX(cutoff, 1);
+
+    /* use a few leaves per thread, so that the work can be balanced */
+    depth = 0;
+    while ((1L << depth) < 4 * num_threads && depth < FLINT_BITS - 2
+        && ((b - a) >> (depth + 1)) >= cutoff)
+        depth++;
+
+    if (num_threads <= 1 || depth == 0)
+    {
+        basecase(res, a, b, 0, args);
+        return;
+    }
+
+    w.num = 1L << depth;
+    w.res = res;
+    w.size = size;
+    w.args = args;
+    w.basecase = basecase;
+    w.merge = merge;
+
+    bounds = flint_malloc(sizeof(long) * (w.num + 1));
+    _bsplit_bounds(bounds, a, b, depth);
+    w.bounds = bounds;
+
+    w.buf = flint_malloc(size * (w.num - 1));
+    for (i = 1; i < w.num; i++)
+        init(_bsplit_leaf(&w, i));
+
+    arb_thread_pool_parallel_do(_bsplit_basecase_task, &w,
+        w.num, num_threads);
+
+    for (w.step = 1; w.step < w.num; w.step *= 2)
+        arb_thread_pool_parallel_do(_bsplit_merge_task, &w,
+            w.num / (2 * w.step), num_threads);
+
+    for (i = 1; i < w.num; i++)
+        clear(_bsplit_leaf(&w, i));
+
+    flint_free(w.buf);
+    flint_free(bounds);
+}
+
@@ -0,0 +1,73 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_thread_pool.h"
+
+typedef struct
+{
+    arb_thread_pool_chunk_func_t f;
+    void * args;
+    long len;
+    long chunk;
+}
+chunk_arg_t;
+
+static void
+_chunk_worker(void * arg_ptr, long k)
+{
+    chunk_arg_t * arg = arg_ptr;
+    long a, b;
+
+    a = k * arg->chunk;
+    b = FLINT_MIN(a + arg->chunk, arg->len);
+
+    arg->f(arg->args, a, b);
+}
+
+void
+arb_thread_pool_parallel_chunks(arb_thread_pool_chunk_func_t f, void * args,
+    long len, long num_threads)
+{
+    chunk_arg_t arg;
+    long num;
+
+    if (len <= 0)
+        return;
+
+    if (num_threads <= 1)
+    {
+        f(args, 0, len);
+        return;
+    }
+
+    /* a few chunks per thread for load balancing */
+    arg.f = f;
+    arg.args = args;
+    arg.len = len;
+    arg.chunk = (len + 4 * num_threads - 1) / (4 * num_threads);
+    num = (len + arg.chunk - 1) / arg.chunk;
+
+    arb_thread_pool_parallel_do(_chunk_worker, &arg, num, num_threads);
+}
@@ -0,0 +1,146 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_thread_pool.h"
+#include "fmpz.h"
+
+typedef struct
+{
+    fmpz_t prod;
+    long lo;
+    long hi;
+    int cont;
+}
+test_struct;
+
+static void
+test_init(void * x)
+{
+    test_struct * s = x;
+    fmpz_init(s->prod);
+    s->lo = s->hi = -1;
+    s->cont = -1;
+}
+
+static void
+test_clear(void * x)
+{
+    test_struct * s = x;
+    fmpz_clear(s->prod);
+}
+
+static void
+test_basecase(void * x, long a, long b, int cont, void * args)
+{
+    test_struct * s = x;
+    long i;
+
+    fmpz_one(s->prod);
+    for (i = a; i < b; i++)
+        fmpz_mul_ui(s->prod, s->prod, i + 1);
+
+    s->lo = a;
+    s->hi = b;
+    s->cont = cont;
+}
+
+static void
+test_merge(void * left, void * right, long a, long m, long b,
+    int cont, void * args)
+{
+    test_struct * L = left;
+    test_struct * R = right;
+
+    /* the split points must be those of the serial recursion */
+    if (L->lo != a || L->hi != m || R->lo != m || R->hi != b ||
+        m != (a + b) / 2 || L->cont != 1 || R->cont != 1)
+    {
+        printf("FAIL (merge)\n");
+        printf("a = %ld, m = %ld, b = %ld\n", a, m, b);
+        printf("L = [%ld, %ld), R = [%ld, %ld)\n", L->lo, L->hi, R->lo, R->hi);
+        abort();
+    }
+
+    fmpz_mul(L->prod, L->prod, R->prod);
+    L->hi = b;
+    L->cont = cont;
+}
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("bsplit....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000; iter++)
+    {
+        test_struct s;
+        fmpz_t f;
+        long a, b, cutoff, num_threads;
+
+        a = n_randint(state, 100);
+        b = a + n_randint(state, 1000);
+        cutoff = n_randint(state, 100);
+        num_threads = 1 + n_randint(state, 8);
+
+        test_init(&s);
+        fmpz_init(f);
+
+        arb_thread_pool_bsplit(&s, a, b, NULL, sizeof(test_struct),
+            test_init, test_clear, test_basecase, test_merge,
+            cutoff, num_threads);
+
+        fmpz_fac_ui(f, b);
+        if (a > 0)
+        {
+            fmpz_t g;
+            fmpz_init(g);
+            fmpz_fac_ui(g, a);
+            fmpz_divexact(f, f, g);
+            fmpz_clear(g);
+        }
+
+        if (!fmpz_equal(s.prod, f) || s.lo != a || s.hi != b || s.cont != 0)
+        {
+            printf("FAIL\n");
+            printf("a = %ld, b = %ld, cutoff = %ld, num_threads = %ld\n",
+                a, b, cutoff, num_threads);
+            abort();
+        }
+
+        test_clear(&s);
+        fmpz_clear(f);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
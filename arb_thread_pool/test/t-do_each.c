@@ -0,0 +1,81 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <pthread.h>
+#include "arb_thread_pool.h"
+#include "ulong_extras.h"
+
+static void
+record(void * args, long k)
+{
+    ((pthread_t *) args)[k] = pthread_self();
+}
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("do_each....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000; iter++)
+    {
+        pthread_t ids[8];
+        long i, j, num, m;
+
+        num = 1 + n_randint(state, 8);
+        m = arb_thread_pool_do_each(record, ids, num);
+
+        if (m < 1 || m > num || !pthread_equal(ids[0], pthread_self()))
+        {
+            printf("FAIL (m = %ld, num = %ld)\n", m, num);
+            abort();
+        }
+
+        for (i = 0; i < m; i++)
+        {
+            for (j = 0; j < i; j++)
+            {
+                if (pthread_equal(ids[i], ids[j]))
+                {
+                    printf("FAIL (not distinct)\n");
+                    abort();
+                }
+            }
+        }
+
+        if (iter % 300 == 299)
+            arb_thread_pool_clear();
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
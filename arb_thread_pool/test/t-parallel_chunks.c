@@ -0,0 +1,106 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_thread_pool.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    long * count;
+    long * start;
+}
+test_arg_t;
+
+static void
+chunk(void * args, long a, long b)
+{
+    test_arg_t * arg = args;
+    long i;
+
+    for (i = a; i < b; i++)
+    {
+        arg->count[i]++;
+        arg->start[i] = a;
+    }
+}
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("parallel_chunks....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 2000; iter++)
+    {
+        test_arg_t arg;
+        long i, len, num_threads, num;
+
+        len = n_randint(state, 200);
+        num_threads = 1 + n_randint(state, 8);
+        arg.count = flint_calloc(len + 1, sizeof(long));
+        arg.start = flint_calloc(len + 1, sizeof(long));
+
+        arb_thread_pool_parallel_chunks(chunk, &arg, len, num_threads);
+
+        num = 0;
+
+        for (i = 0; i < len; i++)
+        {
+            if (arg.count[i] != 1 || arg.start[i] > i ||
+                (i > 0 && arg.start[i] != arg.start[i - 1] &&
+                    arg.start[i] != i))
+            {
+                printf("FAIL\n");
+                printf("len = %ld, num_threads = %ld, i = %ld, count = %ld\n",
+                    len, num_threads, i, arg.count[i]);
+                abort();
+            }
+
+            num += (arg.start[i] == i);
+        }
+
+        /* about four chunks per thread */
+        if (num > FLINT_MAX(1, 4 * num_threads) ||
+            (num_threads == 1 && len > 0 && num != 1))
+        {
+            printf("FAIL (number of chunks)\n");
+            printf("len = %ld, num_threads = %ld, num = %ld\n",
+                len, num_threads, num);
+            abort();
+        }
+
+        flint_free(arg.count);
+        flint_free(arg.start);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
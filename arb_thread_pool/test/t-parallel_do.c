@@ -0,0 +1,125 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_thread_pool.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    long * count;
+    long n;
+    long num_threads;
+}
+test_arg_t;
+
+static void
+inner(void * args, long i)
+{
+    test_arg_t * arg = args;
+    arg->count[i]++;
+}
+
+static void
+outer(void * args, long i)
+{
+    test_arg_t * arg = args;
+
+    arg->count[i]++;
+
+    /* nested calls run serially */
+    if (i % 7 == 0)
+    {
+        test_arg_t arg2;
+        long j;
+
+        arg2.n = 5;
+        arg2.num_threads = arg->num_threads;
+        arg2.count = flint_calloc(arg2.n, sizeof(long));
+
+        arb_thread_pool_parallel_do(inner, &arg2, arg2.n, arg2.num_threads);
+
+        for (j = 0; j < arg2.n; j++)
+        {
+            if (arg2.count[j] != 1)
+            {
+                printf("FAIL (nested)\n");
+                abort();
+            }
+        }
+
+        flint_free(arg2.count);
+    }
+}
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("parallel_do....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 2000; iter++)
+    {
+        test_arg_t arg;
+        long i;
+
+        arg.n = n_randint(state, 200);
+        arg.num_threads = 1 + n_randint(state, 8);
+        arg.count = flint_calloc(arg.n + 1, sizeof(long));
+
+        arb_thread_pool_parallel_do(outer, &arg, arg.n, arg.num_threads);
+
+        for (i = 0; i < arg.n; i++)
+        {
+            if (arg.count[i] != 1)
+            {
+                printf("FAIL\n");
+                printf("n = %ld, num_threads = %ld, i = %ld, count = %ld\n",
+                    arg.n, arg.num_threads, i, arg.count[i]);
+                abort();
+            }
+        }
+
+        if (arb_thread_pool_num_workers() >= 8)
+        {
+            printf("FAIL (too many workers)\n");
+            abort();
+        }
+
+        flint_free(arg.count);
+
+        if (iter % 500 == 499)
+            arb_thread_pool_clear();
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
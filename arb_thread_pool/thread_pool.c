@@ -0,0 +1,358 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <pthread.h>
+#include "arb_thread_pool.h"
+
+/*
+    Slot 0 belongs to the thread that submits a job, and slots
+    1, ..., pool_num_workers to the workers. Each participant in a job
+    owns a range [lo, hi) of task indices, and takes tasks from the
+    bottom of its own range. A participant that runs out of work steals
+    the upper half of the range of another participant; it returns when
+    all ranges are empty. Tasks in transit between two ranges are
+    always run by the thief, so no task is lost.
+*/
+
+typedef struct
+{
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    long lo;
+    long hi;
+    long id;
+    ulong generation;
+}
+pool_slot_struct;
+
+/* serializes jobs; held by the thread that submitted the running job */
+static pthread_mutex_t pool_job_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* protects the job description and the counters below */
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_work_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done_cond = PTHREAD_COND_INITIALIZER;
+
+static pool_slot_struct ** pool_slots = NULL;
+static long pool_alloc = 0;
+static long pool_num_workers = 0;
+static ulong pool_generation = 0;
+static int pool_shutdown = 0;
+
+static arb_thread_pool_func_t pool_func;
+static void * pool_args;
+static long pool_participants;
+static int pool_steal;
+static long pool_running;
+
+static void
+_pool_run(long id)
+{
+    pool_slot_struct *s, *v;
+    long i, k, lo, hi;
+
+    s = pool_slots[id];
+
+    for (;;)
+    {
+        pthread_mutex_lock(&s->mutex);
+
+        if (s->lo < s->hi)
+        {
+            i = s->lo++;
+            pthread_mutex_unlock(&s->mutex);
+            pool_func(pool_args, i);
+            continue;
+        }
+
+        pthread_mutex_unlock(&s->mutex);
+
+        if (!pool_steal)
+            return;
+
+        for (k = 1; k < pool_participants; k++)
+        {
+            v = pool_slots[(id + k) % pool_participants];
+
+            pthread_mutex_lock(&v->mutex);
+
+            if (v->lo < v->hi)
+            {
+                lo = v->lo + (v->hi - v->lo) / 2;
+                hi = v->hi;
+                v->hi = lo;
+                pthread_mutex_unlock(&v->mutex);
+
+                pthread_mutex_lock(&s->mutex);
+                s->lo = lo;
+                s->hi = hi;
+                pthread_mutex_unlock(&s->mutex);
+                break;
+            }
+
+            pthread_mutex_unlock(&v->mutex);
+        }
+
+        if (k == pool_participants)
+            return;
+    }
+}
+
+static void *
+_pool_worker(void * arg)
+{
+    pool_slot_struct * s = arg;
+    ulong seen;
+
+    pthread_mutex_lock(&pool_lock);
+    seen = s->generation;
+
+    for (;;)
+    {
+        while (!pool_shutdown && pool_generation == seen)
+            pthread_cond_wait(&pool_work_cond, &pool_lock);
+
+        if (pool_shutdown)
+            break;
+
+        seen = pool_generation;
+
+        if (s->id < pool_participants)
+        {
+            pthread_mutex_unlock(&pool_lock);
+            _pool_run(s->id);
+            pthread_mutex_lock(&pool_lock);
+
+            pool_running--;
+            if (pool_running == 0)
+                pthread_cond_signal(&pool_done_cond);
+        }
+    }
+
+    pthread_mutex_unlock(&pool_lock);
+
+    /* the caches of this thread are only released here */
+    flint_cleanup();
+    return NULL;
+}
+
+static pool_slot_struct *
+_pool_slot_new(long id)
+{
+    pool_slot_struct * s;
+
+    s = flint_malloc(sizeof(pool_slot_struct));
+    pthread_mutex_init(&s->mutex, NULL);
+    s->lo = s->hi = 0;
+    s->id = id;
+    s->generation = pool_generation;
+
+    return s;
+}
+
+static void
+_pool_slot_clear(pool_slot_struct * s)
+{
+    pthread_mutex_destroy(&s->mutex);
+    flint_free(s);
+}
+
+/* Makes sure that there are at least num workers (unless thread creation
+   fails), and returns the number of workers. Must be called with
+   pool_job_lock held. */
+static long
+_pool_grow(long num)
+{
+    pool_slot_struct * s;
+
+    if (pool_alloc == 0)
+    {
+        pool_alloc = 1;
+        pool_slots = flint_malloc(sizeof(pool_slot_struct *));
+        pool_slots[0] = _pool_slot_new(0);
+        flint_register_cleanup_function(arb_thread_pool_clear);
+    }
+
+    while (pool_num_workers < num)
+    {
+        if (pool_num_workers + 1 >= pool_alloc)
+        {
+            pool_alloc = FLINT_MAX(2 * pool_alloc, pool_num_workers + 2);
+            pool_slots = flint_realloc(pool_slots,
+                sizeof(pool_slot_struct *) * pool_alloc);
+        }
+
+        s = _pool_slot_new(pool_num_workers + 1);
+
+        if (pthread_create(&s->thread, NULL, _pool_worker, s) != 0)
+        {
+            _pool_slot_clear(s);
+            break;
+        }
+
+        pool_slots[pool_num_workers + 1] = s;
+
+        pthread_mutex_lock(&pool_lock);
+        pool_num_workers++;
+        pthread_mutex_unlock(&pool_lock);
+    }
+
+    return pool_num_workers;
+}
+
+/* Runs the current job on num participants, including the caller. */
+static void
+_pool_job(arb_thread_pool_func_t f, void * args, long num, int steal)
+{
+    pthread_mutex_lock(&pool_lock);
+    pool_func = f;
+    pool_args = args;
+    pool_participants = num;
+    pool_steal = steal;
+    pool_running = num - 1;
+    pool_generation++;
+    pthread_cond_broadcast(&pool_work_cond);
+    pthread_mutex_unlock(&pool_lock);
+
+    _pool_run(0);
+
+    pthread_mutex_lock(&pool_lock);
+    while (pool_running > 0)
+        pthread_cond_wait(&pool_done_cond, &pool_lock);
+    pthread_mutex_unlock(&pool_lock);
+}
+
+void
+arb_thread_pool_parallel_do(arb_thread_pool_func_t f, void * args,
+    long n, long num_threads)
+{
+    long i, k;
+
+    num_threads = FLINT_MIN(num_threads, n);
+
+    /* nested calls, and calls made while another thread
+       is using the pool, run serially */
+    if (num_threads <= 1 || pthread_mutex_trylock(&pool_job_lock) != 0)
+    {
+        for (i = 0; i < n; i++)
+            f(args, i);
+        return;
+    }
+
+    num_threads = FLINT_MIN(num_threads, _pool_grow(num_threads - 1) + 1);
+
+    for (k = 0; k < num_threads; k++)
+    {
+        pool_slots[k]->lo = (n / num_threads) * k
+            + FLINT_MIN(k, n % num_threads);
+        pool_slots[k]->hi = (n / num_threads) * (k + 1)
+            + FLINT_MIN(k + 1, n % num_threads);
+    }
+
+    _pool_job(f, args, num_threads, 1);
+
+    pthread_mutex_unlock(&pool_job_lock);
+}
+
+long
+arb_thread_pool_do_each(arb_thread_pool_func_t f, void * args,
+    long num_threads)
+{
+    long k;
+
+    if (num_threads <= 1 || pthread_mutex_trylock(&pool_job_lock) != 0)
+    {
+        f(args, 0);
+        return 1;
+    }
+
+    num_threads = FLINT_MIN(num_threads, _pool_grow(num_threads - 1) + 1);
+
+    for (k = 0; k < num_threads; k++)
+    {
+        pool_slots[k]->lo = k;
+        pool_slots[k]->hi = k + 1;
+    }
+
+    _pool_job(f, args, num_threads, 0);
+
+    pthread_mutex_unlock(&pool_job_lock);
+
+    return num_threads;
+}
+
+long
+arb_thread_pool_num_workers(void)
+{
+    long n;
+
+    pthread_mutex_lock(&pool_lock);
+    n = pool_num_workers;
+    pthread_mutex_unlock(&pool_lock);
+
+    return n;
+}
+
+void
+arb_thread_pool_clear(void)
+{
+    long i;
+
+    /* a worker calling flint_cleanup() on its way out */
+    pthread_mutex_lock(&pool_lock);
+    i = pool_shutdown;
+    pthread_mutex_unlock(&pool_lock);
+
+    if (i)
+        return;
+
+    pthread_mutex_lock(&pool_job_lock);
+
+    pthread_mutex_lock(&pool_lock);
+    pool_shutdown = 1;
+    pthread_cond_broadcast(&pool_work_cond);
+    pthread_mutex_unlock(&pool_lock);
+
+    for (i = 1; i <= pool_num_workers; i++)
+        pthread_join(pool_slots[i]->thread, NULL);
+
+    if (pool_alloc != 0)
+    {
+        for (i = 0; i <= pool_num_workers; i++)
+            _pool_slot_clear(pool_slots[i]);
+
+        flint_free(pool_slots);
+    }
+
+    pthread_mutex_lock(&pool_lock);
+    pool_slots = NULL;
+    pool_alloc = 0;
+    pool_num_workers = 0;
+    pool_shutdown = 0;
+    pthread_mutex_unlock(&pool_lock);
+
+    pthread_mutex_unlock(&pool_job_lock);
+}
+
@@ -176,10 +176,42 @@ typedef arf_struct arf_t[1];
 typedef arf_struct * arf_ptr;
 typedef const arf_struct * arf_srcptr;
 
+/* Limb arrays of up to this many limbs are recycled by the memory manager. */
+#define ARF_MAX_CACHE_LIMBS 64
+#define ARF_CACHE_MIN_LIMBS 4
+#define ARF_CACHE_NUM_CLASSES 5
+#define ARF_CACHE_DEFAULT_BLOCKS 256
+
 void _arf_promote(arf_t x, mp_size_t n);
 
 void _arf_demote(arf_t x);
 
+void _arf_grow(arf_t x, mp_size_t n);
+
+void arf_cache_set_enabled(int flag);
+
+void arf_cache_set_limits(long max_limbs, long max_blocks);
+
+void arf_cache_get_stats(ulong * hits, ulong * misses);
+
+void arf_cache_reset_stats(void);
+
+void arf_cache_clear(void);
+
+extern FLINT_TLS_PREFIX int _arf_arena_active;
+
+mp_ptr _arf_arena_alloc(mp_size_t n);
+
+void arf_arena_push(void);
+
+void arf_arena_pop(void);
+
+void arf_arena_suspend(void);
+
+void arf_arena_resume(void);
+
+void arf_arena_clear(void);
+
 
 /* Warning: does not set size! -- also doesn't demote exponent. */
 #define ARF_DEMOTE(x)                 \
@@ -222,12 +254,9 @@ void _arf_demote(arf_t x);
             {                                               \
                 _arf_promote(x, __xn);                      \
             }                                               \
-            else if (ARF_PTR_ALLOC(x) < (__xn))             \
+            else if (FLINT_ABS(ARF_PTR_ALLOC(x)) < (__xn))  \
             {                                               \
-                ARF_PTR_D(x) = (mp_ptr)                     \
-                        flint_realloc(ARF_PTR_D(x),         \
-                        (xn) * sizeof(mp_limb_t));          \
-                ARF_PTR_ALLOC(x) = (__xn);                  \
+                _arf_grow(x, __xn);                         \
             }                                               \
             xptr = ARF_PTR_D(x);                            \
         }                                                   \
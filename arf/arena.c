@@ -0,0 +1,195 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arf.h"
+
+/*
+    Each thread owns a list of chunks which are filled from left to right.
+    A scope is described by the position (chunk index and number of used
+    limbs) at the time it was pushed; popping the scope resets the position,
+    making all memory allocated within the scope available again. Chunks
+    are kept until the thread calls flint_cleanup() or arf_arena_clear().
+*/
+
+#define ARF_ARENA_CHUNK_LIMBS 4096
+
+FLINT_TLS_PREFIX int _arf_arena_active = 0;
+
+FLINT_TLS_PREFIX mp_ptr * arf_arena_chunks = NULL;
+FLINT_TLS_PREFIX mp_size_t * arf_arena_chunk_size = NULL;
+FLINT_TLS_PREFIX long arf_arena_num_chunks = 0;
+FLINT_TLS_PREFIX long arf_arena_alloc_chunks = 0;
+
+FLINT_TLS_PREFIX long arf_arena_cur_chunk = 0;
+FLINT_TLS_PREFIX mp_size_t arf_arena_cur_used = 0;
+
+FLINT_TLS_PREFIX long * arf_arena_mark_chunk = NULL;
+FLINT_TLS_PREFIX mp_size_t * arf_arena_mark_used = NULL;
+FLINT_TLS_PREFIX long arf_arena_depth = 0;
+FLINT_TLS_PREFIX long arf_arena_alloc_depth = 0;
+FLINT_TLS_PREFIX long arf_arena_suspended = 0;
+
+FLINT_TLS_PREFIX int arf_arena_have_registered_cleanup = 0;
+
+void
+arf_arena_clear(void)
+{
+    long i;
+
+    if (arf_arena_depth != 0)
+    {
+        printf("exception: arf_arena_clear called inside a scope\n");
+        abort();
+    }
+
+    for (i = 0; i < arf_arena_num_chunks; i++)
+        flint_free(arf_arena_chunks[i]);
+
+    flint_free(arf_arena_chunks);
+    flint_free(arf_arena_chunk_size);
+    flint_free(arf_arena_mark_chunk);
+    flint_free(arf_arena_mark_used);
+
+    arf_arena_chunks = NULL;
+    arf_arena_chunk_size = NULL;
+    arf_arena_num_chunks = 0;
+    arf_arena_alloc_chunks = 0;
+    arf_arena_cur_chunk = 0;
+    arf_arena_cur_used = 0;
+    arf_arena_mark_chunk = NULL;
+    arf_arena_mark_used = NULL;
+    arf_arena_alloc_depth = 0;
+    arf_arena_suspended = 0;
+    _arf_arena_active = 0;
+}
+
+static void
+_arf_arena_cleanup(void)
+{
+    arf_arena_depth = 0;
+    arf_arena_clear();
+}
+
+void
+arf_arena_push(void)
+{
+    if (!arf_arena_have_registered_cleanup)
+    {
+        flint_register_cleanup_function(_arf_arena_cleanup);
+        arf_arena_have_registered_cleanup = 1;
+    }
+
+    if (arf_arena_depth == arf_arena_alloc_depth)
+    {
+        arf_arena_alloc_depth = FLINT_MAX(8, 2 * arf_arena_alloc_depth);
+        arf_arena_mark_chunk = flint_realloc(arf_arena_mark_chunk,
+            arf_arena_alloc_depth * sizeof(long));
+        arf_arena_mark_used = flint_realloc(arf_arena_mark_used,
+            arf_arena_alloc_depth * sizeof(mp_size_t));
+    }
+
+    arf_arena_mark_chunk[arf_arena_depth] = arf_arena_cur_chunk;
+    arf_arena_mark_used[arf_arena_depth] = arf_arena_cur_used;
+    arf_arena_depth++;
+
+    _arf_arena_active = (arf_arena_suspended == 0);
+}
+
+void
+arf_arena_pop(void)
+{
+    if (arf_arena_depth == 0)
+    {
+        printf("exception: arf_arena_pop called without matching push\n");
+        abort();
+    }
+
+    arf_arena_depth--;
+    arf_arena_cur_chunk = arf_arena_mark_chunk[arf_arena_depth];
+    arf_arena_cur_used = arf_arena_mark_used[arf_arena_depth];
+
+    _arf_arena_active = (arf_arena_depth != 0 && arf_arena_suspended == 0);
+}
+
+void
+arf_arena_suspend(void)
+{
+    arf_arena_suspended++;
+    _arf_arena_active = 0;
+}
+
+void
+arf_arena_resume(void)
+{
+    if (arf_arena_suspended == 0)
+    {
+        printf("exception: arf_arena_resume called without matching suspend\n");
+        abort();
+    }
+
+    arf_arena_suspended--;
+    _arf_arena_active = (arf_arena_depth != 0 && arf_arena_suspended == 0);
+}
+
+mp_ptr
+_arf_arena_alloc(mp_size_t n)
+{
+    mp_ptr ptr;
+
+    while (arf_arena_cur_chunk < arf_arena_num_chunks &&
+        arf_arena_chunk_size[arf_arena_cur_chunk] - arf_arena_cur_used < n)
+    {
+        arf_arena_cur_chunk++;
+        arf_arena_cur_used = 0;
+    }
+
+    if (arf_arena_cur_chunk == arf_arena_num_chunks)
+    {
+        mp_size_t size;
+
+        if (arf_arena_num_chunks == arf_arena_alloc_chunks)
+        {
+            arf_arena_alloc_chunks = FLINT_MAX(4, 2 * arf_arena_alloc_chunks);
+            arf_arena_chunks = flint_realloc(arf_arena_chunks,
+                arf_arena_alloc_chunks * sizeof(mp_ptr));
+            arf_arena_chunk_size = flint_realloc(arf_arena_chunk_size,
+                arf_arena_alloc_chunks * sizeof(mp_size_t));
+        }
+
+        /* chunk sizes grow geometrically with the number of chunks */
+        size = ARF_ARENA_CHUNK_LIMBS << FLINT_MIN(arf_arena_num_chunks, 8);
+        size = FLINT_MAX(size, n);
+
+        arf_arena_chunks[arf_arena_num_chunks] =
+            flint_malloc(size * sizeof(mp_limb_t));
+        arf_arena_chunk_size[arf_arena_num_chunks] = size;
+        arf_arena_num_chunks++;
+    }
+
+    ptr = arf_arena_chunks[arf_arena_cur_chunk] + arf_arena_cur_used;
+    arf_arena_cur_used += n;
+
+    return ptr;
+}
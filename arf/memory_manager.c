@@ -25,56 +25,137 @@
 
 #include "arf.h"
 
-#define ARF_USE_CACHE 0
-
-#define ARF_MAX_CACHE_LIMBS 64
-
-FLINT_TLS_PREFIX mp_ptr * arf_free_arr = NULL;
-FLINT_TLS_PREFIX ulong arf_free_num = 0;
-FLINT_TLS_PREFIX ulong arf_free_alloc = 0;
+/*
+    Freed limb arrays are kept in thread-local free lists, one for each
+    size class. Class c holds arrays of at least 4 * 2^c limbs, and
+    a new array is always allocated with the full size of its class so
+    that it can be recycled for any request falling in the same class.
+
+    Inside an arena scope (see arena.c), arrays are instead taken from
+    the arena and marked by storing the negated size in the alloc field.
+    Such arrays are never freed or cached individually.
+*/
+
+#ifndef ARF_USE_CACHE
+#define ARF_USE_CACHE 1
+#endif
+
+#define ARF_CACHE_CLASS_LIMBS(c) (ARF_CACHE_MIN_LIMBS << (c))
+
+/* Smallest class containing arrays of n >= 3 limbs. */
+#define ARF_CACHE_CLASS_UP(n) \
+    ((n) <= ARF_CACHE_MIN_LIMBS ? 0 : FLINT_CLOG2(n) - 2)
+
+/* Largest class whose arrays fit inside alloc >= 4 limbs. */
+#define ARF_CACHE_CLASS_DOWN(alloc) (FLINT_BIT_COUNT(alloc) - 3)
+
+/* Runtime settings, shared by all threads. */
+int arf_cache_enabled = 1;
+long arf_cache_max_limbs = ARF_MAX_CACHE_LIMBS;
+long arf_cache_max_blocks = ARF_CACHE_DEFAULT_BLOCKS;
+
+FLINT_TLS_PREFIX mp_ptr * arf_free_arr[ARF_CACHE_NUM_CLASSES] = { NULL };
+FLINT_TLS_PREFIX ulong arf_free_num[ARF_CACHE_NUM_CLASSES] = { 0 };
+FLINT_TLS_PREFIX ulong arf_free_alloc[ARF_CACHE_NUM_CLASSES] = { 0 };
 FLINT_TLS_PREFIX int arf_have_registered_cleanup = 0;
 
+FLINT_TLS_PREFIX ulong arf_cache_hits = 0;
+FLINT_TLS_PREFIX ulong arf_cache_misses = 0;
+
 void _arf_cleanup(void)
 {
-    long i;
-    for (i = 0; i < arf_free_num; i++)
-        flint_free(arf_free_arr[i]);
+    long c, i;
+
+    for (c = 0; c < ARF_CACHE_NUM_CLASSES; c++)
+    {
+        for (i = 0; i < arf_free_num[c]; i++)
+            flint_free(arf_free_arr[c][i]);
+
+        flint_free(arf_free_arr[c]);
+
+        arf_free_arr[c] = NULL;
+        arf_free_num[c] = 0;
+        arf_free_alloc[c] = 0;
+    }
+}
+
+void
+arf_cache_clear(void)
+{
+    _arf_cleanup();
+}
 
-    flint_free(arf_free_arr);
+void
+arf_cache_set_enabled(int flag)
+{
+    arf_cache_enabled = (flag != 0);
+}
+
+void
+arf_cache_set_limits(long max_limbs, long max_blocks)
+{
+    if (max_limbs <= ARF_NOPTR_LIMBS)
+        arf_cache_max_limbs = 0;
+    else
+        arf_cache_max_limbs = ARF_CACHE_CLASS_LIMBS(ARF_CACHE_CLASS_UP(
+            FLINT_MIN(max_limbs, ARF_MAX_CACHE_LIMBS)));
+
+    arf_cache_max_blocks = FLINT_MAX(0, max_blocks);
+}
+
+void
+arf_cache_get_stats(ulong * hits, ulong * misses)
+{
+    *hits = arf_cache_hits;
+    *misses = arf_cache_misses;
+}
 
-    arf_free_arr = NULL;
-    arf_free_num = 0;
-    arf_free_alloc = 0;
+void
+arf_cache_reset_stats(void)
+{
+    arf_cache_hits = 0;
+    arf_cache_misses = 0;
 }
 
 void
 _arf_promote(arf_t x, mp_size_t n)
 {
-    if (ARF_USE_CACHE && n <= ARF_MAX_CACHE_LIMBS && arf_free_num != 0)
+    mp_ptr ptr;
+    mp_size_t alloc;
+
+    if (_arf_arena_active)
     {
-        mp_ptr ptr;
-        mp_size_t alloc;
+        ARF_PTR_ALLOC(x) = -n;
+        ARF_PTR_D(x) = _arf_arena_alloc(n);
+        return;
+    }
 
-        ptr = arf_free_arr[--arf_free_num];
-        alloc = ptr[0];
+    if (ARF_USE_CACHE && arf_cache_enabled && n <= arf_cache_max_limbs)
+    {
+        long c = ARF_CACHE_CLASS_UP(n);
 
-        if (alloc >= n)
+        if (arf_free_num[c] != 0)
         {
-            ARF_PTR_ALLOC(x) = ptr[0];
-            ARF_PTR_D(x) = ptr;
+            ptr = arf_free_arr[c][--arf_free_num[c]];
+            alloc = ptr[0];
+            arf_cache_hits++;
         }
         else
         {
-            ptr = flint_realloc(ptr, n * sizeof(mp_limb_t));
-            ARF_PTR_ALLOC(x) = n;
-            ARF_PTR_D(x) = ptr;
+            alloc = ARF_CACHE_CLASS_LIMBS(c);
+            ptr = flint_malloc(alloc * sizeof(mp_limb_t));
+            arf_cache_misses++;
         }
     }
     else
     {
-        ARF_PTR_ALLOC(x) = n;
-        ARF_PTR_D(x) = flint_malloc(n * sizeof(mp_limb_t));
+        alloc = n;
+        ptr = flint_malloc(alloc * sizeof(mp_limb_t));
+        arf_cache_misses++;
     }
+
+    ARF_PTR_ALLOC(x) = alloc;
+    ARF_PTR_D(x) = ptr;
 }
 
 void
@@ -86,27 +167,56 @@ _arf_demote(arf_t x)
     alloc = ARF_PTR_ALLOC(x);
     ptr = ARF_PTR_D(x);
 
-    if (ARF_USE_CACHE && alloc <= ARF_MAX_CACHE_LIMBS)
+    if (alloc < 0)
+        return;
+
+    if (ARF_USE_CACHE && arf_cache_enabled && alloc >= ARF_CACHE_MIN_LIMBS
+        && alloc <= arf_cache_max_limbs)
     {
-        if (arf_free_num == arf_free_alloc)
+        long c = ARF_CACHE_CLASS_DOWN(alloc);
+
+        if (arf_free_num[c] < arf_cache_max_blocks)
         {
-            if (!arf_have_registered_cleanup)
+            if (arf_free_num[c] == arf_free_alloc[c])
             {
-                flint_register_cleanup_function(_arf_cleanup);
-                arf_have_registered_cleanup = 1;
+                if (!arf_have_registered_cleanup)
+                {
+                    flint_register_cleanup_function(_arf_cleanup);
+                    arf_have_registered_cleanup = 1;
+                }
+
+                arf_free_alloc[c] = FLINT_MAX(64, arf_free_alloc[c] * 2);
+                arf_free_arr[c] = flint_realloc(arf_free_arr[c],
+                    arf_free_alloc[c] * sizeof(mp_ptr));
             }
 
-            arf_free_alloc = FLINT_MAX(64, arf_free_alloc * 2);
-            arf_free_arr = flint_realloc(arf_free_arr,
-                arf_free_alloc * sizeof(mp_ptr));
+            ptr[0] = alloc;
+            arf_free_arr[c][arf_free_num[c]++] = ptr;
+            return;
         }
+    }
 
-        ptr[0] = alloc;
-        arf_free_arr[arf_free_num++] = ptr;
+    flint_free(ptr);
+}
+
+void
+_arf_grow(arf_t x, mp_size_t n)
+{
+    mp_ptr ptr;
+    mp_size_t alloc;
+
+    alloc = ARF_PTR_ALLOC(x);
+    ptr = ARF_PTR_D(x);
+
+    if (alloc > 0)
+    {
+        ARF_PTR_D(x) = flint_realloc(ptr, n * sizeof(mp_limb_t));
+        ARF_PTR_ALLOC(x) = n;
     }
     else
     {
-        flint_free(ptr);
+        _arf_promote(x, n);
+        flint_mpn_copyi(ARF_PTR_D(x), ptr, -alloc);
     }
 }
 
@@ -0,0 +1,126 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arb_poly.h"
+#include "acb.h"
+#include "profiler.h"
+
+/*
+    Compares running time and the number of limb arrays obtained from
+    malloc (allocs) versus recycled from the cache (reused), with the
+    limb cache switched off and on.
+*/
+
+static void
+print_stats(const char * name, long n, long prec, int cached, timeit_t t0)
+{
+    ulong hits, misses;
+
+    arf_cache_get_stats(&hits, &misses);
+
+    printf("%-10s n = %5ld  prec = %5ld  cache = %d  time = %6ld ms  "
+        "allocs = %10lu  reused = %10lu\n",
+        name, n, prec, cached, (long) t0->cpu, misses, hits);
+}
+
+static void
+bench_exp_series(long len, long prec, long reps, int cached)
+{
+    arb_ptr f, h;
+    flint_rand_t state;
+    timeit_t t0;
+    long i;
+
+    flint_randinit(state);
+
+    f = _arb_vec_init(len);
+    h = _arb_vec_init(len);
+
+    for (i = 1; i < len; i++)
+        arb_randtest_precise(h + i, state, prec, 2);
+
+    arf_cache_set_enabled(cached);
+    arf_cache_clear();
+    arf_cache_reset_stats();
+
+    timeit_start(t0);
+    for (i = 0; i < reps; i++)
+        _arb_poly_exp_series(f, h, len, len, prec);
+    timeit_stop(t0);
+
+    print_stats("exp_series", len, prec, cached, t0);
+
+    _arb_vec_clear(f, len);
+    _arb_vec_clear(h, len);
+    flint_randclear(state);
+}
+
+static void
+bench_gamma(long num, long prec, int cached)
+{
+    acb_t x, y;
+    timeit_t t0;
+    long i;
+
+    acb_init(x);
+    acb_init(y);
+
+    arf_cache_set_enabled(cached);
+    arf_cache_clear();
+    arf_cache_reset_stats();
+
+    timeit_start(t0);
+    for (i = 0; i < num; i++)
+    {
+        arb_set_ui(acb_realref(x), 3 + i);
+        arb_div_ui(acb_realref(x), acb_realref(x), 7, prec);
+        arb_set_ui(acb_imagref(x), 10 + i);
+        acb_gamma(y, x, prec);
+    }
+    timeit_stop(t0);
+
+    print_stats("gamma", num, prec, cached, t0);
+
+    acb_clear(x);
+    acb_clear(y);
+}
+
+int main()
+{
+    long prec;
+
+    for (prec = 256; prec <= 2048; prec *= 2)
+    {
+        bench_exp_series(500, prec, 10, 0);
+        bench_exp_series(500, prec, 10, 1);
+        bench_gamma(1000, prec, 0);
+        bench_gamma(1000, prec, 1);
+        printf("\n");
+    }
+
+    arf_cache_set_enabled(1);
+    flint_cleanup();
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arf.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("arena....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100000; iter++)
+    {
+        arf_t a, b, c, d, e;
+        long prec, depth, i;
+
+        prec = 2 + n_randint(state, 3000);
+
+        arf_init(a);
+        arf_init(b);
+        arf_init(d);
+        arf_init(e);
+
+        arf_randtest_special(a, state, 3000, 10);
+        arf_randtest_special(b, state, 3000, 10);
+
+        /* d is heap-allocated before entering the scopes */
+        arf_randtest_special(d, state, 3000, 10);
+
+        arf_mul(e, a, b, prec, ARF_RND_DOWN);
+        arf_add(e, e, a, prec, ARF_RND_DOWN);
+
+        depth = 1 + n_randint(state, 3);
+        for (i = 0; i < depth; i++)
+            arf_arena_push();
+
+        arf_init(c);
+        arf_mul(c, a, b, prec, ARF_RND_DOWN);
+        arf_add(c, c, a, prec, ARF_RND_DOWN);
+
+        if (n_randint(state, 2))
+        {
+            arf_t t;
+            arf_init(t);
+            arf_randtest_special(t, state, 3000, 10);
+            arf_mul(t, t, c, prec, ARF_RND_UP);
+            arf_clear(t);
+        }
+
+        if (!arf_equal(c, e))
+        {
+            printf("FAIL (inside scope)\n");
+            printf("a = "); arf_print(a); printf("\n\n");
+            printf("b = "); arf_print(b); printf("\n\n");
+            printf("c = "); arf_print(c); printf("\n\n");
+            printf("e = "); arf_print(e); printf("\n\n");
+            abort();
+        }
+
+        /* copy the result out of the arena */
+        arf_arena_suspend();
+        arf_set(d, c);
+        arf_arena_resume();
+
+        arf_clear(c);
+
+        for (i = 0; i < depth; i++)
+            arf_arena_pop();
+
+        /* overwrite the memory that was used by the scope */
+        arf_arena_push();
+        arf_init(c);
+        arf_randtest_special(c, state, 3000, 10);
+        arf_clear(c);
+        arf_arena_pop();
+
+        if (!arf_equal(d, e))
+        {
+            printf("FAIL (after scope)\n");
+            printf("a = "); arf_print(a); printf("\n\n");
+            printf("b = "); arf_print(b); printf("\n\n");
+            printf("d = "); arf_print(d); printf("\n\n");
+            printf("e = "); arf_print(e); printf("\n\n");
+            abort();
+        }
+
+        arf_clear(a);
+        arf_clear(b);
+        arf_clear(d);
+        arf_clear(e);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
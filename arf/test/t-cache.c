@@ -0,0 +1,150 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "arf.h"
+
+int main()
+{
+    long iter;
+    ulong hits, misses;
+    flint_rand_t state;
+
+    printf("cache....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* repeatedly allocating and freeing the same size must hit the cache */
+    {
+        arf_t x, y;
+
+        arf_cache_set_enabled(1);
+        arf_cache_set_limits(ARF_MAX_CACHE_LIMBS, ARF_CACHE_DEFAULT_BLOCKS);
+        arf_cache_clear();
+        arf_cache_reset_stats();
+
+        for (iter = 0; iter < 10; iter++)
+        {
+            arf_init(x);
+            arf_init(y);
+            arf_one(y);
+            arf_mul_2exp_si(x, y, 1000);
+            arf_add(x, x, y, ARF_PREC_EXACT, ARF_RND_DOWN);
+            arf_clear(x);
+            arf_clear(y);
+        }
+
+        arf_cache_get_stats(&hits, &misses);
+
+        if (hits == 0 || misses > hits)
+        {
+            printf("FAIL (cache enabled)\n");
+            printf("hits = %lu, misses = %lu\n", hits, misses);
+            abort();
+        }
+
+        arf_cache_set_enabled(0);
+        arf_cache_reset_stats();
+
+        for (iter = 0; iter < 10; iter++)
+        {
+            arf_init(x);
+            arf_init(y);
+            arf_one(y);
+            arf_mul_2exp_si(x, y, 1000);
+            arf_add(x, x, y, ARF_PREC_EXACT, ARF_RND_DOWN);
+            arf_clear(x);
+            arf_clear(y);
+        }
+
+        arf_cache_get_stats(&hits, &misses);
+
+        if (hits != 0 || misses == 0)
+        {
+            printf("FAIL (cache disabled)\n");
+            printf("hits = %lu, misses = %lu\n", hits, misses);
+            abort();
+        }
+    }
+
+    /* results must not depend on the cache settings */
+    for (iter = 0; iter < 100000; iter++)
+    {
+        arf_t a, b, c, d;
+        long prec;
+
+        if (n_randint(state, 100) == 0)
+            arf_cache_set_enabled(n_randint(state, 4) != 0);
+
+        if (n_randint(state, 100) == 0)
+            arf_cache_set_limits(n_randint(state, 2 * ARF_MAX_CACHE_LIMBS),
+                n_randint(state, 2 * ARF_CACHE_DEFAULT_BLOCKS));
+
+        if (n_randint(state, 1000) == 0)
+            arf_cache_clear();
+
+        arf_init(a);
+        arf_init(b);
+        arf_init(c);
+        arf_init(d);
+
+        prec = 2 + n_randint(state, 3000);
+
+        arf_randtest_special(a, state, 3000, 10);
+        arf_randtest_special(b, state, 3000, 10);
+
+        arf_cache_set_enabled(1);
+        arf_mul(c, a, b, prec, ARF_RND_DOWN);
+        arf_add(c, c, a, prec, ARF_RND_DOWN);
+        arf_cache_set_enabled(0);
+        arf_mul(d, a, b, prec, ARF_RND_DOWN);
+        arf_add(d, d, a, prec, ARF_RND_DOWN);
+
+        if (!arf_equal(c, d))
+        {
+            printf("FAIL (results)\n");
+            printf("a = "); arf_print(a); printf("\n\n");
+            printf("b = "); arf_print(b); printf("\n\n");
+            printf("c = "); arf_print(c); printf("\n\n");
+            printf("d = "); arf_print(d); printf("\n\n");
+            abort();
+        }
+
+        arf_cache_set_enabled(n_randint(state, 2));
+
+        arf_clear(a);
+        arf_clear(b);
+        arf_clear(c);
+        arf_clear(d);
+    }
+
+    arf_cache_set_enabled(1);
+    arf_cache_set_limits(ARF_MAX_CACHE_LIMBS, ARF_CACHE_DEFAULT_BLOCKS);
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
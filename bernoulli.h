@@ -39,12 +39,16 @@
 extern "C" {
 #endif
 
-extern long TLS_PREFIX bernoulli_cache_num;
+extern volatile long bernoulli_cache_num;
 
-extern TLS_PREFIX fmpq * bernoulli_cache;
+extern fmpq * volatile bernoulli_cache;
+
+#define BERNOULLI_CACHE_PARALLEL_MIN 256
 
 void bernoulli_cache_compute(long n);
 
+int bernoulli_cache_contains(ulong n);
+
 /*
 Crude bound for the bits in d(n) = denom(B_n).
 By von Staudt-Clausen, d(n) = prod_{p-1 | n} p
@@ -112,8 +116,7 @@ void bernoulli_rev_clear(bernoulli_rev_t iter);
 #define BERNOULLI_ENSURE_CACHED(n) \
   do { \
     long __n = (n); \
-    if (__n >= bernoulli_cache_num) \
-        bernoulli_cache_compute(__n + 1); \
+    bernoulli_cache_compute(__n + 1); \
   } while (0); \
 
 long bernoulli_bound_2exp_si(ulong n);
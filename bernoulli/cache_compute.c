@@ -19,62 +19,258 @@
 =============================================================================*/
 /******************************************************************************
 
-    Copyright (C) 2012 Fredrik Johansson
+    Copyright (C) 2012, 2015 Fredrik Johansson
 
 ******************************************************************************/
 
+#include <string.h>
+#include <pthread.h>
 #include "bernoulli.h"
+#include "arb_thread_pool.h"
 
-TLS_PREFIX long bernoulli_cache_num = 0;
+/*
+    The cache is shared by all threads. Entries 0 <= i < bernoulli_cache_num
+    of the array bernoulli_cache are never modified once published, so a
+    thread which has seen a large enough bernoulli_cache_num can read them
+    without locking. The array has room for bernoulli_cache_alloc entries;
+    when it has to grow, the entries are copied shallowly to a new array
+    and the old array is kept (but not its entries, which now belong to the
+    new array) until the cache is freed, since another thread may still be
+    reading from it. As the capacity doubles, the retired arrays take
+    up less space than the current one.
 
-TLS_PREFIX fmpq * bernoulli_cache = NULL;
+    New entries are filled by the writer holding the lock, splitting the
+    range into blocks which are computed in parallel, each with its own
+    reverse iterator. The cache is freed when the last thread which has
+    used it calls flint_cleanup().
+*/
 
-void
+#if defined(__GNUC__)
+#define CACHE_BARRIER() __sync_synchronize()
+#define CACHE_LOCK_FREE 1
+#else
+#define CACHE_BARRIER()
+#define CACHE_LOCK_FREE 0
+#endif
+
+volatile long bernoulli_cache_num = 0;
+
+fmpq * volatile bernoulli_cache = NULL;
+
+static long bernoulli_cache_alloc = 0;
+static fmpq ** bernoulli_retired = NULL;
+static long bernoulli_num_retired = 0;
+static long bernoulli_users = 0;
+static pthread_mutex_t bernoulli_lock = PTHREAD_MUTEX_INITIALIZER;
+static TLS_PREFIX int bernoulli_have_registered_cleanup = 0;
+
+static void
 bernoulli_cleanup(void)
 {
     long i;
 
-    for (i = 0; i < bernoulli_cache_num; i++)
-        fmpq_clear(bernoulli_cache + i);
+    pthread_mutex_lock(&bernoulli_lock);
+
+    bernoulli_have_registered_cleanup = 0;
+    bernoulli_users--;
+
+    if (bernoulli_users == 0)
+    {
+        for (i = 0; i < bernoulli_cache_alloc; i++)
+            fmpq_clear(bernoulli_cache + i);
+
+        flint_free(bernoulli_cache);
+
+        for (i = 0; i < bernoulli_num_retired; i++)
+            flint_free(bernoulli_retired[i]);
+
+        flint_free(bernoulli_retired);
+
+        bernoulli_cache = NULL;
+        bernoulli_cache_num = 0;
+        bernoulli_cache_alloc = 0;
+        bernoulli_retired = NULL;
+        bernoulli_num_retired = 0;
+    }
+
+    pthread_mutex_unlock(&bernoulli_lock);
+}
+
+typedef struct
+{
+    fmpq * cache;
+    const long * bounds;
+}
+bernoulli_fill_args_t;
+
+/* Computes the entries bounds[j] <= i < bounds[j + 1]. */
+static void
+_bernoulli_cache_fill_block(void * args, long j)
+{
+    bernoulli_fill_args_t * a = args;
+    bernoulli_rev_t iter;
+    long i, lo;
 
-    flint_free(bernoulli_cache);
-    bernoulli_cache = NULL;
-    bernoulli_cache_num = 0;
+    lo = a->bounds[j];
+    i = a->bounds[j + 1] - 1;
+    i -= (i % 2);
+
+    if (i < lo)
+        return;
+
+    bernoulli_rev_init(iter, i);
+    for ( ; i >= lo; i -= 2)
+    {
+        bernoulli_rev_next(fmpq_numref(a->cache + i),
+            fmpq_denref(a->cache + i), iter);
+    }
+    bernoulli_rev_clear(iter);
+}
+
+/* Computes the entries lo <= i < hi of the (unpublished) array. */
+static void
+_bernoulli_cache_fill(fmpq * cache, long lo, long hi)
+{
+    bernoulli_fill_args_t args;
+    long * bounds;
+    long j, num_blocks, num_threads;
+    double a, b;
+
+    num_threads = flint_get_num_threads();
+
+    if (num_threads <= 1 || hi - lo < BERNOULLI_CACHE_PARALLEL_MIN)
+        num_blocks = 1;
+    else
+        num_blocks = FLINT_MIN(4 * num_threads,
+            (hi - lo) / (BERNOULLI_CACHE_PARALLEL_MIN / 4));
+
+    bounds = flint_malloc(sizeof(long) * (num_blocks + 1));
+
+    /* The cost of computing B_i grows roughly like i^2, so the blocks
+       are chosen to contain equal parts of the integral of i^2. */
+    a = (double) lo * lo * lo;
+    b = (double) hi * hi * hi;
+
+    bounds[0] = lo;
+    for (j = 1; j < num_blocks; j++)
+    {
+        bounds[j] = pow(a + (b - a) * j / num_blocks, 1.0 / 3.0);
+        bounds[j] += (bounds[j] % 2);
+        bounds[j] = FLINT_MAX(bounds[j], bounds[j - 1]);
+        bounds[j] = FLINT_MIN(bounds[j], hi);
+    }
+    bounds[num_blocks] = hi;
+
+    args.cache = cache;
+    args.bounds = bounds;
+
+    if (num_blocks == 1)
+        _bernoulli_cache_fill_block(&args, 0);
+    else
+        arb_thread_pool_parallel_do(_bernoulli_cache_fill_block, &args,
+            num_blocks, num_threads);
+
+    flint_free(bounds);
+}
+
+static void
+_bernoulli_cache_register_thread(void)
+{
+    pthread_mutex_lock(&bernoulli_lock);
+    bernoulli_users++;
+    pthread_mutex_unlock(&bernoulli_lock);
+
+    flint_register_cleanup_function(bernoulli_cleanup);
+    bernoulli_have_registered_cleanup = 1;
+}
+
+int
+bernoulli_cache_contains(ulong n)
+{
+    long num;
+
+    if (!bernoulli_have_registered_cleanup)
+        _bernoulli_cache_register_thread();
+
+    num = bernoulli_cache_num;
+    CACHE_BARRIER();
+
+    return n < (ulong) num;
 }
 
 void
 bernoulli_cache_compute(long n)
 {
-    if (bernoulli_cache_num < n)
+    long i, num, new_num, new_alloc, disk_num;
+    fmpq * cache;
+
+    if (!bernoulli_have_registered_cleanup)
+        _bernoulli_cache_register_thread();
+
+#if CACHE_LOCK_FREE
+    num = bernoulli_cache_num;
+    CACHE_BARRIER();
+
+    if (num >= n)
+        return;
+#endif
+
+    pthread_mutex_lock(&bernoulli_lock);
+
+    num = bernoulli_cache_num;
+
+    if (num < n)
     {
-        long i, new_num;
-        bernoulli_rev_t iter;
+        new_num = FLINT_MAX(num + 128, n);
 
-        if (bernoulli_cache_num == 0)
+        if (new_num > bernoulli_cache_alloc)
         {
-            flint_register_cleanup_function(bernoulli_cleanup);
+            new_alloc = FLINT_MAX(new_num, 2 * bernoulli_cache_alloc);
+
+            cache = flint_malloc(new_alloc * sizeof(fmpq));
+
+            if (bernoulli_cache_alloc != 0)
+            {
+                memcpy(cache, bernoulli_cache,
+                    bernoulli_cache_alloc * sizeof(fmpq));
+
+                bernoulli_retired = flint_realloc(bernoulli_retired,
+                    (bernoulli_num_retired + 1) * sizeof(fmpq *));
+                bernoulli_retired[bernoulli_num_retired++] = bernoulli_cache;
+            }
+
+            for (i = bernoulli_cache_alloc; i < new_alloc; i++)
+                fmpq_init(cache + i);
+
+            CACHE_BARRIER();
+            bernoulli_cache = cache;
+            bernoulli_cache_alloc = new_alloc;
         }
 
-        new_num = FLINT_MAX(bernoulli_cache_num + 128, n);
+        cache = bernoulli_cache;
 
-        bernoulli_cache = flint_realloc(bernoulli_cache, new_num * sizeof(fmpq));
-        for (i = bernoulli_cache_num; i < new_num; i++)
-            fmpq_init(bernoulli_cache + i);
+        /* numbers which have been written to the cache file */
+        if (new_num >= ARB_DISK_CACHE_MIN_BERNOULLI)
+            disk_num = _arb_disk_cache_load_fmpq_vec(cache + num,
+                "bernoulli", num, new_num);
+        else
+            disk_num = num;
 
-        i = new_num - 1;
-        i -= (i % 2);
-        bernoulli_rev_init(iter, i);
-        for ( ; i >= bernoulli_cache_num; i -= 2)
+        if (disk_num < new_num)
         {
-            bernoulli_rev_next(fmpq_numref(bernoulli_cache + i),
-                fmpq_denref(bernoulli_cache + i), iter);
-        }
-        bernoulli_rev_clear(iter);
+            _bernoulli_cache_fill(cache, disk_num, new_num);
 
-        if (new_num > 1)
-            fmpq_set_si(bernoulli_cache + 1, -1, 2);
+            if (disk_num <= 1 && new_num > 1)
+                fmpq_set_si(cache + 1, -1, 2);
 
+            if (new_num >= ARB_DISK_CACHE_MIN_BERNOULLI)
+                _arb_disk_cache_store_fmpq_vec("bernoulli",
+                    cache + disk_num, disk_num, new_num);
+        }
+
+        CACHE_BARRIER();
         bernoulli_cache_num = new_num;
     }
-}
 
+    pthread_mutex_unlock(&bernoulli_lock);
+}
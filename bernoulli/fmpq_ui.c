@@ -28,7 +28,7 @@
 void
 _bernoulli_fmpq_ui(fmpz_t num, fmpz_t den, ulong n)
 {
-    if (n < (ulong) bernoulli_cache_num)
+    if (bernoulli_cache_contains(n))
     {
         fmpz_set(num, fmpq_numref(bernoulli_cache + n));
         fmpz_set(den, fmpq_denref(bernoulli_cache + n));
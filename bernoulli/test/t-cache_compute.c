@@ -0,0 +1,142 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bernoulli.h"
+#include "arb_thread_pool.h"
+
+typedef struct
+{
+    ulong seed;
+    long nmax;
+    int fail;
+}
+task_args_t;
+
+static void
+task(void * args, long i)
+{
+    task_args_t * t = args;
+    flint_rand_t state;
+    fmpq_t b;
+    long n, k;
+
+    flint_randinit(state);
+    state->__randval = t->seed + i;
+    state->__randval2 = t->seed + 3 * i;
+
+    fmpq_init(b);
+
+    n = 1 + n_randint(state, t->nmax);
+    bernoulli_cache_compute(n);
+
+    for (k = 0; k < 10; k++)
+    {
+        long j = n_randint(state, n);
+
+        arith_bernoulli_number(b, j);
+
+        if (!bernoulli_cache_contains(j) || !fmpq_equal(b, bernoulli_cache + j))
+            t->fail = 1;
+    }
+
+    fmpq_clear(b);
+    flint_randclear(state);
+}
+
+int main()
+{
+    flint_rand_t state;
+    long iter;
+
+    printf("cache_compute....");
+    fflush(stdout);
+    flint_randinit(state);
+
+    for (iter = 0; iter < 200; iter++)
+    {
+        fmpq_t b;
+        long n, j, k;
+
+        fmpq_init(b);
+
+        n = 1 + n_randint(state, 1000);
+        bernoulli_cache_compute(n);
+
+        if (!bernoulli_cache_contains(n - 1))
+        {
+            printf("FAIL: contains (n = %ld)\n", n);
+            abort();
+        }
+
+        for (k = 0; k < 10; k++)
+        {
+            j = n_randint(state, n);
+            arith_bernoulli_number(b, j);
+
+            if (!fmpq_equal(b, bernoulli_cache + j))
+            {
+                printf("FAIL: n = %ld, j = %ld\n", n, j);
+                abort();
+            }
+        }
+
+        fmpq_clear(b);
+
+        if (iter % 20 == 19)
+            flint_cleanup();
+    }
+
+    /* concurrent readers and parallel filling */
+    for (iter = 0; iter < 10; iter++)
+    {
+        task_args_t args;
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        args.seed = n_randlimb(state);
+        args.nmax = 100 + n_randint(state, 3000);
+        args.fail = 0;
+
+        arb_thread_pool_parallel_do(task, &args, 16, flint_get_num_threads());
+
+        if (args.fail)
+        {
+            printf("FAIL: threaded (iter = %ld)\n", iter);
+            abort();
+        }
+
+        if (iter % 3 == 2)
+            flint_cleanup();
+    }
+
+    flint_set_num_threads(1);
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -24,6 +24,10 @@
 ******************************************************************************/
 
 #include "hypgeom.h"
+#include "arb_thread_pool.h"
+
+/* minimum number of terms per leaf when splitting over threads */
+#define HYPGEOM_BSPLIT_PARALLEL_CUTOFF 256
 
 static __inline__ void
 fmpz_poly_evaluate_si(fmpz_t y, const fmpz_poly_t poly, long x)
@@ -226,6 +230,47 @@ fmprb_hypgeom_infsum(fmprb_t P, fmprb_t Q, hypgeom_t hyp, long target_prec, long
     mag_clear(err);
 }
 
+typedef struct
+{
+    arb_t P;
+    arb_t Q;
+    arb_t B;
+    arb_t T;
+}
+bsplit_arb_struct;
+
+typedef struct
+{
+    const hypgeom_struct * hyp;
+    long prec;
+}
+bsplit_arb_args_t;
+
+/* merges [a,m) in (P, Q, B, T) and [m,b) in (P2, Q2, B2, T2),
+   destroying the latter */
+static void
+bsplit_merge_arb(arb_t P, arb_t Q, arb_t B, arb_t T,
+    arb_t P2, arb_t Q2, arb_t B2, arb_t T2, int cont, long prec)
+{
+    if (arb_is_one(B) && arb_is_one(B2))
+    {
+        arb_mul(T, T, Q2, prec);
+        arb_addmul(T, P, T2, prec);
+    }
+    else
+    {
+        arb_mul(T, T, B2, prec);
+        arb_mul(T, T, Q2, prec);
+        arb_mul(T2, T2, B, prec);
+        arb_addmul(T, P, T2, prec);
+    }
+
+    arb_mul(B, B, B2, prec);
+    arb_mul(Q, Q, Q2, prec);
+    if (cont)
+        arb_mul(P, P, P2, prec);
+}
+
 static void
 bsplit_recursive_arb(arb_t P, arb_t Q, arb_t B, arb_t T,
     const hypgeom_t hyp, long a, long b, int cont, long prec)
@@ -265,24 +310,7 @@ bsplit_recursive_arb(arb_t P, arb_t Q, arb_t B, arb_t T,
 
         bsplit_recursive_arb(P, Q, B, T, hyp, a, m, 1, prec);
         bsplit_recursive_arb(P2, Q2, B2, T2, hyp, m, b, 1, prec);
-
-        if (arb_is_one(B) && arb_is_one(B2))
-        {
-            arb_mul(T, T, Q2, prec);
-            arb_addmul(T, P, T2, prec);
-        }
-        else
-        {
-            arb_mul(T, T, B2, prec);
-            arb_mul(T, T, Q2, prec);
-            arb_mul(T2, T2, B, prec);
-            arb_addmul(T, P, T2, prec);
-        }
-
-        arb_mul(B, B, B2, prec);
-        arb_mul(Q, Q, Q2, prec);
-        if (cont)
-            arb_mul(P, P, P2, prec);
+        bsplit_merge_arb(P, Q, B, T, P2, Q2, B2, T2, cont, prec);
 
         arb_clear(P2);
         arb_clear(Q2);
@@ -291,6 +319,50 @@ bsplit_recursive_arb(arb_t P, arb_t Q, arb_t B, arb_t T,
     }
 }
 
+static void
+bsplit_arb_init(void * x)
+{
+    bsplit_arb_struct * s = x;
+
+    arb_init(s->P);
+    arb_init(s->Q);
+    arb_init(s->B);
+    arb_init(s->T);
+}
+
+static void
+bsplit_arb_clear(void * x)
+{
+    bsplit_arb_struct * s = x;
+
+    arb_clear(s->P);
+    arb_clear(s->Q);
+    arb_clear(s->B);
+    arb_clear(s->T);
+}
+
+static void
+bsplit_arb_basecase(void * x, long a, long b, int cont, void * args)
+{
+    bsplit_arb_struct * s = x;
+    bsplit_arb_args_t * arg = args;
+
+    bsplit_recursive_arb(s->P, s->Q, s->B, s->T, arg->hyp, a, b, cont,
+        arg->prec);
+}
+
+static void
+bsplit_arb_merge(void * left, void * right, long a, long m, long b,
+    int cont, void * args)
+{
+    bsplit_arb_struct * L = left;
+    bsplit_arb_struct * R = right;
+    bsplit_arb_args_t * arg = args;
+
+    bsplit_merge_arb(L->P, L->Q, L->B, L->T, R->P, R->Q, R->B, R->T,
+        cont, arg->prec);
+}
+
 void
 arb_hypgeom_sum(arb_t P, arb_t Q, const hypgeom_t hyp, long n, long prec)
 {
@@ -301,15 +373,24 @@ arb_hypgeom_sum(arb_t P, arb_t Q, const hypgeom_t hyp, long n, long prec)
     }
     else
     {
-        arb_t B, T;
-        arb_init(B);
-        arb_init(T);
-        bsplit_recursive_arb(P, Q, B, T, hyp, 0, n, 0, prec);
-        if (!arb_is_one(B))
-            arb_mul(Q, Q, B, prec);
-        arb_swap(P, T);
-        arb_clear(B);
-        arb_clear(T);
+        bsplit_arb_struct s;
+        bsplit_arb_args_t args;
+
+        args.hyp = hyp;
+        args.prec = prec;
+
+        bsplit_arb_init(&s);
+
+        arb_thread_pool_bsplit(&s, 0, n, &args, sizeof(bsplit_arb_struct),
+            bsplit_arb_init, bsplit_arb_clear,
+            bsplit_arb_basecase, bsplit_arb_merge,
+            HYPGEOM_BSPLIT_PARALLEL_CUTOFF, flint_get_num_threads());
+
+        if (!arb_is_one(s.B))
+            arb_mul(s.Q, s.Q, s.B, prec);
+        arb_swap(P, s.T);
+        arb_swap(Q, s.Q);
+        bsplit_arb_clear(&s);
     }
 }
 
@@ -473,6 +473,56 @@ mag_fast_add_2exp_si(mag_t z, const mag_t x, long e)
     }
 }
 
+/* Branch-free versions of the fast functions, acting on separate
+   mantissas and exponents (zero is encoded as man = exp = 0). These
+   are intended for loops that the compiler can vectorize. */
+
+MAG_INLINE void
+_mag_fast_add_raw(mp_limb_t * zm, long * ze,
+    mp_limb_t xm, long xe, mp_limb_t ym, long ye)
+{
+    mp_limb_t m, c;
+    long e, sx, sy;
+
+    /* a zero operand never determines the exponent */
+    xe = (xm != 0) ? xe : 2 * MAG_MIN_LAGOM_EXP;
+    ye = (ym != 0) ? ye : 2 * MAG_MIN_LAGOM_EXP;
+
+    e = FLINT_MAX(xe, ye);
+    sx = FLINT_MIN(e - xe, FLINT_BITS - 1);
+    sy = FLINT_MIN(e - ye, FLINT_BITS - 1);
+
+    m = (xm >> sx) + (ym >> sy) + ((xm != 0) & (ym != 0));
+
+    /* may need two adjustments */
+    c = m >> MAG_BITS;
+    m = (m >> c) + c;
+    e += c;
+    c = m >> MAG_BITS;
+    m = (m >> c) + c;
+    e += c;
+
+    *zm = m;
+    *ze = (m != 0) ? e : 0;
+}
+
+MAG_INLINE void
+_mag_fast_mul_raw(mp_limb_t * zm, long * ze,
+    mp_limb_t xm, long xe, mp_limb_t ym, long ye)
+{
+    mp_limb_t m, c;
+    int nonzero;
+
+    nonzero = (xm != 0) & (ym != 0);
+
+    m = MAG_FIXMUL(xm, ym) + LIMB_ONE;
+    c = (m >> (MAG_BITS - 1)) ^ LIMB_ONE;
+    m <<= c;
+
+    *zm = nonzero ? m : 0;
+    *ze = nonzero ? xe + ye - (long) c : 0;
+}
+
 void mag_set_d_2exp_fmpz(mag_t z, double c, const fmpz_t exp);
 void mag_set_fmpz_2exp_fmpz(mag_t z, const fmpz_t man, const fmpz_t exp);
 
@@ -535,6 +585,14 @@ _mag_vec_clear(mag_ptr v, long n)
     flint_free(v);
 }
 
+void _mag_vec_add(mag_ptr z, mag_srcptr x, mag_srcptr y, long len);
+
+void _mag_vec_mul(mag_ptr z, mag_srcptr x, mag_srcptr y, long len);
+
+void _mag_vec_addmul_scalar(mag_ptr z, mag_srcptr x, const mag_t c, long len);
+
+void _mag_vec_max(mag_t res, mag_srcptr x, long len);
+
 MAG_INLINE void mag_set_d(mag_t z, double x)
 {
     fmpz_t e;
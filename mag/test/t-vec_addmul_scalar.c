@@ -0,0 +1,137 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "mag.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("vec_addmul_scalar....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000; iter++)
+    {
+        fmpr_t x, y, c, z, z2, w;
+        mag_ptr xv, yv, zv;
+        mag_t cb;
+        long i, len, expbits;
+        int alias;
+
+        len = n_randint(state, 20);
+        expbits = n_randint(state, 3) == 0 ? 100 : 20;
+        alias = n_randint(state, 2);
+
+        xv = _mag_vec_init(len);
+        yv = _mag_vec_init(len);
+        zv = _mag_vec_init(len);
+        mag_init(cb);
+
+        fmpr_init(x);
+        fmpr_init(y);
+        fmpr_init(c);
+        fmpr_init(z);
+        fmpr_init(z2);
+        fmpr_init(w);
+
+        for (i = 0; i < len; i++)
+        {
+            if (n_randint(state, 50) == 0)
+                mag_randtest_special(xv + i, state, expbits);
+            else
+                mag_randtest(xv + i, state, expbits);
+
+            if (alias)
+                mag_set(yv + i, xv + i);
+            else
+                mag_randtest(yv + i, state, expbits);
+
+            mag_set(zv + i, yv + i);
+        }
+
+        if (n_randint(state, 10) == 0)
+            mag_randtest_special(cb, state, expbits);
+        else
+            mag_randtest(cb, state, expbits);
+
+        if (alias)
+            _mag_vec_addmul_scalar(zv, zv, cb, len);
+        else
+            _mag_vec_addmul_scalar(zv, xv, cb, len);
+
+        mag_get_fmpr(c, cb);
+
+        for (i = 0; i < len; i++)
+        {
+            mag_get_fmpr(x, xv + i);
+            mag_get_fmpr(y, yv + i);
+
+            fmpr_mul(z, x, c, FMPR_PREC_EXACT, FMPR_RND_DOWN);
+            fmpr_add(z, z, y, MAG_BITS + 10, FMPR_RND_DOWN);
+            if (fmpr_is_nan(z))
+                fmpr_pos_inf(z);
+
+            fmpr_mul_ui(z2, z, 1025, MAG_BITS, FMPR_RND_UP);
+            fmpr_mul_2exp_si(z2, z2, -10);
+
+            mag_get_fmpr(w, zv + i);
+
+            MAG_CHECK_BITS(zv + i)
+
+            if (!(fmpr_cmpabs(z, w) <= 0 && fmpr_cmpabs(w, z2) <= 0))
+            {
+                printf("FAIL\n\n");
+                printf("i = %ld, alias = %d\n\n", i, alias);
+                printf("x = "); fmpr_print(x); printf("\n\n");
+                printf("y = "); fmpr_print(y); printf("\n\n");
+                printf("c = "); fmpr_print(c); printf("\n\n");
+                printf("z = "); fmpr_print(z); printf("\n\n");
+                printf("w = "); fmpr_print(w); printf("\n\n");
+                abort();
+            }
+        }
+
+        fmpr_clear(x);
+        fmpr_clear(y);
+        fmpr_clear(c);
+        fmpr_clear(z);
+        fmpr_clear(z2);
+        fmpr_clear(w);
+
+        _mag_vec_clear(xv, len);
+        _mag_vec_clear(yv, len);
+        _mag_vec_clear(zv, len);
+        mag_clear(cb);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,88 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "mag.h"
+
+int main()
+{
+    long iter;
+    flint_rand_t state;
+
+    printf("vec_max....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000; iter++)
+    {
+        mag_ptr xv;
+        mag_t m, r;
+        long i, len, expbits;
+
+        len = n_randint(state, 20);
+        expbits = n_randint(state, 3) == 0 ? 100 : 20;
+
+        xv = _mag_vec_init(len);
+        mag_init(m);
+        mag_init(r);
+
+        for (i = 0; i < len; i++)
+        {
+            if (n_randint(state, 50) == 0)
+                mag_randtest_special(xv + i, state, expbits);
+            else if (i > 0 && n_randint(state, 4) == 0)
+                mag_set(xv + i, xv + n_randint(state, i));
+            else
+                mag_randtest(xv + i, state, expbits);
+        }
+
+        mag_randtest_special(r, state, expbits);
+        _mag_vec_max(r, xv, len);
+
+        for (i = 0; i < len; i++)
+            mag_max(m, m, xv + i);
+
+        MAG_CHECK_BITS(r)
+
+        if (!mag_equal(r, m))
+        {
+            printf("FAIL\n\n");
+            printf("len = %ld\n\n", len);
+            printf("r = "); mag_printd(r, 10); printf("\n\n");
+            printf("m = "); mag_printd(m, 10); printf("\n\n");
+            abort();
+        }
+
+        _mag_vec_clear(xv, len);
+        mag_clear(m);
+        mag_clear(r);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    printf("PASS\n");
+    return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,52 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "mag.h"
+
+void
+_mag_vec_add(mag_ptr z, mag_srcptr x, mag_srcptr y, long len)
+{
+    long i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (!MAG_IS_LAGOM(x + i) || !MAG_IS_LAGOM(y + i) ||
+            COEFF_IS_MPZ(MAG_EXP(z + i)))
+            break;
+    }
+
+    if (i == len)
+    {
+        for (i = 0; i < len; i++)
+            _mag_fast_add_raw(&MAG_MAN(z + i), &MAG_EXP(z + i),
+                MAG_MAN(x + i), MAG_EXP(x + i), MAG_MAN(y + i), MAG_EXP(y + i));
+    }
+    else
+    {
+        for (i = 0; i < len; i++)
+            mag_add(z + i, x + i, y + i);
+    }
+}
+
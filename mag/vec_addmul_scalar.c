@@ -0,0 +1,56 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "mag.h"
+
+void
+_mag_vec_addmul_scalar(mag_ptr z, mag_srcptr x, const mag_t c, long len)
+{
+    mp_limb_t m;
+    long i, e;
+
+    for (i = 0; i < len; i++)
+    {
+        if (!MAG_IS_LAGOM(x + i) || !MAG_IS_LAGOM(z + i))
+            break;
+    }
+
+    if (i == len && MAG_IS_LAGOM(c))
+    {
+        for (i = 0; i < len; i++)
+        {
+            _mag_fast_mul_raw(&m, &e, MAG_MAN(x + i), MAG_EXP(x + i),
+                MAG_MAN(c), MAG_EXP(c));
+            _mag_fast_add_raw(&MAG_MAN(z + i), &MAG_EXP(z + i),
+                MAG_MAN(z + i), MAG_EXP(z + i), m, e);
+        }
+    }
+    else
+    {
+        for (i = 0; i < len; i++)
+            mag_addmul(z + i, x + i, c);
+    }
+}
+
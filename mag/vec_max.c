@@ -0,0 +1,68 @@
+/*=============================================================================
+
+    This file is part of ARB.
+
+    ARB is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    ARB is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ARB; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2015 Fredrik Johansson
+
+******************************************************************************/
+
+#include "mag.h"
+
+void
+_mag_vec_max(mag_t res, mag_srcptr x, long len)
+{
+    mp_limb_t m;
+    long i, e;
+
+    for (i = 0; i < len; i++)
+    {
+        if (!MAG_IS_LAGOM(x + i))
+            break;
+    }
+
+    if (i == len)
+    {
+        /* maximum exponent, then maximum mantissa with that exponent */
+        e = 2 * MAG_MIN_LAGOM_EXP;
+        for (i = 0; i < len; i++)
+            e = (MAG_MAN(x + i) != 0 && MAG_EXP(x + i) > e) ? MAG_EXP(x + i) : e;
+
+        m = 0;
+        for (i = 0; i < len; i++)
+            m = (MAG_EXP(x + i) == e && MAG_MAN(x + i) > m) ? MAG_MAN(x + i) : m;
+
+        if (m == 0)
+        {
+            mag_zero(res);
+        }
+        else
+        {
+            fmpz_set_si(MAG_EXPREF(res), e);
+            MAG_MAN(res) = m;
+        }
+    }
+    else
+    {
+        mag_zero(res);
+        for (i = 0; i < len; i++)
+            mag_max(res, res, x + i);
+    }
+}
+